@@ -0,0 +1,174 @@
+/*****************************************
+ * chunk_transfer.cpp
+ *
+ * Example of moving chunks between
+ *   tasks: whole chunks, with their tags,
+ *   with send_chunk/recv_chunk, and
+ *   strided sub-blocks of chunks, between
+ *   tasks and to and from a file, with
+ *   beo::Sub_Block. Build and run with
+ *   mkme_examples.sh
+*****************************************/
+#include "example.hpp"
+
+#include <stdio.h>
+#include <vector>
+
+//the value of element (i, j, k) of a chunk made by task
+static double element(const int task, const size_t i, const size_t j, const size_t k)
+{
+    return 1000.0 * task + 100.0 * i + 10.0 * j + k;
+}
+
+//a task's n x 2 x 3 chunk, at offset (task, 2, 3)
+static beo::Chunk make_chunk(const int task, const size_t n)
+{
+    beo::Chunk chunk(beo::Chunk_Tag({size_t(task), 2, 3}, {n, 2, 3}));
+
+    chunk.allocate(n * 6 * sizeof(double));
+
+    double* data = (double*) chunk.data();
+
+    for (size_t idx = 0; idx < n * 6; idx++) data[idx] = element(task, idx / 6, idx / 3 % 2, idx % 3);
+
+    return chunk;
+}
+
+static bool is_chunk_of(beo::Chunk& chunk, const int task, const size_t n)
+{
+    if (3 != chunk.ndim() || size_t(task) != chunk.offset(0) || n != chunk.length(0) || n * 6 * sizeof(double) != chunk.bytes())
+    {
+        return false;
+    }
+
+    const double* data = (const double*) chunk.data();
+
+    for (size_t idx = 0; idx < n * 6; idx++)
+    {
+        if (data[idx] != element(task, idx / 6, idx / 3 % 2, idx % 3)) return false;
+    }
+
+    return true;
+}
+
+void example(beo::Enviroment& env)
+{
+    auto& world = env.comms().world();
+
+    const int task_id   = world.task_id();
+    const int num_tasks = world.num_tasks();
+    const int last      = num_tasks - 1;
+
+    const int right = (task_id + 1) % num_tasks;
+    const int left  = (task_id + num_tasks - 1) % num_tasks;
+
+    //-----------------------------------------------------------------------------------------------------
+    //Whole chunks around a ring. The reciever learns the tag, and allocates the chunk, from the message
+    for (const size_t n : {1, 10, 5000})
+    {
+        beo::Chunk out = make_chunk(task_id, n), in;
+
+        beo::Chunk_Request recv = beo::async_recv_chunk(world, in, left, 5);
+        beo::Chunk_Request send = beo::async_send_chunk(world, out, right, 5);
+
+        EXAMPLE_CHECK(BEO_SUCCESS == recv.wait());
+        EXAMPLE_CHECK(BEO_SUCCESS == send.wait());
+        EXAMPLE_CHECK(is_chunk_of(in, left, n));
+
+        //and blocking, from task 0 to the last task
+        if (0 == task_id) EXAMPLE_CHECK(BEO_SUCCESS == beo::send_chunk(world, out, last, 6));
+
+        if (last == task_id)
+        {
+            beo::Chunk from_first;
+
+            EXAMPLE_CHECK(BEO_SUCCESS == beo::recv_chunk(world, from_first, 0, 6));
+            EXAMPLE_CHECK(is_chunk_of(from_first, 0, n));
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------
+    //A 2 x 3 x 4 block from the middle of a 6 x 7 x 8 chunk on task 0, into a 5 x 5 x 5 one on the last task,
+    //without packing
+    beo::Chunk src(beo::Chunk_Tag({0, 0, 0}, {6, 7, 8}));
+    src.allocate(6 * 7 * 8 * sizeof(double));
+
+    for (size_t idx = 0; idx < 6 * 7 * 8; idx++) ((double*) src.data())[idx] = element(0, idx / 56, idx / 8 % 7, idx % 8);
+
+    beo::Chunk dest(beo::Chunk_Tag({0, 0, 0}, {5, 5, 5}));
+    dest.allocate(5 * 5 * 5 * sizeof(double));
+
+    auto check_block = [&]()
+    {
+        const double* data = (const double*) dest.data();
+
+        for (size_t i = 0; i < 2; i++)
+        {
+            for (size_t j = 0; j < 3; j++)
+            {
+                for (size_t k = 0; k < 4; k++)
+                {
+                    EXAMPLE_CHECK(data[((0 + i) * 5 + 1 + j) * 5 + 1 + k] == element(0, 1 + i, 2 + j, 3 + k));
+                }
+            }
+        }
+    };
+
+    beo::Sub_Block src_block(src, {1, 2, 3}, {2, 3, 4}, sizeof(double));
+    beo::Sub_Block dest_block(dest, {0, 1, 1}, {2, 3, 4}, sizeof(double));
+
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::send_recv(world,
+                                                (last == task_id) ? dest_block : beo::Sub_Block(),
+                                                (0 == task_id) ? src_block : beo::Sub_Block(),
+                                                last, 0, 7));
+
+    if (last == task_id) check_block();
+
+    //the same, asynchronously
+    for (size_t idx = 0; idx < 5 * 5 * 5; idx++) ((double*) dest.data())[idx] = -1.0;
+
+    beo::Request request = beo::async_send_recv(world, dest_block, src_block, last, 0, 8);
+    EXAMPLE_CHECK(BEO_SUCCESS == request.wait());
+
+    if (last == task_id) check_block();
+
+    //and completing on its own, without a wait, whether polled or with a callback
+    for (size_t idx = 0; idx < 5 * 5 * 5; idx++) ((double*) dest.data())[idx] = -1.0;
+
+    request = beo::async_send_recv(world, dest_block, src_block, last, 0, 9);
+    while (!request.is_complete()) {}
+
+    if (last == task_id) check_block();
+
+    for (size_t idx = 0; idx < 5 * 5 * 5; idx++) ((double*) dest.data())[idx] = -1.0;
+
+    bool has_arrived = false;
+
+    request = beo::async_send_recv(world, dest_block, src_block, last, 0, 10);
+    request.then([&](const int stat) {has_arrived = (BEO_SUCCESS == stat);});
+
+    EXAMPLE_CHECK(BEO_SUCCESS == env.event_loop().run());
+    EXAMPLE_CHECK(has_arrived);
+
+    if (last == task_id) check_block();
+
+    //every task writes its block to its own place in a file, and reads it back
+    for (size_t idx = 0; idx < 5 * 5 * 5; idx++) ((double*) dest.data())[idx] = -1.0;
+
+    beo::Shared_File file("chunk_transfer.bin");
+    EXAMPLE_CHECK(BEO_SUCCESS == file.open(world, "w+"));
+
+    const size_t offset = task_id * src_block.bytes();
+
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::write_block_at(file, offset, src_block));
+    beo::barrier(world);
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::read_block_at(file, offset, dest_block));
+
+    check_block();
+
+    file.close();
+
+    beo::barrier(world);
+
+    if (0 == task_id) remove("chunk_transfer.bin");
+}
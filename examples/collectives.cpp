@@ -0,0 +1,171 @@
+/*****************************************
+ * collectives.cpp
+ *
+ * Example of the node-aware collectives
+ *   on beo::Comms, the asynchronous and
+ *   fuzzy barriers and allreduce, and
+ *   point-to-point messages driven by the
+ *   progress engine. Build and run with
+ *   mkme_examples.sh
+*****************************************/
+#include "example.hpp"
+
+#include <unistd.h>
+#include <vector>
+#include <algorithm>
+
+void example(beo::Enviroment& env)
+{
+    auto& comms = env.comms();
+    auto& world = comms.world();
+
+    const int task_id   = world.task_id();
+    const int num_tasks = world.num_tasks();
+    const int last      = num_tasks - 1;
+
+    //-----------------------------------------------------------------------------------------------------
+    //Node-aware collectives, rooted on the last task so the root is rarely its node's leader
+    double sum[2] = {(double) task_id, 1.0};
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::allreduce(comms, sum, 2, beo::Op::sum));
+    EXAMPLE_CHECK(sum[0] == num_tasks * (num_tasks - 1) / 2 && sum[1] == num_tasks);
+
+    double max[2] = {(double) task_id, (double) -task_id};
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::reduce(comms, max, 2, beo::Op::max, last));
+    if (task_id == last) EXAMPLE_CHECK(max[0] == last && max[1] == 0.0);
+
+    //a tag 0 message of the user's on the shared comm. is not mixed up with the root's hand off
+    auto& shared = comms.shared();
+
+    const int  leader    = comms.leader_of(comms.node_of(last));
+    const bool has_extra = (last != leader);
+
+    int extra = 7;
+    beo::Request extra_send;
+
+    if (has_extra && task_id == last)
+    {
+        extra_send = beo::async_send_recv(shared, nullptr, &extra, sizeof(int), comms.shared_id_of(leader), shared.task_id(), 0);
+    }
+
+    int value = (task_id == last) ? 42 : 0;
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::broadcast(comms, &value, sizeof(int), last));
+    EXAMPLE_CHECK(42 == value);
+
+    if (has_extra && task_id == leader)
+    {
+        extra = 0;
+        EXAMPLE_CHECK(BEO_SUCCESS == beo::send_recv(shared, &extra, nullptr, sizeof(int), shared.task_id(), comms.shared_id_of(last), 0));
+        EXAMPLE_CHECK(7 == extra);
+    }
+
+    EXAMPLE_CHECK(BEO_SUCCESS == extra_send.wait());
+
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::barrier(comms));
+
+    //-----------------------------------------------------------------------------------------------------
+    //Asynchronous allreduce and barrier, with a different late task each time
+    for (int idx = 0; idx < 5; idx++)
+    {
+        if (task_id == idx % num_tasks) usleep(2000);
+
+        //outside of MPI, one asynchronous collective at a time on a comm
+        long count = task_id + idx;
+        beo::Request request = beo::async_allreduce(world, &count, 1, beo::Op::sum);
+
+        EXAMPLE_CHECK(BEO_SUCCESS == request.wait());
+        EXAMPLE_CHECK(count == num_tasks * (num_tasks - 1) / 2 + num_tasks * idx);
+
+        request = beo::async_barrier(world);
+
+        EXAMPLE_CHECK(BEO_SUCCESS == request.wait());
+    }
+
+    //the tasks that arrive early at a fuzzy barrier do work until the late one arrives
+    long num_work = 0;
+    if (0 == task_id) usleep(20000);
+
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::fuzzy_barrier(world, [&]() {return ++num_work < 1000000000;}));
+
+    //and stop once they run out
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::fuzzy_barrier(world, [&]() {return false;}));
+
+    //-----------------------------------------------------------------------------------------------------
+    //A ring of messages, with the progress engine moving them along while this thread works
+    EXAMPLE_CHECK(BEO_SUCCESS == env.progress().start(world, beo::Progress_Engine::Mode::thread));
+
+    const int right = (task_id + 1) % num_tasks;
+    const int left  = (task_id + num_tasks - 1) % num_tasks;
+
+    std::vector<double> out(100000, task_id), in(100000, -1.0);
+
+    const size_t bytes = out.size() * sizeof(double);
+
+    std::vector<beo::Request> requests;
+
+    if (1 == num_tasks)
+    {
+        requests.push_back(beo::async_send_recv(world, in.data(), out.data(), bytes, task_id, task_id, 2));
+    }
+
+    else
+    {
+        requests.push_back(beo::async_send_recv(world, in.data(), nullptr, bytes, task_id, left, 2));
+        requests.push_back(beo::async_send_recv(world, nullptr, out.data(), bytes, right, task_id, 2));
+    }
+
+    env.progress().begin_compute();
+    usleep(1000);
+    env.progress().end_compute();
+
+    for (auto& request : requests) EXAMPLE_CHECK(BEO_SUCCESS == env.progress().wait(request));
+
+    EXAMPLE_CHECK(in.front() == left && in.back() == left);
+
+    //the engine only drives the requests handed to the event loop, and under MPI completes them itself
+    //while this thread computes. Every callback then fires on the first poll
+    beo::barrier(world);
+
+    std::fill(in.begin(), in.end(), -1.0);
+
+    int num_arrived = 0;
+
+    auto arrived = [&](const int stat) {num_arrived += (BEO_SUCCESS == stat) ? 1 : 0;};
+
+    if (1 == num_tasks)
+    {
+        beo::async_send_recv(world, in.data(), out.data(), bytes, task_id, task_id, 3).then(arrived);
+    }
+
+    else
+    {
+        beo::async_send_recv(world, in.data(), nullptr, bytes, task_id, left, 3).then(arrived);
+        beo::async_send_recv(world, nullptr, out.data(), bytes, right, task_id, 3).then(arrived);
+    }
+
+    const int    num_requests  = (1 == num_tasks) ? 1 : 2;
+    const size_t num_polls     = env.progress().num_polls();
+    const size_t num_completed = env.progress().num_completed();
+
+    env.progress().begin_compute();
+
+    for (int idx = 0; idx < 200; idx++)
+    {
+        usleep(1000);
+        env.progress().poll();
+    }
+
+    env.progress().end_compute();
+
+    EXAMPLE_CHECK(env.progress().num_polls() > num_polls);
+
+    #if defined _BEO_MPI_
+    if (num_tasks > 1) EXAMPLE_CHECK(num_completed + num_requests == env.progress().num_completed());
+    #else
+    EXAMPLE_CHECK(num_completed == env.progress().num_completed());
+    #endif
+    EXAMPLE_CHECK(num_requests == (int) env.event_loop().poll());
+    EXAMPLE_CHECK(num_requests == num_arrived);
+    EXAMPLE_CHECK(in.front() == left && in.back() == left);
+
+    env.progress().stop();
+}
@@ -0,0 +1,111 @@
+/*****************************************
+ * coroutines.cpp
+ *
+ * Example of pipelined work written as
+ *   beo::Task coroutines: each stage
+ *   passes a buffer and a chunk around a
+ *   ring and writes what it got to a
+ *   file, and the beo::Scheduler runs
+ *   the others while one waits. Needs
+ *   C++20. Build and run with
+ *   mkme_examples.sh
+*****************************************/
+#include "example.hpp"
+
+#include <stdio.h>
+
+#if defined _BEO_HAS_COROUTINES_
+
+#include <vector>
+
+static const size_t num_values = 1000;
+
+static const int    num_stages = 4;
+
+//adds x to sum, after letting the other stages run
+static beo::Task add_later(const int x, int& sum)
+{
+    co_await beo::yield();
+
+    sum += x;
+
+    co_return BEO_SUCCESS;
+}
+
+static beo::Task stage(beo::Comm& world, beo::Shared_File& file, const int k, int& sum)
+{
+    const int task_id   = world.task_id();
+    const int num_tasks = world.num_tasks();
+
+    const int right = (task_id + 1) % num_tasks;
+    const int left  = (task_id + num_tasks - 1) % num_tasks;
+
+    const size_t bytes = num_values * sizeof(double);
+
+    std::vector<double> out(num_values, 100.0 * task_id + k), in(num_values, -1.0);
+
+    int stat = BEO_SUCCESS;
+
+    //a buffer from the left, while this one goes right
+    if (1 == num_tasks)
+    {
+        stat |= co_await beo::async_send_recv(world, in.data(), out.data(), bytes, task_id, task_id, 10 + k);
+    }
+
+    else
+    {
+        beo::Request recv = beo::async_send_recv(world, in.data(), nullptr, bytes, task_id, left, 10 + k);
+
+        stat |= co_await beo::async_send_recv(world, nullptr, out.data(), bytes, right, task_id, 10 + k);
+        stat |= co_await recv;
+    }
+
+    for (const auto value : in) EXAMPLE_CHECK(value == 100.0 * left + k);
+
+    stat |= co_await file.async_write_at((task_id * num_stages + k) * bytes, in.data(), bytes);
+
+    stat |= co_await add_later(k, sum);
+
+    //a chunk, whose tag comes with it
+    beo::Chunk chunk(beo::Chunk_Tag({size_t(k)}, {10})), from_left;
+    chunk.allocate(10 * sizeof(double));
+
+    beo::Chunk_Request recv_chunk = beo::async_recv_chunk(world, from_left, left, 50 + k);
+
+    stat |= co_await beo::async_send_chunk(world, chunk, right, 50 + k);
+    stat |= co_await recv_chunk;
+
+    EXAMPLE_CHECK(size_t(k) == from_left.offset(0) && 10 == from_left.length(0));
+
+    co_return stat;
+}
+
+void example(beo::Enviroment& env)
+{
+    auto& world = env.comms().world();
+
+    beo::Shared_File file("coroutines.bin");
+    EXAMPLE_CHECK(BEO_SUCCESS == file.open(world, "w+"));
+
+    int sum = 0;
+
+    for (int k = 0; k < num_stages; k++) env.scheduler().spawn(stage(world, file, k, sum));
+
+    EXAMPLE_CHECK(BEO_SUCCESS == env.scheduler().run());
+    EXAMPLE_CHECK(num_stages * (num_stages - 1) / 2 == sum);
+
+    file.close();
+
+    beo::barrier(world);
+
+    if (world.is_master()) remove("coroutines.bin");
+}
+
+#else
+
+void example(beo::Enviroment& env)
+{
+    if (env.comms().world().is_master()) printf("coroutines.cpp needs C++20 coroutines, skipping\n");
+}
+
+#endif
@@ -0,0 +1,195 @@
+/*****************************************
+ * dynamic_work.cpp
+ *
+ * Example of irregular work: chunks
+ *   handed out with a beo::Task_Counter,
+ *   small messages coalesced by a
+ *   beo::Aggregator, and tokens passed
+ *   around a ring until a
+ *   beo::Termination_Detector sees that
+ *   all of them have stopped. Build and
+ *   run with mkme_examples.sh
+*****************************************/
+#include "example.hpp"
+
+#include <unistd.h>
+#include <deque>
+#include <vector>
+
+//A ring of tasks that pass tokens to the right. A token
+//  holds how many more hops it makes
+struct Ring
+{
+    beo::Comm&                 world;
+
+    beo::Termination_Detector& detector;
+
+    int                        left;
+
+    int                        right;
+
+    int                        in{0};
+
+    //tokens sent, which must live until they arrive
+    std::deque<int>            out;
+
+    long                       num_handled{0};
+
+    Ring(beo::Comm& world_, beo::Termination_Detector& detector_)
+        : world(world_),
+          detector(detector_),
+          left((world_.task_id() + world_.num_tasks() - 1) % world_.num_tasks()),
+          right((world_.task_id() + 1) % world_.num_tasks()) {}
+
+    void post_recv();
+
+    void post_send(const int token);
+
+    void send(const int hops) {detector.sent(); post_send(hops);}
+
+    //a token that is not counted, which ends the ring
+    void end() {post_send(-1);}
+};
+
+void Ring::post_send(const int token)
+{
+    out.push_back(token);
+
+    beo::async_send_recv(world, nullptr, &out.back(), sizeof(int), right, world.task_id(), 7).then([](int) {});
+}
+
+//handles the next token from the left, on the event loop
+void Ring::post_recv()
+{
+    beo::async_send_recv(world, &in, nullptr, sizeof(int), world.task_id(), left, 7).then([this](int)
+    {
+        //a negative token ends the ring
+        if (in < 0) return;
+
+        detector.received();
+        num_handled++;
+
+        if (in > 0) send(in - 1);
+
+        post_recv();
+    });
+}
+
+void example(beo::Enviroment& env)
+{
+    auto& world = env.comms().world();
+
+    const int task_id   = world.task_id();
+    const int num_tasks = world.num_tasks();
+
+    //-----------------------------------------------------------------------------------------------------
+    //Chunks of uneven cost, each run once by whichever task claims it first
+    beo::Data_Tag data_tag("work");
+
+    for (size_t offset = 0; offset < 40; offset++) data_tag.add_chunk_tag(beo::Chunk_Tag({offset}, {1}));
+
+    for (const size_t batch : {1, 3})
+    {
+        long done[2] = {0, 0};
+
+        int stat = beo::for_each_chunk_dynamic(world, data_tag, [&](beo::Chunk_Tag& chunk_tag)
+        {
+            if (0 == chunk_tag.offset(0) % 7) usleep(5000);
+
+            done[0]++;
+            done[1] += chunk_tag.offset(0);
+
+            return BEO_SUCCESS;
+        }, batch);
+
+        EXAMPLE_CHECK(BEO_SUCCESS == stat);
+
+        beo::allreduce(world, done, 2, beo::Op::sum);
+
+        EXAMPLE_CHECK(40 == done[0] && 40 * 39 / 2 == done[1]);
+    }
+
+    //the counter itself
+    beo::Task_Counter counter;
+    EXAMPLE_CHECK(BEO_SUCCESS == counter.allocate(world));
+
+    EXAMPLE_CHECK(counter.next(2) < 2 * num_tasks);
+    beo::barrier(world);
+    EXAMPLE_CHECK(2 * num_tasks == counter.next(0));
+
+    EXAMPLE_CHECK(BEO_SUCCESS == counter.free());
+
+    //-----------------------------------------------------------------------------------------------------
+    //Many small messages to every task, which travel as one buffer per destination
+    {
+        beo::Aggregator aggregator(world, 1024);
+
+        const int num_messages = 100;
+
+        std::vector<int> out(num_messages), in(num_messages * num_tasks, -1);
+
+        for (int idx = 0; idx < num_messages; idx++) out[idx] = idx * 1000 + task_id;
+
+        for (int task = 0; task < num_tasks; task++)
+        {
+            for (int idx = 0; idx < num_messages; idx++)
+            {
+                int* dest = &in[task * num_messages + idx];
+
+                if (task == task_id)
+                {
+                    EXAMPLE_CHECK(BEO_SUCCESS == aggregator.post(dest, &out[idx], sizeof(int), task_id, task_id, idx));
+                    continue;
+                }
+
+                EXAMPLE_CHECK(BEO_SUCCESS == aggregator.post(nullptr, &out[idx], sizeof(int), task, task_id, idx));
+                EXAMPLE_CHECK(BEO_SUCCESS == aggregator.post(dest, nullptr, sizeof(int), task_id, task, idx));
+            }
+        }
+
+        EXAMPLE_CHECK(BEO_SUCCESS == aggregator.wait());
+
+        for (int task = 0; task < num_tasks; task++)
+        {
+            for (int idx = 0; idx < num_messages; idx++) EXAMPLE_CHECK(in[task * num_messages + idx] == idx * 1000 + task);
+        }
+
+        aggregator.finalize();
+    }
+
+    //-----------------------------------------------------------------------------------------------------
+    //Tokens around a ring. No task knows how many will arrive, so the detector decides when all are done
+    beo::Termination_Detector detector;
+    detector.init(world);
+
+    Ring ring(world, detector);
+
+    //a token of h hops is handled h + 1 times
+    long expected = 0;
+
+    if (num_tasks > 1)
+    {
+        ring.post_recv();
+
+        for (int hops = task_id; hops < task_id + 5; hops++)
+        {
+            ring.send(hops);
+            expected += hops + 1;
+        }
+    }
+
+    EXAMPLE_CHECK(BEO_SUCCESS == detector.wait());
+    EXAMPLE_CHECK(detector.is_done());
+
+    long handled[2] = {ring.num_handled, expected};
+    beo::allreduce(world, handled, 2, beo::Op::sum);
+
+    EXAMPLE_CHECK(handled[0] == handled[1]);
+
+    //end the ring, so no recieve is left posted
+    if (num_tasks > 1) ring.end();
+
+    env.event_loop().run();
+
+    detector.finalize();
+}
@@ -0,0 +1,131 @@
+/*****************************************
+ * example.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * The main() shared by the self-checking
+ *   examples. Each one defines
+ *
+ *     void example(beo::Enviroment& env);
+ *
+ *   and checks its results with
+ *   EXAMPLE_CHECK(condition), which
+ *   prints the condition and line of a
+ *   failure.
+ *
+ * The backend is picked at build time
+ *   with -D_BEO_MPI_, -D_BEO_THREADS_ or
+ *   -D_BEO_SHM_, or none for a serial
+ *   build (see mkme_examples.sh). With
+ *   _BEO_THREADS_ the example runs on
+ *   EXAMPLE_NUM_TASKS threads.
+ *
+ * The master prints whether every task
+ *   passed, and the program exits with 1
+ *   if any task failed
+*****************************************/
+#ifndef _BEO_EXAMPLE_HPP_
+#define _BEO_EXAMPLE_HPP_
+
+#if defined _BEO_MPI_
+#include <mpi.h>
+#endif
+
+#include <stdio.h>
+#include <atomic>
+
+//Note this is included after the backend is defined
+#include "../include/beo.hpp"
+
+#ifndef EXAMPLE_NUM_TASKS
+#define EXAMPLE_NUM_TASKS 3
+#endif
+
+#define EXAMPLE_CHECK(cond) example_check((cond), #cond, __FILE__, __LINE__)
+
+void example(beo::Enviroment& env);
+
+/*****************************************
+ * example_failures
+ *
+ * The failed checks of this task, which
+ *   is a thread with _BEO_THREADS_
+*****************************************/
+inline int& example_failures()
+{
+    static thread_local int failures = 0;
+
+    return failures;
+}
+
+inline void example_check(const bool ok, const char* cond, const char* file, const int line)
+{
+    if (ok) return;
+
+    example_failures()++;
+
+    printf("%s:%d check failed: %s\n", file, line, cond);
+}
+
+/*****************************************
+ * run_example
+ *
+ * Runs the example on this task, and
+ *   returns 1 if any task failed
+*****************************************/
+inline int run_example()
+{
+    int failures;
+
+    {
+        beo::Enviroment env;
+
+        example(env);
+
+        auto& world = env.comms().world();
+
+        failures = example_failures();
+
+        beo::allreduce(world, &failures, 1, beo::Op::sum);
+
+        if (world.is_master())
+        {
+            printf("%s on %d tasks: %s\n", __BASE_FILE__, world.num_tasks(), (0 == failures) ? "passed" : "FAILED");
+        }
+
+        env.finalize();
+    }
+
+    return (0 == failures) ? 0 : 1;
+}
+
+int main()
+{
+    #if defined _BEO_MPI_
+
+    int provided;
+    MPI_Init_thread(NULL, NULL, MPI_THREAD_MULTIPLE, &provided);
+
+    const int stat = run_example();
+
+    MPI_Finalize();
+
+    return stat;
+
+    #elif defined _BEO_THREADS_
+
+    std::atomic<int> stat{0};
+
+    beo::launch(EXAMPLE_NUM_TASKS, [&]() {stat |= run_example();});
+
+    return stat;
+
+    #else
+
+    return run_example();
+
+    #endif
+}
+
+#endif
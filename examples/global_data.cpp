@@ -0,0 +1,207 @@
+/*****************************************
+ * global_data.cpp
+ *
+ * Example of one-sided access to a
+ *   beo::Global_Data: whole chunks with
+ *   get/put/accumulate, the
+ *   Scatter_Accumulator, single elements
+ *   with get_at/accumulate_at, and
+ *   gather. Also
+ *   allocates a beo::Shared_Data, which
+ *   the tasks of a node read and write
+ *   directly. Build and run with
+ *   mkme_examples.sh
+*****************************************/
+#include "example.hpp"
+
+#include <vector>
+#include <random>
+#include <algorithm>
+
+//the value of element (i, j) of the n x n matrix
+static double element(const size_t i, const size_t j, const size_t n)
+{
+    return 1.0 + i * n + j;
+}
+
+void example(beo::Enviroment& env)
+{
+    auto& world = env.comms().world();
+
+    const int task_id   = world.task_id();
+    const int num_tasks = world.num_tasks();
+
+    //an n x n matrix in bs x bs chunks, with ragged ones at the edges
+    const size_t n = 37, bs = 8;
+
+    beo::Data_Tag data_tag("matrix");
+
+    for (size_t i = 0; i < n; i += bs)
+    {
+        for (size_t j = 0; j < n; j += bs)
+        {
+            data_tag.add_chunk_tag(beo::Chunk_Tag({i, j}, {std::min(bs, n - i), std::min(bs, n - j)}));
+        }
+    }
+
+    beo::Global_Data global_data("matrix");
+    EXAMPLE_CHECK(BEO_SUCCESS == global_data.allocate(world, data_tag, sizeof(double)));
+
+    //each task fills the chunks it owns
+    for (auto& [key, chunk_tag] : data_tag.chunk_tags())
+    {
+        if (!global_data.is_local(key)) continue;
+
+        double* data = (double*) global_data.local_data(key);
+
+        for (size_t i = 0; i < chunk_tag.length(0); i++)
+        {
+            for (size_t j = 0; j < chunk_tag.length(1); j++)
+            {
+                data[i * chunk_tag.length(1) + j] = element(key[0] + i, key[1] + j, n);
+            }
+        }
+    }
+
+    global_data.sync();
+
+    //-----------------------------------------------------------------------------------------------------
+    //Whole chunks. A chunk allocated too small for its tag is rejected
+    beo::Chunk chunk(data_tag.get_chunk_tag({bs, bs}));
+
+    EXAMPLE_CHECK(BEO_SUCCESS == global_data.get(chunk));
+    EXAMPLE_CHECK(((double*) chunk.data())[bs + 1] == element(bs + 1, bs + 1, n));
+
+    beo::Chunk small(data_tag.get_chunk_tag({0, 0}));
+    small.allocate(sizeof(double));
+
+    EXAMPLE_CHECK(BEO_FAIL == global_data.get(small));
+    EXAMPLE_CHECK(BEO_FAIL == global_data.put(small));
+
+    global_data.sync();
+
+    //every task adds 1 to the whole chunk
+    for (size_t idx = 0; idx < bs * bs; idx++) ((double*) chunk.data())[idx] = 1.0;
+
+    EXAMPLE_CHECK(BEO_SUCCESS == global_data.accumulate<double>(chunk));
+
+    global_data.sync();
+
+    EXAMPLE_CHECK(BEO_SUCCESS == global_data.get(chunk));
+    EXAMPLE_CHECK(((double*) chunk.data())[0] == element(bs, bs, n) + num_tasks);
+
+    global_data.sync();
+
+    //-----------------------------------------------------------------------------------------------------
+    //Scatter (index, value) contributions, which are combined and sent to the owners in batches
+    {
+        beo::Scatter_Accumulator<double> accumulator(global_data, data_tag, beo::Op::sum, 100);
+
+        for (size_t i = 0; i < n; i++) EXAMPLE_CHECK(BEO_SUCCESS == accumulator.add({i, i}, 0.5));
+
+        EXAMPLE_CHECK(BEO_SUCCESS == accumulator.flush());
+    }
+
+    global_data.sync();
+
+    //the chunk at (bs, bs) was also accumulated into above
+    for (size_t i0 = 0; i0 < n; i0 += bs)
+    {
+        beo::Chunk diagonal(data_tag.get_chunk_tag({i0, i0}));
+
+        EXAMPLE_CHECK(BEO_SUCCESS == global_data.get(diagonal));
+
+        for (size_t k = 0; k < diagonal.length(0); k++)
+        {
+            const double expected = element(i0 + k, i0 + k, n) + 0.5 * num_tasks + ((bs == i0) ? num_tasks : 0);
+
+            EXAMPLE_CHECK(((double*) diagonal.data())[k * diagonal.length(1) + k] == expected);
+        }
+    }
+
+    global_data.sync();
+
+    //-----------------------------------------------------------------------------------------------------
+    //Single elements, found with an Element_Locator
+    beo::Element_Locator locator(global_data, data_tag);
+
+    int    owner;
+    size_t displacement;
+    double value;
+
+    const size_t index[2] = {n - 1, 3};
+    locator.locate(index, owner, displacement);
+
+    EXAMPLE_CHECK(BEO_SUCCESS == global_data.get_at(owner, &displacement, &value, 1));
+    EXAMPLE_CHECK(value == element(n - 1, 3, n));
+
+    global_data.sync();
+
+    const double one = 1.0;
+    EXAMPLE_CHECK(BEO_SUCCESS == global_data.accumulate_at<double>(owner, &displacement, &one, 1));
+
+    global_data.sync();
+
+    EXAMPLE_CHECK(BEO_SUCCESS == global_data.get_at(owner, &displacement, &value, 1));
+    EXAMPLE_CHECK(value == element(n - 1, 3, n) + num_tasks);
+
+    global_data.sync();
+
+    //-----------------------------------------------------------------------------------------------------
+    //Gather random elements, with repeats, in one call
+    std::mt19937 rng(task_id + 1);
+
+    std::vector<size_t> indices;
+    for (int idx = 0; idx < 1000; idx++)
+    {
+        indices.push_back(rng() % n);
+        indices.push_back(rng() % n);
+    }
+
+    std::vector<double> values;
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::gather(locator, indices, values));
+    EXAMPLE_CHECK(1000 == values.size());
+
+    for (size_t idx = 0; idx < values.size(); idx++)
+    {
+        const size_t i = indices[2 * idx], j = indices[2 * idx + 1];
+
+        //the chunk at (bs, bs), the diagonal and element (n - 1, 3) were accumulated into above
+        double expected = element(i, j, n);
+
+        if (i >= bs && i < 2 * bs && j >= bs && j < 2 * bs) expected += num_tasks;
+        if (i == j)                                          expected += 0.5 * num_tasks;
+        if (i == n - 1 && j == 3)                            expected += num_tasks;
+
+        EXAMPLE_CHECK(values[idx] == expected);
+    }
+
+    global_data.sync();
+
+    EXAMPLE_CHECK(BEO_SUCCESS == global_data.free());
+
+    //-----------------------------------------------------------------------------------------------------
+    //Shared_Data is only on the tasks that share memory
+    beo::Shared_Data shared_data("shared");
+
+    auto& shared = env.comms().shared();
+
+    EXAMPLE_CHECK(BEO_SUCCESS == shared_data.allocate(shared, data_tag, sizeof(double)));
+
+    for (auto& [key, chunk_tag] : data_tag.chunk_tags())
+    {
+        if (shared_data.is_local(key)) ((double*) shared_data.data(key))[0] = element(key[0], key[1], n);
+    }
+
+    shared_data.sync();
+
+    //every task reads every chunk directly
+    for (auto& [key, chunk_tag] : data_tag.chunk_tags())
+    {
+        EXAMPLE_CHECK(((double*) shared_data.data(key))[0] == element(key[0], key[1], n));
+    }
+
+    shared_data.sync();
+
+    EXAMPLE_CHECK(BEO_SUCCESS == shared_data.free());
+}
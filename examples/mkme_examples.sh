@@ -0,0 +1,28 @@
+#!/bin/bash
+# Builds and runs the self-checking examples with each backend:
+#   serial, threads (_BEO_THREADS_), shared memory (_BEO_SHM_)
+#   and MPI (_BEO_MPI_). Exits with 1 if any of them fails
+#   usage: ./mkme_examples.sh [example ...]
+cd "$(dirname "$0")"
+
+EXAMPLES=${@:-"thread_pool global_data collectives dynamic_work monitoring tensor_ops chunk_transfer coroutines task_graph"}
+MPIEXEC=${MPIEXEC:-"mpiexec -np 3"}
+FLAGS="--std=c++20 -g -Wall -Wextra"
+
+status=0
+for example in $EXAMPLES; do
+    rm -f $example.exe
+    g++ $FLAGS $example.cpp -o $example.exe -lpthread -lrt && ./$example.exe || status=1
+
+    rm -f $example.exe
+    g++ $FLAGS -D_BEO_THREADS_ $example.cpp -o $example.exe -lpthread -lrt && ./$example.exe || status=1
+
+    rm -f $example.exe
+    g++ $FLAGS -D_BEO_SHM_ $example.cpp -o $example.exe -lpthread -lrt && ./shm_run.sh 3 ./$example.exe || status=1
+
+    rm -f $example.exe
+    mpic++ $FLAGS -D_BEO_MPI_ $example.cpp -o $example.exe && $MPIEXEC ./$example.exe || status=1
+
+    rm -f $example.exe
+done
+exit $status
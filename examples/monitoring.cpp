@@ -0,0 +1,98 @@
+/*****************************************
+ * monitoring.cpp
+ *
+ * Example of the per-task performance
+ *   counters, and of the communication
+ *   tracing, which this example always
+ *   builds with. Build and run with
+ *   mkme_examples.sh
+*****************************************/
+#define _BEO_TRACE_
+
+#include "example.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+void example(beo::Enviroment& env)
+{
+    auto& world = env.comms().world();
+
+    const int task_id   = world.task_id();
+    const int num_tasks = world.num_tasks();
+
+    const int right = (task_id + 1) % num_tasks;
+    const int left  = (task_id + num_tasks - 1) % num_tasks;
+
+    //-----------------------------------------------------------------------------------------------------
+    //A ring of messages, with one task sending to itself
+    auto& counters = env.counters();
+
+    const uint64_t num_sent     = counters.messages_sent(right);
+    const uint64_t num_received = counters.messages_received(left);
+    const uint64_t bytes_sent   = counters.bytes_sent(right);
+
+    std::vector<double> out(1000, task_id), in(1000, -1.0);
+
+    const size_t bytes = out.size() * sizeof(double);
+
+    std::vector<beo::Request> requests;
+
+    if (1 == num_tasks)
+    {
+        requests.push_back(beo::async_send_recv(world, in.data(), out.data(), bytes, task_id, task_id, 3));
+    }
+
+    else
+    {
+        requests.push_back(beo::async_send_recv(world, in.data(), nullptr, bytes, task_id, left, 3));
+        requests.push_back(beo::async_send_recv(world, nullptr, out.data(), bytes, right, task_id, 3));
+    }
+
+    for (auto& request : requests) EXAMPLE_CHECK(BEO_SUCCESS == request.wait());
+
+    //the counters have one message each way, and copies to self are not messages
+    const uint64_t num_messages = (1 == num_tasks) ? 0 : 1;
+
+    EXAMPLE_CHECK(num_sent + num_messages == counters.messages_sent(right));
+    EXAMPLE_CHECK(num_received + num_messages == counters.messages_received(left));
+    EXAMPLE_CHECK(bytes_sent + num_messages * bytes == counters.bytes_sent(right));
+
+    //-----------------------------------------------------------------------------------------------------
+    //The trace has the send to the right, and the master writes everyone's events to a file
+    bool has_send = false;
+
+    for (const auto& event : beo::Trace::instance().events(task_id, false))
+    {
+        has_send |= ((int32_t) beo::Trace::Op::async_send_recv == event.op)
+                 && (right == event.peer) && (3 == event.tag) && (bytes == event.bytes);
+    }
+
+    EXAMPLE_CHECK(has_send);
+
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::write_trace(world, "monitoring_trace.json"));
+
+    if (world.is_master())
+    {
+        std::vector<char> text(1 << 20, '\0');
+
+        FILE* file = fopen("monitoring_trace.json", "r");
+        EXAMPLE_CHECK(nullptr != file);
+
+        if (nullptr != file)
+        {
+            EXAMPLE_CHECK(fread(text.data(), 1, text.size() - 1, file) > 0);
+            fclose(file);
+        }
+
+        EXAMPLE_CHECK(nullptr != strstr(text.data(), "\"traceEvents\""));
+        EXAMPLE_CHECK(nullptr != strstr(text.data(), "async_send_recv"));
+
+        remove("monitoring_trace.json");
+
+        //finalize writes the trace again, which this example does not keep
+        setenv("BEO_TRACE_FILE", "/dev/null", 1);
+    }
+}
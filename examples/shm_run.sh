@@ -0,0 +1,16 @@
+#!/bin/bash
+# Runs N copies of a beo program built with _BEO_SHM_
+#   usage: ./shm_run.sh N ./program [args...]
+N=$1
+shift
+export BEO_SHM_SIZE=$N
+export BEO_SHM_NAME=beo.$$
+export BEO_SHM_NONCE=$$.$RANDOM.$(date +%s%N)
+for (( rank=0; rank<N; rank++ )); do
+    BEO_SHM_RANK=$rank "$@" &
+done
+status=0
+for job in $(jobs -p); do
+    wait $job || status=1
+done
+exit $status
@@ -0,0 +1,139 @@
+/*****************************************
+ * task_graph.cpp
+ *
+ * Example of a beo::Task_Graph that
+ *   multiplies two block matrices,
+ *   D = 2 * A * B, chunk by chunk. Each
+ *   task only updates the chunks of C it
+ *   owns. Build and run with
+ *   mkme_examples.sh
+*****************************************/
+#include "example.hpp"
+
+#include <vector>
+
+static double a_element(const size_t i, const size_t j) {return double((3 * i + j) % 7) - 3.0;}
+
+static double b_element(const size_t i, const size_t j) {return double((i + 2 * j) % 5) - 2.0;}
+
+void example(beo::Enviroment& env)
+{
+    auto& world = env.comms().world();
+
+    //an n x n matrix in nb x nb chunks of bs x bs
+    const size_t nb = 4, bs = 8, n = nb * bs;
+
+    beo::Data_Tag data_tag("matrix");
+
+    for (size_t i = 0; i < nb; i++)
+    {
+        for (size_t j = 0; j < nb; j++) data_tag.add_chunk_tag(beo::Chunk_Tag({i * bs, j * bs}, {bs, bs}));
+    }
+
+    beo::Global_Data A("A"), B("B"), C("C"), D("D");
+
+    for (auto* data : {&A, &B, &C, &D}) EXAMPLE_CHECK(BEO_SUCCESS == data->allocate(world, data_tag, sizeof(double)));
+
+    for (auto& [key, chunk_tag] : data_tag.chunk_tags())
+    {
+        if (!A.is_local(key)) continue;
+
+        double* a = (double*) A.local_data(key);
+        double* b = (double*) B.local_data(key);
+        double* c = (double*) C.local_data(key);
+
+        for (size_t i = 0; i < bs; i++)
+        {
+            for (size_t j = 0; j < bs; j++)
+            {
+                a[i * bs + j] = a_element(key[0] + i, key[1] + j);
+                b[i * bs + j] = b_element(key[0] + i, key[1] + j);
+                c[i * bs + j] = 0.0;
+            }
+        }
+    }
+
+    A.sync();
+
+    //-----------------------------------------------------------------------------------------------------
+    //C[i,j] += A[i,k] * B[k,j] for each k, then D[i,j] = 2 * C[i,j]. The tasks on one C[i,j] are
+    //ordered by the graph, and the D task waits for the last of them
+    beo::Task_Graph graph(3);
+
+    auto gemm = [bs](std::vector<beo::Chunk*>& chunks)
+    {
+        const double* a = (const double*) chunks[0]->data();
+        const double* b = (const double*) chunks[1]->data();
+        double*       c = (double*) chunks[2]->data();
+
+        for (size_t i = 0; i < bs; i++)
+        {
+            for (size_t k = 0; k < bs; k++)
+            {
+                for (size_t j = 0; j < bs; j++) c[i * bs + j] += a[i * bs + k] * b[k * bs + j];
+            }
+        }
+
+        return BEO_SUCCESS;
+    };
+
+    auto twice = [bs](std::vector<beo::Chunk*>& chunks)
+    {
+        const double* c = (const double*) chunks[0]->data();
+        double*       d = (double*) chunks[1]->data();
+
+        for (size_t idx = 0; idx < bs * bs; idx++) d[idx] = 2.0 * c[idx];
+
+        return BEO_SUCCESS;
+    };
+
+    for (size_t i = 0; i < nb; i++)
+    {
+        for (size_t j = 0; j < nb; j++)
+        {
+            auto& c_ij = data_tag.get_chunk_tag({i * bs, j * bs});
+
+            if (!C.is_local(c_ij.offsets())) continue;
+
+            for (size_t k = 0; k < nb; k++)
+            {
+                graph.add({beo::read_access(A, data_tag.get_chunk_tag({i * bs, k * bs})),
+                           beo::read_access(B, data_tag.get_chunk_tag({k * bs, j * bs})),
+                           beo::update_access(C, c_ij)}, gemm);
+            }
+
+            graph.add({beo::read_access(C, c_ij), beo::write_access(D, c_ij)}, twice);
+        }
+    }
+
+    EXAMPLE_CHECK(BEO_SUCCESS == graph.run());
+
+    D.sync();
+
+    for (auto& [key, chunk_tag] : data_tag.chunk_tags())
+    {
+        if (!D.is_local(key)) continue;
+
+        const double* d = (const double*) D.local_data(key);
+
+        for (size_t i = 0; i < bs; i++)
+        {
+            for (size_t j = 0; j < bs; j++)
+            {
+                double sum = 0.0;
+                for (size_t k = 0; k < n; k++) sum += a_element(key[0] + i, k) * b_element(k, key[1] + j);
+
+                EXAMPLE_CHECK(d[i * bs + j] == 2.0 * sum);
+            }
+        }
+    }
+
+    //a failed task fails the run
+    graph.add({beo::read_access(A, data_tag.get_chunk_tag({0, 0}))}, [](std::vector<beo::Chunk*>&) {return BEO_FAIL;});
+
+    EXAMPLE_CHECK(BEO_FAIL == graph.run());
+
+    D.sync();
+
+    for (auto* data : {&A, &B, &C, &D}) EXAMPLE_CHECK(BEO_SUCCESS == data->free());
+}
@@ -0,0 +1,207 @@
+/*****************************************
+ * tensor_ops.cpp
+ *
+ * Example of the operations on whole
+ *   Global_Data: the vectorized BLAS-1
+ *   ops, fused lazy expressions, a
+ *   transpose between two tilings with a
+ *   beo::Permutation, and a matrix
+ *   product with a beo::Contraction.
+ *   Build and run with mkme_examples.sh
+*****************************************/
+#include "example.hpp"
+
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+//an n0 x n1 matrix in t0 x t1 chunks, with ragged ones at the edges
+static beo::Data_Tag make_matrix(const std::string& name,
+                                 const size_t n0, const size_t n1,
+                                 const size_t t0, const size_t t1)
+{
+    beo::Data_Tag data_tag(name);
+
+    for (size_t i = 0; i < n0; i += t0)
+    {
+        for (size_t j = 0; j < n1; j += t1)
+        {
+            data_tag.add_chunk_tag(beo::Chunk_Tag({i, j}, {std::min(t0, n0 - i), std::min(t1, n1 - j)}));
+        }
+    }
+
+    return data_tag;
+}
+
+//sets each local element (i, j) to func(i, j)
+template<typename F>
+static void fill_matrix(beo::Data_Tag& data_tag, beo::Global_Data& data, F&& func)
+{
+    for (auto& [key, chunk_tag] : data_tag.chunk_tags())
+    {
+        if (!data.is_local(key)) continue;
+
+        double* ptr = (double*) data.local_data(key);
+
+        for (size_t i = 0; i < chunk_tag.length(0); i++)
+        {
+            for (size_t j = 0; j < chunk_tag.length(1); j++) ptr[i * chunk_tag.length(1) + j] = func(key[0] + i, key[1] + j);
+        }
+    }
+
+    data.sync();
+}
+
+//checks each local element (i, j) is func(i, j)
+template<typename F>
+static void check_matrix(beo::Data_Tag& data_tag, beo::Global_Data& data, F&& func)
+{
+    for (auto& [key, chunk_tag] : data_tag.chunk_tags())
+    {
+        if (!data.is_local(key)) continue;
+
+        const double* ptr = (const double*) data.local_data(key);
+
+        for (size_t i = 0; i < chunk_tag.length(0); i++)
+        {
+            for (size_t j = 0; j < chunk_tag.length(1); j++)
+            {
+                EXAMPLE_CHECK(ptr[i * chunk_tag.length(1) + j] == func(key[0] + i, key[1] + j));
+            }
+        }
+    }
+}
+
+void example(beo::Enviroment& env)
+{
+    auto& world = env.comms().world();
+
+    //-----------------------------------------------------------------------------------------------------
+    //BLAS-1 ops on a vector in uneven chunks. The values are small integers, so the results are exact
+    const size_t n = 100003;
+
+    beo::Data_Tag vector_tag("vector");
+
+    for (size_t offset = 0; offset < n; offset += 9973) vector_tag.add_chunk_tag(beo::Chunk_Tag({offset}, {std::min<size_t>(9973, n - offset)}));
+
+    auto x_element = [](const size_t i) {return double(i % 17) - 8.0;};
+
+    beo::Global_Data x("x"), y("y"), z("z");
+
+    for (auto* data : {&x, &y, &z}) EXAMPLE_CHECK(BEO_SUCCESS == data->allocate(world, vector_tag, sizeof(double)));
+
+    for (auto& [key, chunk_tag] : vector_tag.chunk_tags())
+    {
+        if (!x.is_local(key)) continue;
+
+        double* ptr = (double*) x.local_data(key);
+
+        for (size_t i = 0; i < chunk_tag.length(0); i++) ptr[i] = x_element(key[0] + i);
+    }
+
+    x.sync();
+
+    //y = 2 * (3 + x / 2) = 6 + x
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::fill<double>(y, 3.0));
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::axpy<double>(y, 0.5, x));
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::scale<double>(y, 2.0));
+
+    double dot, norm, max;
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::dot<double>(y, x, dot));
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::norm2<double>(x, norm));
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::max_abs<double>(y, max));
+
+    double ref_dot = 0.0, ref_norm = 0.0;
+    for (size_t i = 0; i < n; i++)
+    {
+        ref_dot  += (6.0 + x_element(i)) * x_element(i);
+        ref_norm += x_element(i) * x_element(i);
+    }
+
+    EXAMPLE_CHECK(dot == ref_dot);
+    EXAMPLE_CHECK(fabs(norm - sqrt(ref_norm)) < 1.0e-9 * norm);
+    EXAMPLE_CHECK(14.0 == max);
+
+    //a fused expression, in one pass without temporaries: z = 2 * x + y - x * x / 4
+    auto X = beo::lazy<double>(x);
+    auto Y = beo::lazy<double>(y);
+
+    EXAMPLE_CHECK(BEO_SUCCESS == beo::evaluate(z, 2.0 * X + Y - X * X / 4.0));
+
+    for (auto& [key, chunk_tag] : vector_tag.chunk_tags())
+    {
+        if (!z.is_local(key)) continue;
+
+        const double* ptr = (const double*) z.local_data(key);
+
+        for (size_t i = 0; i < chunk_tag.length(0); i++)
+        {
+            const double xi = x_element(key[0] + i);
+
+            EXAMPLE_CHECK(ptr[i] == 2.0 * xi + (6.0 + xi) - xi * xi / 4.0);
+        }
+    }
+
+    z.sync();
+
+    for (auto* data : {&x, &y, &z}) EXAMPLE_CHECK(BEO_SUCCESS == data->free());
+
+    //-----------------------------------------------------------------------------------------------------
+    //Transpose a 70 x 45 matrix in 16 x 16 chunks into a 45 x 70 one in 13 x 40 chunks
+    auto element = [](const size_t i, const size_t j) {return 100.0 * i + j;};
+
+    beo::Data_Tag src_tag  = make_matrix("src", 70, 45, 16, 16);
+    beo::Data_Tag dest_tag = make_matrix("dest", 45, 70, 13, 40);
+
+    beo::Global_Data src("src"), dest("dest");
+    EXAMPLE_CHECK(BEO_SUCCESS == src.allocate(world, src_tag, sizeof(double)));
+    EXAMPLE_CHECK(BEO_SUCCESS == dest.allocate(world, dest_tag, sizeof(double)));
+
+    fill_matrix(src_tag, src, element);
+
+    beo::Permutation permutation("ji", "ij");
+    EXAMPLE_CHECK(BEO_SUCCESS == permutation.plan(dest_tag, dest, src_tag, src));
+    EXAMPLE_CHECK(BEO_SUCCESS == permutation.execute());
+
+    check_matrix(dest_tag, dest, [&](const size_t j, const size_t i) {return element(i, j);});
+
+    dest.sync();
+
+    EXAMPLE_CHECK(BEO_SUCCESS == src.free());
+    EXAMPLE_CHECK(BEO_SUCCESS == dest.free());
+
+    //-----------------------------------------------------------------------------------------------------
+    //C[i,j] += 0.5 * A[i,k] * B[k,j], with small integers so the result is exact
+    const size_t ni = 37, nj = 29, nk = 41, tile = 8;
+
+    auto a_element = [](const size_t i, const size_t k) {return double((3 * i + k) % 7) - 3.0;};
+    auto b_element = [](const size_t k, const size_t j) {return double((k + 2 * j) % 5) - 2.0;};
+
+    beo::Data_Tag a_tag = make_matrix("A", ni, nk, tile, tile);
+    beo::Data_Tag b_tag = make_matrix("B", nk, nj, tile, tile);
+    beo::Data_Tag c_tag = make_matrix("C", ni, nj, tile, tile);
+
+    beo::Global_Data A("A"), B("B"), C("C");
+    EXAMPLE_CHECK(BEO_SUCCESS == A.allocate(world, a_tag, sizeof(double)));
+    EXAMPLE_CHECK(BEO_SUCCESS == B.allocate(world, b_tag, sizeof(double)));
+    EXAMPLE_CHECK(BEO_SUCCESS == C.allocate(world, c_tag, sizeof(double)));
+
+    fill_matrix(a_tag, A, a_element);
+    fill_matrix(b_tag, B, b_element);
+    fill_matrix(c_tag, C, [](size_t, size_t) {return 0.0;});
+
+    beo::Contraction contraction("ij", "ik", "kj");
+    EXAMPLE_CHECK(BEO_SUCCESS == contraction.plan(c_tag, C, a_tag, A, b_tag, B));
+    EXAMPLE_CHECK(BEO_SUCCESS == contraction.execute<double>(0.5));
+
+    check_matrix(c_tag, C, [&](const size_t i, const size_t j)
+    {
+        double sum = 0.0;
+        for (size_t k = 0; k < nk; k++) sum += a_element(i, k) * b_element(k, j);
+        return 0.5 * sum;
+    });
+
+    C.sync();
+
+    for (auto* data : {&A, &B, &C}) EXAMPLE_CHECK(BEO_SUCCESS == data->free());
+}
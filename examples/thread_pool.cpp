@@ -0,0 +1,111 @@
+/*****************************************
+ * thread_pool.cpp
+ *
+ * Example of the enviroment's thread
+ *   pool, Request::then callbacks, and
+ *   parallel_for_each over the chunks of
+ *   a Data_Tag. Build and run with
+ *   mkme_examples.sh
+*****************************************/
+#include "example.hpp"
+
+#include <vector>
+#include <atomic>
+
+void example(beo::Enviroment& env)
+{
+    auto& world = env.comms().world();
+
+    const int task_id   = world.task_id();
+    const int num_tasks = world.num_tasks();
+
+    //-----------------------------------------------------------------------------------------------------
+    //Tasks on the pool see the pool, event loop, and counters of the task that owns it
+    auto registered = env.thread_pool().submit([&]()
+    {
+        const bool ok = (&beo::thread_pool() == &env.thread_pool())
+                     && (&beo::event_loop() == &env.event_loop())
+                     && (&beo::counters() == &env.counters());
+
+        return ok ? BEO_SUCCESS : BEO_FAIL;
+    });
+
+    EXAMPLE_CHECK(BEO_SUCCESS == registered.get());
+
+    //Many more tasks than threads, which the bounded pool runs inline once it is full
+    std::atomic<int> num_run{0};
+    std::vector<std::future<int>> futures;
+
+    for (int idx = 0; idx < 1000; idx++)
+    {
+        futures.push_back(env.thread_pool().submit([&]() {num_run++; return BEO_SUCCESS;}));
+    }
+
+    for (auto& future : futures) EXAMPLE_CHECK(BEO_SUCCESS == future.get());
+
+    EXAMPLE_CHECK(1000 == num_run);
+
+    //-----------------------------------------------------------------------------------------------------
+    //Callbacks on requests fire from the event loop, in this thread
+    const int right = (task_id + 1) % num_tasks;
+    const int left  = (task_id + num_tasks - 1) % num_tasks;
+
+    std::vector<double> out(1000, task_id), in(1000, -1.0);
+
+    bool has_arrived = false;
+
+    const size_t bytes = out.size() * sizeof(double);
+
+    //with one task, the send and recieve are the same copy
+    beo::Request recv = (1 == num_tasks)
+                      ? beo::async_send_recv(world, in.data(), out.data(), bytes, task_id, task_id, 1)
+                      : beo::async_send_recv(world, in.data(), nullptr, bytes, task_id, left, 1);
+
+    std::vector<beo::Request> sends;
+
+    if (num_tasks > 1) sends.push_back(beo::async_send_recv(world, nullptr, out.data(), bytes, right, task_id, 1));
+
+    recv.then([&](const int stat)
+    {
+        has_arrived = (BEO_SUCCESS == stat) && (in.front() == left) && (in.back() == left);
+    });
+
+    //the loop has the request now, and a request moved from is null, like a new one
+    EXAMPLE_CHECK(!recv.is_valid() && recv.is_complete());
+    EXAMPLE_CHECK(!beo::Request().is_valid() && BEO_SUCCESS == beo::Request().wait());
+
+    EXAMPLE_CHECK(BEO_SUCCESS == env.event_loop().run());
+    for (auto& send : sends) EXAMPLE_CHECK(BEO_SUCCESS == send.wait());
+    EXAMPLE_CHECK(has_arrived);
+
+    //-----------------------------------------------------------------------------------------------------
+    //parallel_for_each runs every chunk once, on the pool
+    beo::Data_Tag data_tag("chunks");
+
+    for (size_t offset = 0; offset < 60; offset++)
+    {
+        data_tag.add_chunk_tag(beo::Chunk_Tag({offset}, {1 + offset % 5}));
+    }
+
+    std::vector<std::atomic<int>> hits(60);
+    for (auto& hit : hits) hit = 0;
+
+    int stat = beo::parallel_for_each(data_tag, [&](beo::Chunk_Tag& chunk_tag)
+    {
+        hits[chunk_tag.offset(0)]++;
+        return BEO_SUCCESS;
+    });
+
+    EXAMPLE_CHECK(BEO_SUCCESS == stat);
+    for (auto& hit : hits) EXAMPLE_CHECK(1 == hit);
+
+    //a failed chunk fails the loop, but the rest still run
+    stat = beo::parallel_for_each(data_tag, [&](beo::Chunk_Tag& chunk_tag)
+    {
+        hits[chunk_tag.offset(0)]++;
+        return (7 == chunk_tag.offset(0)) ? BEO_FAIL : BEO_SUCCESS;
+    });
+
+    EXAMPLE_CHECK(BEO_FAIL == stat);
+    for (auto& hit : hits) EXAMPLE_CHECK(2 == hit);
+}
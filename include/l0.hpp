@@ -8,8 +8,8 @@
  *   in order to use level-0 beo
  *   entities
 *****************************************/
-#ifndef _BEO_INCLUDE_HPP_
-#define _BEO_INCLUDE_HPP_
+#ifndef _BEO_INCLUDE_L0_HPP_
+#define _BEO_INCLUDE_L0_HPP_
 
 #include "../src/L0/l0.hpp"
 
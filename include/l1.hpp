@@ -8,8 +8,8 @@
  *   in order to use level-1 beo
  *   entities
 *****************************************/
-#ifndef _BEO_INCLUDE_HPP_
-#define _BEO_INCLUDE_HPP_
+#ifndef _BEO_INCLUDE_L1_HPP_
+#define _BEO_INCLUDE_L1_HPP_
 
 #include "../src/L1/l1.hpp"
 
@@ -0,0 +1,195 @@
+/*****************************************
+ * collectives.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for the node-aware
+ *   (hierarchical) collectives, which
+ *   are overloads of the level-0
+ *   collectives on beo::Comms instead
+ *   of a single beo::Comm.
+ *
+ * These work in two levels. Data is
+ *   first combined (or spread) within
+ *   each node over comms.shared(), and
+ *   only the node leaders talk across
+ *   nodes over comms.nodes(). With n
+ *   tasks per node, this cuts the number
+ *   of inter-node messages by n.
+ *
+ * Roots are given as world task ids. A
+ *   root that is not its node's leader
+ *   trades data with the leader.
+ *
+ * Everything within a node goes over
+ *   comms.node_collectives(), a private
+ *   copy of comms.shared(), so none of
+ *   these messages can match the user's
+ *   own on comms.world() or
+ *   comms.shared().
+ *
+ * Included here:
+ *      barrier
+ *      broadcast
+ *      reduce
+ *      allreduce
+*****************************************/
+#ifndef _BEO_COLLECTIVES_HPP_
+#define _BEO_COLLECTIVES_HPP_
+
+#include "../L0/def.hpp"
+#include "../L0/datatype.hpp"
+#include "../L0/ops.hpp"
+#include "comms.hpp"
+
+namespace beo
+{
+
+int barrier(Comms& comms);
+
+int broadcast(Comms& comms,
+              void*       buf,
+              size_t      bytes,
+              int         root);
+
+template<typename T>
+int reduce(Comms& comms,
+           T*          buf,
+           size_t      count,
+           Op          op,
+           int         root);
+
+template<typename T>
+int allreduce(Comms& comms,
+              T*          buf,
+              size_t      count,
+              Op          op);
+
+/*****************************************
+ * barrier
+ *
+ * Node barrier, then a barrier between
+ *   the leaders, then a node barrier
+*****************************************/
+inline int barrier(Comms& comms)
+{
+    int stat = beo::barrier(comms.node_collectives());
+
+    if (comms.is_leader()) stat |= beo::barrier(comms.nodes());
+
+    stat |= beo::barrier(comms.node_collectives());
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+/*****************************************
+ * broadcast
+ *
+ * If the root is not its node's leader,
+ *   it first hands the data to the leader.
+ *   The leaders then broadcast across nodes,
+ *   and each leader broadcasts on its node
+*****************************************/
+inline int broadcast(Comms& comms,
+                     void*       buf,
+                     size_t      bytes,
+                     int         root)
+{
+    if (root >= comms.world().num_tasks())
+    {
+        printf("beo::broadcast Task %d input root(%d) is invalid\n", comms.world().task_id(), root);
+        exit(1);
+    }
+
+    const int root_node   = comms.node_of(root);
+    const int root_leader = comms.leader_of(root_node);
+
+    int stat = BEO_SUCCESS;
+
+    if (root != root_leader && comms.node_id() == root_node)
+    {
+        stat |= beo::send_recv(comms.node_collectives(), buf, buf, bytes, 0, comms.shared_id_of(root), 0);
+    }
+
+    if (comms.is_leader())
+    {
+        stat |= beo::broadcast(comms.nodes(), buf, bytes, root_node);
+    }
+
+    stat |= beo::broadcast(comms.node_collectives(), buf, bytes, 0);
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+/*****************************************
+ * reduce
+ *
+ * Reduce onto each node's leader, reduce
+ *   across the leaders onto the root's
+ *   leader, and then hand the result to the
+ *   root if it is not that leader.
+ *
+ * Only the root's buf holds the result.
+ *   Other tasks' buf may be overwritten
+ *   with partial results.
+*****************************************/
+template<typename T>
+inline int reduce(Comms& comms,
+                  T*          buf,
+                  size_t      count,
+                  Op          op,
+                  int         root)
+{
+    if (root >= comms.world().num_tasks())
+    {
+        printf("beo::reduce Task %d input root(%d) is invalid\n", comms.world().task_id(), root);
+        exit(1);
+    }
+
+    const int root_node   = comms.node_of(root);
+    const int root_leader = comms.leader_of(root_node);
+
+    int stat = beo::reduce(comms.node_collectives(), buf, count, op, 0);
+
+    if (comms.is_leader())
+    {
+        stat |= beo::reduce(comms.nodes(), buf, count, op, root_node);
+    }
+
+    if (root != root_leader && comms.node_id() == root_node)
+    {
+        stat |= beo::send_recv(comms.node_collectives(), buf, buf, count * sizeof(T), comms.shared_id_of(root), 0, 0);
+    }
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+/*****************************************
+ * allreduce
+ *
+ * Reduce onto each node's leader, allreduce
+ *   across the leaders, then each leader
+ *   broadcasts on its node
+*****************************************/
+template<typename T>
+inline int allreduce(Comms& comms,
+                     T*          buf,
+                     size_t      count,
+                     Op          op)
+{
+    int stat = beo::reduce(comms.node_collectives(), buf, count, op, 0);
+
+    if (comms.is_leader())
+    {
+        stat |= beo::allreduce(comms.nodes(), buf, count, op);
+    }
+
+    stat |= beo::broadcast(comms.node_collectives(), buf, count * sizeof(T), 0);
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+} //end namespace beo
+
+#endif
@@ -13,6 +13,14 @@
  * Note that this must be initialized 
  *   after MPI_Init
  *
+ * Besides the comms, this keeps which
+ *   node every world task is on, and 
+ *   the world task id of each node's
+ *   leader (task 0 of its shared comm),
+ *   and a private copy of the shared comm,
+ *   which the node-aware collectives in
+ *   collectives.hpp rely on
+ *
 *****************************************/
 #ifndef _BEO_COMMS_HPP_
 #define _BEO_COMMS_HPP_
@@ -23,9 +31,11 @@
 
 #include <utility>
 #include <string>
+#include <vector>
 
 #include "../L0/info.hpp"
 #include "../L0/comm.hpp"
+#include "../L0/ops.hpp"
 
 namespace beo
 {
@@ -44,6 +54,15 @@ class Comms
         //The nodes comm., world comm but only the master task on each node
         beo::Comm nodes_;
 
+        //A copy of the shared comm., used only by the node-aware collectives
+        beo::Comm node_collectives_;
+
+        //node of each world task
+        std::vector<int> node_of_;
+
+        //world task id of the leader of each node
+        std::vector<int> leaders_;
+
     public:
 
         Comms();
@@ -52,6 +71,8 @@ class Comms
 
         void init();
 
+        void init(const Info& info);
+
         const Comm& world() const {return world_;}
 
         Comm& world() {return world_;}
@@ -60,6 +81,27 @@ class Comms
 
         Comm& shared() {return shared_;}
 
+        //Only valid on node leaders, where shared().is_master()
+        const Comm& nodes() const {return nodes_;}
+
+        Comm& nodes() {return nodes_;}
+
+        //For the node-aware collectives, so their messages never match the user's
+        Comm& node_collectives() {return node_collectives_;}
+
+        bool is_leader() const {return shared_.is_master();}
+
+        int num_nodes() const {return (int) leaders_.size();}
+
+        int node_id() const {return node_of_[world_.task_id()];}
+
+        int node_of(const int world_id) const {return node_of_[world_id];}
+
+        int leader_of(const int node) const {return leaders_[node];}
+
+        //task id in its node's shared comm. of a world task
+        int shared_id_of(const int world_id) const;
+
         void finalize();
 };
 
@@ -69,18 +111,7 @@ class Comms
 *****************************************/
 inline Comms::Comms(const Info& info)
 {
-
-    #if defined _BEO_MPI_
-    world_ = MPI_COMM_WORLD;
-
-    shared_ = std::move(world_.split_type(MPI_COMM_TYPE_SHARED,
-                                          world_.task_id(),
-                                          info));
-    #else
-
-    shared_ = world_;
-
-    #endif
+    init(info);
 }
 
 inline Comms::Comms()
@@ -101,19 +132,98 @@ inline Comms::Comms()
  * initialization
 *****************************************/
 inline void Comms::init()
+{
+    Info info;
+
+    init(info);
+}
+
+inline void Comms::init(const Info& info)
 {
     #if defined _BEO_MPI_
     world_ = MPI_COMM_WORLD;
 
-    shared_ = std::move(world_.split_type(MPI_COMM_TYPE_SHARED,
-                                          world_.task_id(),
-                                          MPI_INFO_NULL));
+    shared_ = world_.split_type(MPI_COMM_TYPE_SHARED,
+                                world_.task_id(),
+                                info);
+
+    nodes_ = world_.split(shared_.is_master() ? 0 : MPI_UNDEFINED,
+                          world_.task_id());
+
+    //node leaders know their node id, and tell the rest of their node
+    int node = nodes_.task_id();
+
+    beo::broadcast(shared_, &node, sizeof(int), 0);
+
+    node_of_.resize(world_.num_tasks());
+
+    beo::allgather(world_, node_of_.data(), &node, sizeof(int));
+
+    int num_nodes = 0;
+    for (const auto elm : node_of_) if (elm + 1 > num_nodes) num_nodes = elm + 1;
+
+    leaders_.assign(num_nodes, -1);
+    for (int task = world_.num_tasks() - 1; task >= 0; task--) leaders_[node_of_[task]] = task;
+
+    #elif defined _BEO_THREADS_ || defined _BEO_SHM_
+
+    (void) info;
+
+    //all the tasks are on one node
+    #if defined _BEO_THREADS_
+
+    auto& current = Thread_Group::current();
+
+    world_ = Comm(current.group, current.task_id);
+
+    #else
+
+    world_ = Comm(Shm_Transport::world());
+
+    #endif
+
+    shared_ = world_;
+
+    nodes_ = world_.split(shared_.is_master() ? 0 : -1,
+                          world_.task_id());
+
+    node_of_.assign(world_.num_tasks(), 0);
+
+    leaders_.assign(1, 0);
+
     #else
 
+    (void) info;
+
     shared_ = world_;
 
+    nodes_ = world_;
+
+    node_of_.assign(1, 0);
+
+    leaders_.assign(1, 0);
+
     #endif
-    
+
+    node_collectives_ = shared_;
+}
+
+/*****************************************
+ * shared_id_of
+ *
+ * The shared comm. orders a node's tasks
+ *   by world task id
+*****************************************/
+inline int Comms::shared_id_of(const int world_id) const
+{
+    int shared_id = 0;
+
+    for (int task = 0; task < world_id; task++)
+    {
+        if (node_of_[task] == node_of_[world_id]) shared_id++;
+    }
+
+    return shared_id;
 }
 
 /*****************************************
@@ -123,8 +233,23 @@ inline void Comms::init()
 *****************************************/
 inline void Comms::finalize()
 {
+    #if defined _BEO_SHM_
+
+    //nobody detaches until everyone is done
+    beo::barrier(world_);
+
+    #endif
+
+    node_collectives_.finalize();
+    nodes_.finalize();
     shared_.finalize();
     world_.finalize();
+
+    #if defined _BEO_SHM_
+
+    Shm_Transport::finalize_world();
+
+    #endif
 }
 
 }  //end namespace beo
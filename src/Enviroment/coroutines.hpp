@@ -0,0 +1,387 @@
+/*****************************************
+ * coroutines.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Task and
+ *   beo::Scheduler, which let pipelined
+ *   work be written as C++20 coroutines
+ *   that co_await beo::Requests, e.g.,
+ *
+ *     beo::Task pipeline(beo::Comm& comm, ...)
+ *     {
+ *         co_await file.async_read_at(off, buf, bytes);
+ *         compute(buf);
+ *         co_await beo::async_send_recv(comm, ...);
+ *         co_return BEO_SUCCESS;
+ *     }
+ *
+ *     env.scheduler().spawn(pipeline(comm, ...));
+ *     env.scheduler().run();
+ *
+ * A Task starts suspended. The scheduler
+ *   resumes it, and whenever it awaits a
+ *   Request (or a Chunk_Request) that is
+ *   not complete, sets it aside and runs
+ *   the other tasks, polling the requests
+ *   with is_complete. co_await gives the
+ *   status from wait(). Tasks can also
+ *   co_await other Tasks, and co_await
+ *   beo::yield() to let the others run.
+ *
+ * Anything that returns a Request can be
+ *   awaited: the async send/recv calls,
+ *   the Shared_File async_* calls, and
+ *   the async collectives, as can a
+ *   Termination_Detector.
+ *
+ * beo::scheduler() (or
+ *   Enviroment::scheduler) is the calling
+ *   thread's scheduler, so each task has
+ *   its own, and is not thread safe.
+ *
+ * This needs C++20 coroutines, and is
+ *   empty otherwise (__cpp_impl_coroutine).
+ *   _BEO_HAS_COROUTINES_ is defined when
+ *   they are available
+*****************************************/
+#ifndef _BEO_COROUTINES_HPP_
+#define _BEO_COROUTINES_HPP_
+
+#if defined __cpp_impl_coroutine && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <utility>
+#include <exception>
+#include <functional>
+
+#include "../L0/def.hpp"
+#include "../L0/request.hpp"
+#include "../L0/event_loop.hpp"
+#include "../L0/thread_pool.hpp"
+#include "../L0/chunk_transfer.hpp"
+#include "../L0/termination_detector.hpp"
+
+#ifndef _BEO_HAS_COROUTINES_
+#define _BEO_HAS_COROUTINES_
+#endif
+
+namespace beo
+{
+
+class Scheduler;
+
+/*****************************************
+ * Task
+ *
+ * A coroutine that co_returns an int
+ *   status
+*****************************************/
+class Task
+{
+    public:
+
+        struct promise_type;
+
+        using handle_t = std::coroutine_handle<promise_type>;
+
+        //Resumes whoever awaited the task, if anyone
+        struct Final_Awaiter
+        {
+            bool await_ready() noexcept {return false;}
+
+            std::coroutine_handle<> await_suspend(handle_t handle) noexcept
+            {
+                auto next = handle.promise().continuation;
+                return (nullptr != next) ? next : std::noop_coroutine();
+            }
+
+            void await_resume() noexcept {}
+        };
+
+        struct promise_type
+        {
+            int                     stat{BEO_SUCCESS};
+
+            Scheduler*              scheduler{nullptr};
+
+            std::coroutine_handle<> continuation{nullptr};
+
+            Task get_return_object() {return Task(handle_t::from_promise(*this));}
+
+            std::suspend_always initial_suspend() noexcept {return {};}
+
+            Final_Awaiter final_suspend() noexcept {return {};}
+
+            void return_value(const int s) {stat = s;}
+
+            void unhandled_exception() {std::terminate();}
+        };
+
+    protected:
+
+        handle_t handle_{nullptr};
+
+    public:
+
+        Task() {}
+
+        explicit Task(handle_t handle) : handle_(handle) {}
+
+        Task(const Task& other) = delete;
+
+        Task(Task&& other) : handle_(std::exchange(other.handle_, nullptr)) {}
+
+        Task& operator=(const Task& other) = delete;
+
+        Task& operator=(Task&& other)
+        {
+            if (&other == this) return *this;
+            if (nullptr != handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+            return *this;
+        }
+
+       ~Task() {if (nullptr != handle_) handle_.destroy();}
+
+        handle_t handle() const {return handle_;}
+
+        bool is_done() const {return nullptr == handle_ || handle_.done();}
+
+        int stat() const {return (nullptr != handle_) ? handle_.promise().stat : BEO_SUCCESS;}
+
+        //co_await of a Task runs it on the awaiting task's scheduler
+        auto operator co_await() &&
+        {
+            struct Awaiter
+            {
+                handle_t child;
+
+                bool await_ready() {return nullptr == child || child.done();}
+
+                std::coroutine_handle<> await_suspend(handle_t parent)
+                {
+                    child.promise().scheduler    = parent.promise().scheduler;
+                    child.promise().continuation = parent;
+                    return child;
+                }
+
+                int await_resume() {return (nullptr != child) ? child.promise().stat : BEO_SUCCESS;}
+            };
+
+            return Awaiter{handle_};
+        }
+};
+
+/*****************************************
+ * Scheduler
+*****************************************/
+class Scheduler
+{
+    public:
+
+        using handle_t  = std::coroutine_handle<>;
+
+        using is_done_t = std::function<bool()>;
+
+    protected:
+
+        std::deque<handle_t>                        ready_;
+
+        std::vector<std::pair<is_done_t, handle_t>> waiting_;
+
+        std::vector<Task>                           tasks_;
+
+        void idle();
+
+    public:
+
+        Scheduler() {}
+
+        Scheduler(const Scheduler& other) = delete;
+
+        Scheduler& operator=(const Scheduler& other) = delete;
+
+        //Takes the task, to be started by run or poll
+        void spawn(Task&& task);
+
+        //Resume handle on the next poll
+        void resume_later(handle_t handle) {ready_.push_back(handle);}
+
+        //Resume handle once is_done() is true
+        void resume_when(is_done_t&& is_done, handle_t handle) {waiting_.emplace_back(std::move(is_done), handle);}
+
+        //Runs what can be run, returns true if anything was
+        bool poll();
+
+        bool is_empty() const {return ready_.empty() && waiting_.empty();}
+
+        size_t num_tasks() const {return tasks_.size();}
+
+        //Runs every spawned task to completion. BEO_FAIL if any of them failed
+        int run();
+};
+
+/*****************************************
+ * spawn
+*****************************************/
+inline void Scheduler::spawn(Task&& task)
+{
+    if (task.is_done()) return;
+
+    task.handle().promise().scheduler = this;
+
+    ready_.push_back(task.handle());
+
+    tasks_.push_back(std::move(task));
+}
+
+/*****************************************
+ * poll
+ *
+ * Readies the tasks whose requests are
+ *   complete, then resumes the ready ones
+*****************************************/
+inline bool Scheduler::poll()
+{
+    for (size_t idx = 0; idx < waiting_.size();)
+    {
+        if (waiting_[idx].first())
+        {
+            ready_.push_back(waiting_[idx].second);
+            waiting_[idx] = std::move(waiting_.back());
+            waiting_.pop_back();
+        }
+
+        else
+        {
+            idx++;
+        }
+    }
+
+    if (ready_.empty()) return false;
+
+    //only what is ready now, so yield() lets the others in
+    for (size_t num = ready_.size(); num > 0; num--)
+    {
+        auto handle = ready_.front();
+        ready_.pop_front();
+        handle.resume();
+    }
+
+    return true;
+}
+
+/*****************************************
+ * idle
+ *
+ * Nothing is ready. Fires any Request::then
+ *   callbacks that are due, and outside of
+ *   MPI the requests may be waiting on the
+ *   thread pool, so help it as Request::wait
+ *   does
+*****************************************/
+inline void Scheduler::idle()
+{
+    if (beo::event_loop().poll() > 0) return;
+
+    #if defined _BEO_MPI_
+    std::this_thread::yield();
+    #else
+    if (!beo::thread_pool().run_one()) std::this_thread::yield();
+    #endif
+}
+
+/*****************************************
+ * run
+*****************************************/
+inline int Scheduler::run()
+{
+    while (!is_empty())
+    {
+        if (!poll()) idle();
+    }
+
+    int stat = BEO_SUCCESS;
+
+    for (const auto& task : tasks_)
+    {
+        if (!task.is_done() || BEO_SUCCESS != task.stat()) stat = BEO_FAIL;
+    }
+
+    tasks_.clear();
+
+    return stat;
+}
+
+/*****************************************
+ * Request_Awaiter
+ *
+ * co_await of a Request or Chunk_Request,
+ *   held by value for temporaries and by
+ *   reference otherwise
+*****************************************/
+template<typename R>
+struct Request_Awaiter
+{
+    R request;
+
+    bool await_ready() {return request.is_complete();}
+
+    void await_suspend(Task::handle_t handle)
+    {
+        handle.promise().scheduler->resume_when([this]() {return request.is_complete();}, handle);
+    }
+
+    int await_resume() {return request.wait();}
+};
+
+inline Request_Awaiter<Request> operator co_await(Request&& request) {return {std::move(request)};}
+
+inline Request_Awaiter<Request&> operator co_await(Request& request) {return {request};}
+
+inline Request_Awaiter<Chunk_Request> operator co_await(Chunk_Request&& request) {return {std::move(request)};}
+
+inline Request_Awaiter<Chunk_Request&> operator co_await(Chunk_Request& request) {return {request};}
+
+//resumes once every task is done, so only await it once this one is
+inline Request_Awaiter<Termination_Detector&> operator co_await(Termination_Detector& detector) {return {detector};}
+
+/*****************************************
+ * yield
+ *
+ * co_await beo::yield() lets the other
+ *   ready tasks run
+*****************************************/
+struct Yield_Awaiter
+{
+    bool await_ready() {return false;}
+
+    void await_suspend(Task::handle_t handle) {handle.promise().scheduler->resume_later(handle);}
+
+    void await_resume() {}
+};
+
+inline Yield_Awaiter yield() {return {};}
+
+/*****************************************
+ * scheduler
+ *
+ * The calling thread's scheduler
+*****************************************/
+inline Scheduler& scheduler()
+{
+    static thread_local Scheduler scheduler;
+
+    return scheduler;
+}
+
+} //end namespace beo
+
+#endif
+
+#endif
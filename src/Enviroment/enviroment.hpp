@@ -14,6 +14,42 @@
  * Similarly, finalize() should be called 
  *   BEFORE MPI is finalized 
  *
+ * The enviroment owns the thread pool that
+ *   the non-MPI asynchronous operations 
+ *   are run on, and registers it as the
+ *   beo::thread_pool() on construction. 
+ *   Its size defaults to BEO_NUM_THREADS,
+ *   or the hardware concurrency. With
+ *   _BEO_THREADS_ the pool's workers get
+ *   the same registrations as the task
+ *   that owns the enviroment
+ *
+ * It also owns the optional progress 
+ *   engine, which is off until started 
+ *   with progress().start(...)
+ *
+ * It owns the event loop that runs the
+ *   Request::then callbacks, registered
+ *   as beo::event_loop(). finalize runs
+ *   whatever callbacks are left
+ *
+ * With C++20, scheduler() is the
+ *   beo::Scheduler that runs coroutine
+ *   Tasks (see coroutines.hpp). The
+ *   Enviroment's layout does not depend
+ *   on the language standard
+ *
+ * It owns the per-task performance 
+ *   counters too, and registers them as
+ *   beo::counters(). finalize(stat, message)
+ *   prints their min/avg/max over the 
+ *   tasks (see report.hpp)
+ *
+ * When built with _BEO_TRACE_, it starts 
+ *   the trace clock on construction, and
+ *   writes the trace in finalize (see
+ *   tracing.hpp)
+ *
  * Functions contained here:
  *	finalize
  * 
@@ -26,12 +62,19 @@
 
 #include "../L0/l0.hpp"
 #include "comms.hpp"
+#include "collectives.hpp"
+#include "progress.hpp"
+#include "coroutines.hpp"
+#include "tracing.hpp"
+#include "report.hpp"
 #include "data_tag_manager.hpp"
 #include "files.hpp"
 
 namespace beo
 {
 
+class Scheduler;
+
 class Enviroment
 {
     public:
@@ -44,8 +87,26 @@ class Enviroment
 
         Files            files_;
 
+        Thread_Pool      thread_pool_;
+
+        Progress_Engine  progress_;
+
+        Event_Loop       event_loop_;
+
+        Counters         counters_;
+
+
+        void register_workers();
+
     public:
 
+        Enviroment();
+
+        Enviroment(const size_t num_threads, 
+                   const size_t max_queue_depth);
+
+       ~Enviroment();
+
         void finalize();
 
         void finalize(const int stat, const std::string& message); 
@@ -62,8 +123,126 @@ class Enviroment
 
         Data_Tag_Manager& data_tag_manager() {return data_tag_manager_;}
 
+        const Thread_Pool& thread_pool() const {return thread_pool_;}
+
+        Thread_Pool& thread_pool() {return thread_pool_;}
+
+        const Progress_Engine& progress() const {return progress_;}
+
+        Progress_Engine& progress() {return progress_;}
+
+        Event_Loop& event_loop() {return event_loop_;}
+
+        const Counters& counters() const {return counters_;}
+
+        Counters& counters() {return counters_;}
+
+        //Only defined with C++20 coroutines
+        Scheduler& scheduler();
+
 };
 
+/*****************************************
+ * Constructors
+ *
+ * The thread pool is started lazily on 
+ *   first use, unless a size is given
+*****************************************/
+inline Enviroment::Enviroment()
+{
+    register_workers();
+
+    beo::set_thread_pool(&thread_pool_);
+
+    beo::set_event_loop(&event_loop_);
+
+    counters_.init(comms_.world().num_tasks());
+
+    beo::set_counters(&counters_);
+
+    #if defined _BEO_TRACE_
+    beo::start_trace(comms_.world());
+    #endif
+}
+
+inline Enviroment::Enviroment(const size_t num_threads, 
+                              const size_t max_queue_depth)
+{
+    register_workers();
+
+    thread_pool_.init(num_threads, max_queue_depth);
+
+    beo::set_thread_pool(&thread_pool_);
+
+    beo::set_event_loop(&event_loop_);
+
+    counters_.init(comms_.world().num_tasks());
+
+    beo::set_counters(&counters_);
+
+    #if defined _BEO_TRACE_
+    beo::start_trace(comms_.world());
+    #endif
+}
+
+#if defined _BEO_HAS_COROUTINES_
+
+/*****************************************
+ * scheduler
+ *
+ * The task's scheduler, beo::scheduler()
+*****************************************/
+inline Scheduler& Enviroment::scheduler()
+{
+    return beo::scheduler();
+}
+
+#endif
+
+/*****************************************
+ * register_workers
+ *
+ * With _BEO_THREADS_ the registrations
+ *   are per thread, so the pool's workers
+ *   would otherwise use the defaults, not
+ *   this task's pool, event loop, and
+ *   counters
+*****************************************/
+inline void Enviroment::register_workers()
+{
+    #if defined _BEO_THREADS_
+
+    const int task_id = comms_.world().task_id();
+
+    thread_pool_.set_worker_init([this, task_id]()
+    {
+        beo::set_thread_pool(&thread_pool_);
+
+        beo::set_event_loop(&event_loop_);
+
+        beo::set_counters(&counters_);
+
+        Trace::rank() = task_id;
+    });
+
+    #endif
+}
+
+inline Enviroment::~Enviroment()
+{
+    //the workers and the progress thread may use the event loop and
+    //  counters, which go first
+    progress_.stop();
+
+    thread_pool_.finalize();
+
+    if (&beo::thread_pool() == &thread_pool_) beo::set_thread_pool(nullptr);
+
+    if (&beo::event_loop() == &event_loop_) beo::set_event_loop(nullptr);
+
+    if (&beo::counters() == &counters_) beo::set_counters(nullptr);
+}
+
 /*****************************************
  * finalize
  *
@@ -73,15 +252,38 @@ class Enviroment
 *****************************************/
 inline void Enviroment::finalize()
 {
+    event_loop().run();
+
+    progress().stop();
+
+    thread_pool().finalize();
+
+    if (&beo::thread_pool() == &thread_pool_) beo::set_thread_pool(nullptr);
+
+    if (&beo::event_loop() == &event_loop_) beo::set_event_loop(nullptr);
+
+    if (&beo::counters() == &counters_) beo::set_counters(nullptr);
+
+    #if defined _BEO_TRACE_
+    beo::write_trace(comms().world(), beo::trace_file_name());
+    #endif
+
     files().finalize();
 
+    #if defined _BEO_MPI_
+    beo::free_subarray_types();
+    #endif
+
     comms().finalize();
 }
 
 inline void Enviroment::finalize(const int stat, 
                           const std::string& message)
 {
-    beo::barrier(comms().world());
+    //keep firing callbacks, which the other tasks may be waiting on
+    beo::fuzzy_barrier(comms().world(), [&]() {return event_loop().poll() > 0;});
+
+    beo::report_counters(comms().world(), counters());
  
     if (comms().world().is_master())
     {
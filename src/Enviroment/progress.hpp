@@ -0,0 +1,381 @@
+/*****************************************
+ * progress.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Progress_Engine,
+ *   which drives outstanding asynchronous
+ *   operations while the user computes.
+ *
+ * Most MPI libraries only move a large
+ *   (rendezvous) message along while some
+ *   MPI call is being made on the task.
+ *   The engine makes those calls for you,
+ *   either:
+ *      Mode::thread  : on a dedicated thread.
+ *                      This needs MPI_Init_thread
+ *                      with MPI_THREAD_MULTIPLE,
+ *                      and falls back to polling
+ *                      otherwise
+ *      Mode::polling : whenever poll() is
+ *                      called, at most once per
+ *                      interval, so poll() is
+ *                      cheap to sprinkle through
+ *                      compute loops
+ *
+ * Each round of progress tests the
+ *   requests handed to the event loop
+ *   (with Request::then) with
+ *   MPI_Testsome, which completes them.
+ *   num_completed() counts these.
+ *   Requests the user holds are only
+ *   helped by an MPI_Iprobe on the
+ *   engine's own comm, which is just a
+ *   nudge: whether it moves messages on
+ *   other comms depends on the MPI
+ *   library. To have the engine drive a
+ *   request, hand it to the event loop.
+ *
+ * Hooks (e.g., Aggregator::progress) can
+ *   be added, and are run on every poll.
+ *
+ * To measure the overlap achieved, wrap
+ *   compute in begin_compute()/end_compute()
+ *   and complete requests with wait().
+ *   overlap() is then the fraction of that
+ *   time spent computing rather than
+ *   blocked on communication (1.0 is
+ *   perfect overlap).
+ *
+ * The engine is owned by the beo::Enviroment,
+ *   and is stopped in its finalize
+*****************************************/
+#ifndef _BEO_PROGRESS_HPP_
+#define _BEO_PROGRESS_HPP_
+
+#if defined _BEO_MPI_
+#include <mpi.h>
+#endif
+
+#include <stdio.h>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <functional>
+
+#include "../L0/def.hpp"
+#include "../L0/comm.hpp"
+#include "../L0/request.hpp"
+#include "../L0/event_loop.hpp"
+
+namespace beo
+{
+
+class Progress_Engine
+{
+    public:
+
+        enum class Mode {off, thread, polling};
+
+        using clock_t  = std::chrono::steady_clock;
+
+        using hook_t   = std::function<void()>;
+
+        using mutex_t  = std::recursive_mutex;
+
+    protected:
+
+        Comm                   comm_;
+
+        Mode                   mode_{Mode::off};
+
+        double                 interval_{50.0e-6};
+
+        std::thread            thread_;
+
+        std::atomic<bool>      running_{false};
+
+        //the loop whose requests are tested, that of the task that started the engine
+        Event_Loop*            event_loop_{nullptr};
+
+        //clock_t nanoseconds, atomic since any thread may poll
+        std::atomic<int64_t>   last_poll_{0};
+
+        mutex_t                mutex_;
+
+        std::map<int, hook_t>  hooks_;
+
+        int                    next_hook_{0};
+
+        //overlap measurement, in clock_t nanoseconds
+        std::atomic<int64_t>   compute_start_{0};
+
+        std::atomic<double>    compute_seconds_{0.0};
+
+        std::atomic<double>    wait_seconds_{0.0};
+
+        std::atomic<size_t>    num_polls_{0};
+
+        std::atomic<size_t>    num_completed_{0};
+
+        void progress();
+
+        void thread_loop();
+
+        static void add(std::atomic<double>& total, const double seconds);
+
+        static int64_t now_ns();
+
+    public:
+
+        Progress_Engine() {}
+
+       ~Progress_Engine() {stop();}
+
+        Progress_Engine(const Progress_Engine& other) = delete;
+
+        Progress_Engine& operator=(const Progress_Engine& other) = delete;
+
+        int start(Comm& comm, const Mode mode, const double interval = 50.0e-6);
+
+        void stop();
+
+        Mode mode() const {return mode_;}
+
+        bool is_running() const {return running_;}
+
+        int poll();
+
+        int add_hook(hook_t&& hook);
+
+        void remove_hook(const int id);
+
+        //overlap measurement
+        void begin_compute();
+
+        void end_compute();
+
+        int wait(Request& request);
+
+        double compute_seconds() const {return compute_seconds_;}
+
+        double wait_seconds() const {return wait_seconds_;}
+
+        double overlap() const;
+
+        size_t num_polls() const {return num_polls_;}
+
+        //requests of the event loop the engine completed (only under MPI)
+        size_t num_completed() const {return num_completed_;}
+
+        void reset_overlap();
+};
+
+/*****************************************
+ * start
+ *
+ * Starts the engine on a duplicate of comm.
+ *   Returns BEO_FAIL if it is already running
+*****************************************/
+inline int Progress_Engine::start(Comm& comm, const Mode mode, const double interval)
+{
+    if (is_running()) return BEO_FAIL;
+
+    comm_     = comm;
+    interval_ = interval;
+    mode_     = mode;
+
+    #if defined _BEO_MPI_
+
+    if (Mode::thread == mode_)
+    {
+        int provided;
+        MPI_Query_thread(&provided);
+
+        if (MPI_THREAD_MULTIPLE != provided)
+        {
+            if (comm_.is_master())
+            {
+                printf("beo::Progress_Engine::start MPI_THREAD_MULTIPLE is not available, using polling\n");
+            }
+            mode_ = Mode::polling;
+        }
+    }
+
+    #endif
+
+    event_loop_ = &beo::event_loop();
+
+    last_poll_ = now_ns();
+
+    running_ = (Mode::off != mode_);
+
+    if (Mode::thread == mode_) thread_ = std::thread(&Progress_Engine::thread_loop, this);
+
+    return BEO_SUCCESS;
+}
+
+/*****************************************
+ * stop
+*****************************************/
+inline void Progress_Engine::stop()
+{
+    if (!is_running()) return;
+
+    running_ = false;
+
+    if (thread_.joinable()) thread_.join();
+
+    mode_ = Mode::off;
+
+    event_loop_ = nullptr;
+
+    comm_.finalize();
+}
+
+/*****************************************
+ * progress
+ *
+ * One round of progress: test the event
+ *   loop's requests, poke the MPI progress
+ *   engine, then run the hooks
+*****************************************/
+inline void Progress_Engine::progress()
+{
+    #if defined _BEO_MPI_
+
+    if (nullptr != event_loop_) num_completed_ += event_loop_->test();
+
+    int flag;
+    MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, comm_.comm(), &flag, MPI_STATUS_IGNORE);
+
+    #endif
+
+    std::lock_guard<mutex_t> g(mutex_);
+
+    for (auto& [id, hook] : hooks_) hook();
+
+    num_polls_++;
+}
+
+/*****************************************
+ * thread_loop
+*****************************************/
+inline void Progress_Engine::thread_loop()
+{
+    const auto interval = std::chrono::duration<double>(interval_);
+
+    while (running_)
+    {
+        progress();
+
+        if (interval_ > 0.0) std::this_thread::sleep_for(interval);
+        else                 std::this_thread::yield();
+    }
+}
+
+/*****************************************
+ * poll
+ *
+ * In polling mode, makes progress if at
+ *   least interval seconds have passed since
+ *   the last poll. Does nothing otherwise.
+ *   If several threads poll at once, only
+ *   one of them makes progress
+*****************************************/
+inline int Progress_Engine::poll()
+{
+    if (Mode::polling != mode_) return BEO_SUCCESS;
+
+    const int64_t now  = now_ns();
+
+    int64_t       last = last_poll_;
+
+    if ((now - last) * 1.0e-9 < interval_) return BEO_SUCCESS;
+
+    if (!last_poll_.compare_exchange_strong(last, now)) return BEO_SUCCESS;
+
+    progress();
+
+    return BEO_SUCCESS;
+}
+
+/*****************************************
+ * hooks
+ *
+ * add_hook returns an id to remove it by
+*****************************************/
+inline int Progress_Engine::add_hook(hook_t&& hook)
+{
+    std::lock_guard<mutex_t> g(mutex_);
+
+    hooks_.emplace(next_hook_, std::move(hook));
+
+    return next_hook_++;
+}
+
+inline void Progress_Engine::remove_hook(const int id)
+{
+    std::lock_guard<mutex_t> g(mutex_);
+
+    hooks_.erase(id);
+}
+
+/*****************************************
+ * overlap measurement
+*****************************************/
+inline void Progress_Engine::add(std::atomic<double>& total, const double seconds)
+{
+    double old = total;
+    while (!total.compare_exchange_weak(old, old + seconds)) {}
+}
+
+inline int64_t Progress_Engine::now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now().time_since_epoch()).count();
+}
+
+inline void Progress_Engine::begin_compute()
+{
+    compute_start_ = now_ns();
+}
+
+inline void Progress_Engine::end_compute()
+{
+    add(compute_seconds_, (now_ns() - compute_start_) * 1.0e-9);
+}
+
+//waits on the request, counting the time spent blocked
+inline int Progress_Engine::wait(Request& request)
+{
+    const auto start = clock_t::now();
+
+    int stat = request.wait();
+
+    add(wait_seconds_, std::chrono::duration<double>(clock_t::now() - start).count());
+
+    return stat;
+}
+
+//fraction of measured time spent computing, rather than waiting
+inline double Progress_Engine::overlap() const
+{
+    const double total = compute_seconds_ + wait_seconds_;
+
+    return (total > 0.0) ? compute_seconds_ / total : 1.0;
+}
+
+inline void Progress_Engine::reset_overlap()
+{
+    compute_seconds_ = 0.0;
+    wait_seconds_    = 0.0;
+    num_polls_       = 0;
+    num_completed_   = 0;
+}
+
+} //end namespace beo
+
+#endif
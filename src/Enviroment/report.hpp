@@ -0,0 +1,140 @@
+/*****************************************
+ * report.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for the summary of the
+ *   beo::Counters (see L0/counters.hpp)
+ *   across tasks.
+ *
+ * report_counters reduces each counter
+ *   to its min, average, and max over the
+ *   tasks, so that imbalance shows up as
+ *   a gap between the min and the max,
+ *   and lists the task pairs that sent
+ *   the most bytes, so that hotspots
+ *   show up by name.
+ *
+ * The beo::Enviroment prints the report
+ *   in finalize(stat, message)
+*****************************************/
+#ifndef _BEO_REPORT_HPP_
+#define _BEO_REPORT_HPP_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+
+#include "../L0/def.hpp"
+#include "../L0/comm.hpp"
+#include "../L0/ops.hpp"
+#include "../L0/counters.hpp"
+
+namespace beo
+{
+
+int report_counters(Comm& world, const Counters& counters, const int num_pairs = 3);
+
+/*****************************************
+ * report_counters
+ *
+ * Collective. Only the master prints.
+ *   The counters are read before the
+ *   report does any communication of
+ *   its own
+*****************************************/
+inline int report_counters(Comm& world, const Counters& counters, const int num_pairs)
+{
+    //the busiest peer of this task
+    struct Pair
+    {
+        double  bytes;
+
+        double  messages;
+
+        int32_t src;
+
+        int32_t dest;
+    };
+
+    const auto totals = counters.totals();
+
+    Pair mine{0, 0, world.task_id(), -1};
+
+    for (int peer = 0; peer < counters.num_peers(); peer++)
+    {
+        if (counters.bytes_sent(peer) > mine.bytes || -1 == mine.dest)
+        {
+            mine = {(double) counters.bytes_sent(peer), (double) counters.messages_sent(peer), world.task_id(), peer};
+        }
+    }
+
+    const char* names[] = {"messages sent",
+                           "bytes sent",
+                           "messages received",
+                           "bytes received",
+                           "wait seconds",
+                           "barrier seconds",
+                           "file bytes read",
+                           "file bytes written",
+                           "chunk allocations",
+                           "chunk bytes allocated",
+                           "cache hits",
+                           "cache misses"};
+
+    const size_t num = sizeof(names) / sizeof(names[0]);
+
+    std::vector<double> mins = {(double) totals.messages_sent,
+                                (double) totals.bytes_sent,
+                                (double) totals.messages_received,
+                                (double) totals.bytes_received,
+                                totals.wait_seconds,
+                                totals.barrier_seconds,
+                                (double) totals.file_bytes_read,
+                                (double) totals.file_bytes_written,
+                                (double) totals.chunk_allocations,
+                                (double) totals.chunk_bytes_allocated,
+                                (double) totals.cache_hits,
+                                (double) totals.cache_misses};
+
+    std::vector<double> maxs = mins;
+
+    std::vector<double> sums = mins;
+
+    std::vector<Pair> pairs(world.num_tasks());
+
+    int stat = beo::allreduce(world, mins.data(), num, Op::min);
+
+    stat |= beo::allreduce(world, maxs.data(), num, Op::max);
+
+    stat |= beo::allreduce(world, sums.data(), num, Op::sum);
+
+    stat |= beo::allgather(world, pairs.data(), &mine, sizeof(Pair));
+
+    if (world.is_master())
+    {
+        printf("beo::counters over %d tasks %14s %14s %14s\n", world.num_tasks(), "min", "avg", "max");
+
+        for (size_t i = 0; i < num; i++)
+        {
+            printf("beo::  %-26s %14.6g %14.6g %14.6g\n",
+                   names[i], mins[i], sums[i] / world.num_tasks(), maxs[i]);
+        }
+
+        std::sort(pairs.begin(), pairs.end(), [](const Pair& a, const Pair& b) {return a.bytes > b.bytes;});
+
+        for (int i = 0; i < num_pairs && i < (int) pairs.size() && pairs[i].bytes > 0; i++)
+        {
+            printf("beo::  busiest: task %d -> task %d, %.6g bytes in %.6g messages\n",
+                   pairs[i].src, pairs[i].dest, pairs[i].bytes, pairs[i].messages);
+        }
+    }
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+} //end namespace beo
+
+#endif
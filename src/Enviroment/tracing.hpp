@@ -0,0 +1,178 @@
+/*****************************************
+ * tracing.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for exporting the events
+ *   recorded by beo::Trace (see
+ *   L0/trace.hpp) when beo is built with
+ *   _BEO_TRACE_.
+ *
+ * write_trace gathers every task's events
+ *   on the master, which writes them as
+ *   a Chrome trace / Perfetto JSON file
+ *   (open it in ui.perfetto.dev or
+ *   chrome://tracing). Each task is a
+ *   process in the trace, and each of its
+ *   threads a thread. Times are from the
+ *   barrier in start_trace.
+ *
+ * The beo::Enviroment calls start_trace
+ *   on construction, and write_trace in
+ *   finalize, with the file named by
+ *   BEO_TRACE_FILE (default
+ *   beo_trace.json)
+*****************************************/
+#ifndef _BEO_TRACING_HPP_
+#define _BEO_TRACING_HPP_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "../L0/def.hpp"
+#include "../L0/comm.hpp"
+#include "../L0/ops.hpp"
+#include "../L0/trace.hpp"
+
+namespace beo
+{
+
+int start_trace(Comm& world);
+
+int write_trace(Comm& world, const std::string& file_name);
+
+std::string trace_file_name();
+
+/*****************************************
+ * start_trace
+ *
+ * Collective. Aligns the task clocks
+ *   with a barrier
+*****************************************/
+inline int start_trace(Comm& world)
+{
+    Trace::rank() = world.task_id();
+
+    int stat = beo::barrier(world);
+
+    Trace::instance().start();
+
+    return stat;
+}
+
+/*****************************************
+ * trace_file_name
+*****************************************/
+inline std::string trace_file_name()
+{
+    const char* env = getenv("BEO_TRACE_FILE");
+
+    return (nullptr != env) ? std::string(env) : std::string("beo_trace.json");
+}
+
+/*****************************************
+ * write_trace
+ *
+ * Collective. Nothing this does is
+ *   itself traced
+*****************************************/
+inline int write_trace(Comm& world, const std::string& file_name)
+{
+    using Event = Trace::Event;
+
+    Trace::is_paused() = true;
+
+    Comm comm = world;
+
+    //the master also takes events from threads with no task
+    auto events = Trace::instance().events(comm.task_id(), comm.is_master());
+
+    int64_t num_events = (int64_t) events.size();
+
+    std::vector<int64_t> counts(comm.num_tasks());
+
+    int stat = beo::allgather(comm, counts.data(), &num_events, sizeof(int64_t));
+
+    std::vector<Event> all;
+
+    if (comm.is_master()) all = events;
+
+    for (int task = 1; task < comm.num_tasks(); task++)
+    {
+        std::vector<Event> theirs(comm.is_master() ? counts[task] : 0);
+
+        stat |= beo::send_recv(comm,
+                               theirs.data(),
+                               events.data(),
+                               counts[task] * sizeof(Event),
+                               0,
+                               task,
+                               0);
+
+        all.insert(all.end(), theirs.begin(), theirs.end());
+    }
+
+    if (comm.is_master())
+    {
+        FILE* file = fopen(file_name.c_str(), "w");
+
+        if (nullptr == file)
+        {
+            printf("beo::write_trace could not open %s\n", file_name.c_str());
+            stat = BEO_FAIL;
+        }
+
+        else
+        {
+            fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+            for (int task = 0; task < comm.num_tasks(); task++)
+            {
+                fprintf(file,
+                        "%s{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"task %d\"}}",
+                        (task > 0) ? ",\n" : "", task, task);
+            }
+
+            for (const auto& event : all)
+            {
+                fprintf(file,
+                        ",\n{\"name\":\"%s\",\"cat\":\"beo\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                        "\"pid\":%d,\"tid\":%u,\"args\":{\"peer\":%d,\"tag\":%d,\"bytes\":%llu}}",
+                        Trace::name(event.op),
+                        event.start_ns * 1.0e-3,
+                        event.dur_ns * 1.0e-3,
+                        (event.rank >= 0) ? event.rank : 0,
+                        event.tid,
+                        event.peer,
+                        event.tag,
+                        (unsigned long long) event.bytes);
+            }
+
+            fprintf(file, "\n]}\n");
+
+            fclose(file);
+
+            const size_t dropped = Trace::instance().num_dropped();
+
+            if (dropped > 0)
+            {
+                printf("beo::write_trace %zu events on task 0 were overwritten, raise BEO_TRACE_EVENTS to keep them\n",
+                       dropped);
+            }
+        }
+    }
+
+    comm.finalize();
+
+    Trace::is_paused() = false;
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+} //end namespace beo
+
+#endif
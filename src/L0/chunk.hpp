@@ -37,6 +37,7 @@
 #include "utility.hpp"
 #include "chunk_tag.hpp"
 #include "chunk_tag_hash.hpp"
+#include "counters.hpp"
 
 namespace beo
 {
@@ -143,6 +144,8 @@ class Chunk
 
         size_t alignment() const {return alignment_;}
 
+        size_t bytes() const {return bytes_;}
+
 };
 
 /*****************************************
@@ -160,6 +163,7 @@ inline int Chunk::allocate(const size_t bytes)
     {
         bytes_     = bytes;
         alignment_ = calc_alignment(data_);
+        beo::counters().chunk_allocated(bytes);
         return BEO_SUCCESS;
     }
 
@@ -179,12 +183,14 @@ inline int Chunk::aligned_allocate(const size_t alignment, const size_t bytes)
 
     if (is_allocated()) return BEO_FAIL;
 
-    data_ = (void*) aligned_alloc(alignment, bytes); 
+    //aligned_alloc wants a multiple of the alignment
+    data_ = (void*) aligned_alloc(alignment, (bytes + alignment - 1) / alignment * alignment); 
 
     if (nullptr != data_)
     {
         bytes_     = bytes;
         alignment_ = alignment;
+        beo::counters().chunk_allocated(bytes);
         return BEO_SUCCESS;
     }
 
@@ -202,7 +208,7 @@ inline int Chunk::free()
 {
     std::lock_guard<mutex_t> g(m);
 
-    if (!is_allocated()) std::free(data_); 
+    if (is_allocated()) std::free(data_); 
 
     data_      = nullptr;
     bytes_     = 0; 
@@ -288,6 +294,10 @@ inline Chunk::Chunk(Chunk&& other)
     alignment_ = std::move(other.alignment_);
     bytes_     = std::move(other.bytes_);
     data_      = std::move(other.data_);
+
+    other.alignment_ = 0;
+    other.bytes_     = 0;
+    other.data_      = nullptr;
 }
 
 //Move constructor from other Chunk_Tag
@@ -321,6 +331,9 @@ inline Chunk& Chunk::operator=(const Chunk& cother)
 
         if (nullptr == data_) return *this;
 
+        bytes_     = other.bytes_;
+        alignment_ = other.alignment_;
+
         beo::memmove(data_, other.data_, bytes_);
     } 
     
@@ -335,11 +348,17 @@ inline Chunk& Chunk::operator=(Chunk&& other)
 
     if (&other == this) return *this; 
 
+    if (is_allocated()) free();
+
     chunk_tag_ = std::move(other.chunk_tag_);
     alignment_ = std::move(other.alignment_);
     bytes_     = std::move(other.bytes_);
     data_      = std::move(other.data_);
 
+    other.alignment_ = 0;
+    other.bytes_     = 0;
+    other.data_      = nullptr;
+
     return *this;
 }
 
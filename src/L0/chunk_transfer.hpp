@@ -0,0 +1,425 @@
+/*****************************************
+ * chunk_transfer.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for send_chunk, recv_chunk
+ *   and their async versions, which move
+ *   a whole beo::Chunk, tag and all, so
+ *   the reciever does not need to know
+ *   its shape ahead of time.
+ *
+ * The sender ships a header with the
+ *   offsets, lengths, and bytes of the
+ *   chunk. If the header and the data fit
+ *   in BEO_CHUNK_EAGER_BYTES they go in
+ *   one message. Otherwise the data
+ *   follows in a second message on the
+ *   same tag, which the reciever posts
+ *   straight into the chunk once it has
+ *   read the header and allocated it.
+ *
+ * The recieving chunk must not be
+ *   allocated. Its tag is set from the
+ *   header, and it is aligned_allocate'd
+ *   with BEO_CHUNK_ALIGNMENT.
+ *
+ * Since the data of a large chunk shares
+ *   the tag of its header, only one
+ *   recv_chunk should be posted at a time
+ *   for each peer and tag.
+ *
+ * Messages to this task (and all of them
+ *   in the serial case) go through a
+ *   per-task mailbox, matched by tag
+*****************************************/
+#ifndef _BEO_CHUNK_TRANSFER_HPP_
+#define _BEO_CHUNK_TRANSFER_HPP_
+
+#if defined _BEO_MPI_
+#include <mpi.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+#include "def.hpp"
+#include "chunk.hpp"
+#include "comm.hpp"
+#include "request.hpp"
+#include "ops.hpp"
+
+namespace beo
+{
+
+/*****************************************
+ * Chunk_Mailbox
+ *
+ * Chunks sent by a task to itself, in
+ *   the order they were sent
+*****************************************/
+struct Chunk_Mailbox
+{
+    std::mutex m;
+
+    std::deque<std::pair<int, std::vector<char>>> frames;
+};
+
+inline Chunk_Mailbox& chunk_mailbox()
+{
+    #if defined _BEO_THREADS_
+    static thread_local Chunk_Mailbox mailbox;
+    #else
+    static Chunk_Mailbox mailbox;
+    #endif
+
+    return mailbox;
+}
+
+/*****************************************
+ * Chunk_Request
+ *
+ * The handle of an async_send_chunk or
+ *   async_recv_chunk. Both wait on the
+ *   header first, then the data. A
+ *   recieve is only complete once its
+ *   chunk is allocated and filled in
+*****************************************/
+class Chunk_Request
+{
+    friend Chunk_Request async_send_chunk(Comm& comm, Chunk& chunk, int dest_id, int tag);
+
+    friend Chunk_Request async_recv_chunk(Comm& comm, Chunk& chunk, int src_id, int tag);
+
+    protected:
+
+        Comm*             comm_{nullptr};
+
+        Chunk*            chunk_{nullptr};
+
+        int               peer_{0};
+
+        int               tag_{0};
+
+        bool              is_recv_{false};
+
+        bool              is_self_{false};
+
+        bool              has_header_{true};
+
+        int               stat_{BEO_SUCCESS};
+
+        std::vector<char> frame_;
+
+        Request           header_;
+
+        Request           payload_;
+
+        bool take_from_mailbox();
+
+        int read_header();
+
+    public:
+
+        Chunk_Request() {}
+
+        Chunk_Request(Chunk_Request&& other) = default;
+
+        Chunk_Request& operator=(Chunk_Request&& other) = default;
+
+        bool is_complete();
+
+        int wait();
+};
+
+/*****************************************
+ * take_from_mailbox
+ *
+ * Takes the first frame sent to this
+ *   task with our tag, if there is one
+*****************************************/
+inline bool Chunk_Request::take_from_mailbox()
+{
+    auto& mailbox = chunk_mailbox();
+
+    std::lock_guard<std::mutex> g(mailbox.m);
+
+    for (auto itr = mailbox.frames.begin(); itr != mailbox.frames.end(); itr++)
+    {
+        if (itr->first == tag_)
+        {
+            frame_ = std::move(itr->second);
+            mailbox.frames.erase(itr);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*****************************************
+ * read_header
+ *
+ * Sets the tag of the chunk from the
+ *   header, allocates it, and either
+ *   copies the data out of the frame or
+ *   posts the recieve for it
+*****************************************/
+inline int Chunk_Request::read_header()
+{
+    has_header_ = true;
+
+    if (!is_recv_) return BEO_SUCCESS;
+
+    const size_t word = sizeof(uint64_t);
+
+    uint64_t ndim = 0, bytes = 0;
+    memcpy(&ndim,  frame_.data(),        word);
+    memcpy(&bytes, frame_.data() + word, word);
+
+    const size_t header_bytes = (2 + 2 * ndim) * word;
+
+    if (header_bytes > frame_.size())
+    {
+        printf("beo::recv_chunk Task %d recieved a bad header from task %d\n", comm_->task_id(), peer_);
+        return BEO_FAIL;
+    }
+
+    Chunk::offsets_t offsets(ndim);
+    Chunk::lengths_t lengths(ndim);
+    for (size_t idx = 0; idx < ndim; idx++)
+    {
+        uint64_t off, len;
+        memcpy(&off, frame_.data() + (2 + idx) * word,        word);
+        memcpy(&len, frame_.data() + (2 + ndim + idx) * word, word);
+        offsets[idx] = off;
+        lengths[idx] = len;
+    }
+
+    chunk_->offsets() = std::move(offsets);
+    chunk_->lengths() = std::move(lengths);
+
+    if (bytes > 0 && BEO_SUCCESS != chunk_->aligned_allocate(BEO_CHUNK_ALIGNMENT, bytes)) return BEO_FAIL;
+
+    if (header_bytes + bytes <= frame_.size())
+    {
+        if (bytes > 0) memcpy(chunk_->data(), frame_.data() + header_bytes, bytes);
+    }
+
+    else
+    {
+        payload_ = async_send_recv(*comm_, chunk_->data(), nullptr, bytes, comm_->task_id(), peer_, tag_);
+    }
+
+    frame_.clear();
+    frame_.shrink_to_fit();
+
+    return BEO_SUCCESS;
+}
+
+/*****************************************
+ * is_complete
+*****************************************/
+inline bool Chunk_Request::is_complete()
+{
+    if (BEO_SUCCESS != stat_) return true;
+
+    if (!has_header_)
+    {
+        if (is_self_)
+        {
+            if (!take_from_mailbox()) return false;
+        }
+
+        else
+        {
+            if (!header_.is_complete()) return false;
+            stat_ = header_.wait();
+        }
+
+        if (BEO_SUCCESS == stat_) stat_ = read_header();
+
+        if (BEO_SUCCESS != stat_) return true;
+    }
+
+    return payload_.is_complete();
+}
+
+/*****************************************
+ * wait
+*****************************************/
+inline int Chunk_Request::wait()
+{
+    if (BEO_SUCCESS != stat_) return stat_;
+
+    if (!has_header_)
+    {
+        if (is_self_)
+        {
+            if (!take_from_mailbox())
+            {
+                printf("beo::recv_chunk Task %d has no chunk from itself with tag %d\n", comm_->task_id(), tag_);
+                stat_ = BEO_FAIL;
+                return stat_;
+            }
+        }
+
+        else
+        {
+            stat_ = header_.wait();
+        }
+
+        if (BEO_SUCCESS == stat_) stat_ = read_header();
+
+        if (BEO_SUCCESS != stat_) return stat_;
+    }
+
+    stat_ = payload_.wait();
+
+    return stat_;
+}
+
+/*****************************************
+ * async_send_chunk
+ *
+ * Sends chunk, tag and data, to dest_id.
+ *   The chunk must not change until the
+ *   request is complete
+*****************************************/
+inline Chunk_Request async_send_chunk(Comm& comm,
+                                      Chunk& chunk,
+                                      int    dest_id,
+                                      int    tag)
+{
+    if (dest_id >= comm.num_tasks())
+    {
+        printf("beo::send_chunk Task %d input dest_id(%d) is invalid\n", comm.task_id(), dest_id);
+        exit(1);
+    }
+
+    Chunk_Request request;
+
+    request.comm_    = &comm;
+    request.chunk_   = &chunk;
+    request.peer_    = dest_id;
+    request.tag_     = tag;
+    request.is_self_ = comm.task_id() == dest_id;
+
+    const size_t word  = sizeof(uint64_t);
+    const size_t ndim  = chunk.ndim();
+    const size_t bytes = chunk.bytes();
+
+    const size_t header_bytes = (2 + 2 * ndim) * word;
+
+    const bool is_eager = request.is_self_ || header_bytes + bytes <= BEO_CHUNK_EAGER_BYTES;
+
+    auto& frame = request.frame_;
+    frame.resize(header_bytes + (is_eager ? bytes : 0));
+
+    const uint64_t header[2] = {ndim, bytes};
+    memcpy(frame.data(), header, 2 * word);
+    for (size_t idx = 0; idx < ndim; idx++)
+    {
+        const uint64_t off = chunk.offset(idx), len = chunk.length(idx);
+        memcpy(frame.data() + (2 + idx) * word,        &off, word);
+        memcpy(frame.data() + (2 + ndim + idx) * word, &len, word);
+    }
+
+    if (is_eager && bytes > 0) memcpy(frame.data() + header_bytes, chunk.data(), bytes);
+
+    if (request.is_self_)
+    {
+        auto& mailbox = chunk_mailbox();
+        std::lock_guard<std::mutex> g(mailbox.m);
+        mailbox.frames.emplace_back(tag, std::move(frame));
+        return request;
+    }
+
+    request.has_header_ = false;
+
+    request.header_ = async_send_recv(comm, nullptr, frame.data(), frame.size(), dest_id, comm.task_id(), tag);
+
+    if (!is_eager)
+    {
+        request.payload_ = async_send_recv(comm, nullptr, chunk.data(), bytes, dest_id, comm.task_id(), tag);
+    }
+
+    return request;
+}
+
+/*****************************************
+ * async_recv_chunk
+ *
+ * Recieves a chunk sent with send_chunk
+ *   from src_id into the unallocated
+ *   chunk
+*****************************************/
+inline Chunk_Request async_recv_chunk(Comm& comm,
+                                      Chunk& chunk,
+                                      int    src_id,
+                                      int    tag)
+{
+    if (src_id >= comm.num_tasks())
+    {
+        printf("beo::recv_chunk Task %d input src_id(%d) is invalid\n", comm.task_id(), src_id);
+        exit(1);
+    }
+
+    Chunk_Request request;
+
+    request.comm_       = &comm;
+    request.chunk_      = &chunk;
+    request.peer_       = src_id;
+    request.tag_        = tag;
+    request.is_recv_    = true;
+    request.is_self_    = comm.task_id() == src_id;
+    request.has_header_ = false;
+
+    if (chunk.is_allocated())
+    {
+        printf("beo::recv_chunk Task %d chunk is already allocated\n", comm.task_id());
+        request.stat_ = BEO_FAIL;
+        return request;
+    }
+
+    if (!request.is_self_)
+    {
+        request.frame_.resize(BEO_CHUNK_EAGER_BYTES);
+
+        request.header_ = async_send_recv(comm, request.frame_.data(), nullptr, request.frame_.size(),
+                                          comm.task_id(), src_id, tag);
+    }
+
+    return request;
+}
+
+/*****************************************
+ * send_chunk / recv_chunk
+ *
+ * Blocking versions of the above
+*****************************************/
+inline int send_chunk(Comm& comm,
+                      Chunk& chunk,
+                      int    dest_id,
+                      int    tag)
+{
+    return async_send_chunk(comm, chunk, dest_id, tag).wait();
+}
+
+inline int recv_chunk(Comm& comm,
+                      Chunk& chunk,
+                      int    src_id,
+                      int    tag)
+{
+    return async_recv_chunk(comm, chunk, src_id, tag).wait();
+}
+
+} //end namespace beo
+
+#endif
@@ -13,6 +13,17 @@
  * Note that the finalize function MUST 
  *   be called before MPI_Finalize
  *   is called 
+ *
+ * With _BEO_THREADS_, a Comm is a 
+ *   beo::Thread_Group and a context 
+ *   within it. Copying a Comm gives the
+ *   copy a new context, like MPI_Comm_dup
+ *
+ * With _BEO_SHM_, a Comm is the process's
+ *   beo::Shm_Transport, the transport
+ *   ranks of its tasks, and a context.
+ *   As with MPI_Comm_dup, copies must be
+ *   made in the same order on every task
 *****************************************/
 #ifndef _BEO_COMM_HPP_
 #define _BEO_COMM_HPP_
@@ -22,9 +33,22 @@
 #endif
 
 #include <utility>
+#include <memory>
 
+#include "def.hpp"
 #include "info.hpp" 
 
+#if defined _BEO_THREADS_
+#include "thread_group.hpp"
+#endif
+
+#if defined _BEO_SHM_
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include "shm_transport.hpp"
+#endif
+
 namespace beo
 {
 
@@ -38,6 +62,24 @@ class Comm
 
         MPI_Comm comm_{MPI_COMM_NULL};
 
+        #elif defined _BEO_THREADS_
+
+        std::shared_ptr<Thread_Group> group_;
+
+        int context_{0};
+
+        #elif defined _BEO_SHM_
+
+        std::shared_ptr<Shm_Transport> transport_;
+
+        //transport rank of each task
+        std::vector<int> ranks_;
+
+        Shm_Transport::context_t context_{0};
+
+        //number of copies made of this comm, which sets their contexts
+        mutable uint64_t num_copies_{0};
+
         #endif
 
         int num_tasks_{1};
@@ -46,6 +88,12 @@ class Comm
 
         bool is_master_{true};
 
+        #if defined _BEO_MPI_
+
+        void init_ranks();
+
+        #endif
+
     public:
 
         Comm() {};
@@ -70,6 +118,26 @@ class Comm
 
         Comm& operator=(const MPI_Comm& other);
 
+        #elif defined _BEO_THREADS_
+
+        Comm(std::shared_ptr<Thread_Group> group, const int task_id);
+
+        const std::shared_ptr<Thread_Group>& group() const {return group_;}
+
+        int context() const {return context_;}
+
+        #elif defined _BEO_SHM_
+
+        Comm(std::shared_ptr<Shm_Transport> transport);
+
+        const std::shared_ptr<Shm_Transport>& transport() const {return transport_;}
+
+        const std::vector<int>& ranks() const {return ranks_;}
+
+        int rank_of(const int task_id) const {return ranks_[task_id];}
+
+        Shm_Transport::context_t context() const {return context_;}
+
         #endif
 
         void finalize();
@@ -82,11 +150,16 @@ class Comm
 
         #if defined _BEO_MPI_
 
-        Comm&& split(int color, int key) const;
+        Comm split(int color, int key) const;
+
+        Comm split_type(int type, int key) const;
 
-        Comm&& split_type(int type, int key) const;
+        Comm split_type(int type, int key, const Info& info) const;
 
-        Comm&& split_type(int type, int key, const Info& info) const;
+        #elif defined _BEO_THREADS_ || defined _BEO_SHM_
+
+        //a color < 0 leaves the task out of the new comm
+        Comm split(int color, int key) const;
 
         #endif
 
@@ -98,7 +171,15 @@ class Comm
 inline Comm::Comm(const Comm& other)
 {
     #if defined _BEO_MPI_
-    MPI_Comm_dup(other.comm_, &comm_);
+    if (MPI_COMM_NULL != other.comm_) MPI_Comm_dup(other.comm_, &comm_);
+    #elif defined _BEO_THREADS_
+    group_   = other.group_;
+    context_ = (nullptr != group_) ? group_->dup_context(other.task_id_) : 0;
+    #elif defined _BEO_SHM_
+    transport_  = other.transport_;
+    ranks_      = other.ranks_;
+    context_    = Shm_Transport::child_context(other.context_, ++other.num_copies_);
+    num_copies_ = 0;
     #endif
 
     num_tasks_ = other.num_tasks_;
@@ -110,6 +191,15 @@ inline Comm::Comm(Comm&& other)
 {
     #if defined _BEO_MPI_
     comm_ = std::move(other.comm_);
+    other.comm_ = MPI_COMM_NULL;
+    #elif defined _BEO_THREADS_
+    group_   = std::move(other.group_);
+    context_ = other.context_;
+    #elif defined _BEO_SHM_
+    transport_  = std::move(other.transport_);
+    ranks_      = std::move(other.ranks_);
+    context_    = other.context_;
+    num_copies_ = other.num_copies_;
     #endif
 
     num_tasks_ = std::move(other.num_tasks_);
@@ -122,7 +212,15 @@ inline Comm& Comm::operator=(const Comm& other)
     if (&other == this) return *this;
 
     #if defined _BEO_MPI_
-    MPI_Comm_dup(other.comm_, &comm_);
+    if (MPI_COMM_NULL != other.comm_) MPI_Comm_dup(other.comm_, &comm_);
+    #elif defined _BEO_THREADS_
+    group_   = other.group_;
+    context_ = (nullptr != group_) ? group_->dup_context(other.task_id_) : 0;
+    #elif defined _BEO_SHM_
+    transport_  = other.transport_;
+    ranks_      = other.ranks_;
+    context_    = Shm_Transport::child_context(other.context_, ++other.num_copies_);
+    num_copies_ = 0;
     #endif
 
     num_tasks_ = other.num_tasks_;
@@ -138,6 +236,15 @@ inline Comm& Comm::operator=(Comm&& other)
 
     #if defined _BEO_MPI_
     comm_ = std::move(other.comm_);
+    other.comm_ = MPI_COMM_NULL;
+    #elif defined _BEO_THREADS_
+    group_   = std::move(other.group_);
+    context_ = other.context_;
+    #elif defined _BEO_SHM_
+    transport_  = std::move(other.transport_);
+    ranks_      = std::move(other.ranks_);
+    context_    = other.context_;
+    num_copies_ = other.num_copies_;
     #endif
 
     num_tasks_ = std::move(other.num_tasks_);
@@ -176,39 +283,170 @@ inline Comm::Comm(const MPI_Comm& mpi_comm)
 }
 #endif
 
+#if defined _BEO_THREADS_
+inline Comm::Comm(std::shared_ptr<Thread_Group> group, const int task_id)
+{
+    group_   = group;
+    context_ = 0;
+
+    num_tasks_ = (nullptr != group_) ? group_->num_tasks() : 1;
+    task_id_   = (nullptr != group_) ? task_id : 0;
+    is_master_ = (0 == task_id_);
+}
+#endif
+
+#if defined _BEO_SHM_
+inline Comm::Comm(std::shared_ptr<Shm_Transport> transport)
+{
+    transport_ = transport;
+    context_   = 0;
+
+    num_tasks_ = (nullptr != transport_) ? transport_->num_tasks() : 1;
+    task_id_   = (nullptr != transport_) ? transport_->rank() : 0;
+    is_master_ = (0 == task_id_);
+
+    ranks_.resize(num_tasks_);
+    std::iota(ranks_.begin(), ranks_.end(), 0);
+}
+#endif
+
+/*****************************************
+ * init_ranks
+ *
+ * sets the number of tasks, task id, and
+ *   master status from comm_. A task that
+ *   is not part of the comm (MPI_COMM_NULL)
+ *   sees zero tasks and id -1
+*****************************************/
+#if defined _BEO_MPI_
+inline void Comm::init_ranks()
+{
+    if (MPI_COMM_NULL == comm_)
+    {
+        num_tasks_ = 0;
+        task_id_   = -1;
+        is_master_ = false;
+        return;
+    }
+
+    MPI_Comm_size(comm_, &num_tasks_);
+
+    MPI_Comm_rank(comm_, &task_id_);
+
+    is_master_ = (0 == task_id_);
+}
+#endif
+
 /*****************************************
  * split functions
+ *
+ * these return the new Comm by value, which
+ *   the caller is responsible for finalizing
 *****************************************/
 #if defined _BEO_MPI_
-inline Comm&& Comm::split(int color, int key) const
+inline Comm Comm::split(int color, int key) const
 {
     Comm new_comm; 
 
     MPI_Comm_split(comm_, color, key, &new_comm.comm_);
 
-    return std::move(new_comm);
+    new_comm.init_ranks();
+
+    return new_comm;
 }
 #endif
 
 #if defined _BEO_MPI_
-inline Comm&& Comm::split_type(int type, int key) const 
+inline Comm Comm::split_type(int type, int key) const 
 {
     Comm new_comm; 
 
     MPI_Comm_split_type(comm_, type, key, MPI_INFO_NULL, &new_comm.comm_);
 
-    return std::move(new_comm);
+    new_comm.init_ranks();
+
+    return new_comm;
 }
 #endif
 
 #if defined _BEO_MPI_
-inline Comm&& Comm::split_type(int type, int key, const Info& info) const 
+inline Comm Comm::split_type(int type, int key, const Info& info) const 
 {
     Comm new_comm; 
 
     MPI_Comm_split_type(comm_, type, key, info.info(), &new_comm.comm_);
 
-    return std::move(new_comm);
+    new_comm.init_ranks();
+
+    return new_comm;
+}
+#endif
+
+#if defined _BEO_THREADS_
+inline Comm Comm::split(int color, int key) const 
+{
+    int new_id = 0;
+
+    auto new_group = (nullptr != group_) 
+                   ? group_->split(context_, task_id_, color, key, new_id)
+                   : nullptr;
+
+    Comm new_comm(new_group, new_id);
+
+    if (color < 0)
+    {
+        new_comm.num_tasks_ = 0;
+        new_comm.task_id_   = -1;
+        new_comm.is_master_ = false;
+    }
+
+    return new_comm;
+}
+#endif
+
+#if defined _BEO_SHM_
+inline Comm Comm::split(int color, int key) const 
+{
+    Comm new_comm;
+
+    new_comm.transport_ = transport_;
+    new_comm.context_   = Shm_Transport::child_context(context_, ++num_copies_);
+
+    //everyone's color and key, gathered on task 0 and shared
+    std::vector<int> all(2 * num_tasks_);
+
+    if (nullptr != transport_)
+    {
+        const int mine[2] = {color, key};
+        transport_->gather(ranks_, context_, task_id_, all.data(), mine, sizeof(mine), 0);
+        transport_->broadcast(ranks_, context_, task_id_, all.data(), all.size() * sizeof(int), 0);
+    }
+
+    else
+    {
+        all = {color, key};
+    }
+
+    //members of my color, ordered by key then task id
+    std::vector<std::pair<int, int>> members;
+    for (int task = 0; task < num_tasks_; task++)
+    {
+        if (color >= 0 && all[2 * task] == color) members.push_back({all[2 * task + 1], task});
+    }
+    std::sort(members.begin(), members.end());
+
+    new_comm.num_tasks_ = (int) members.size();
+    new_comm.task_id_   = -1;
+
+    for (size_t i = 0; i < members.size(); i++)
+    {
+        new_comm.ranks_.push_back(ranks_[members[i].second]);
+        if (members[i].second == task_id_) new_comm.task_id_ = (int) i;
+    }
+
+    new_comm.is_master_ = (0 == new_comm.task_id_);
+
+    return new_comm;
 }
 #endif
 
@@ -221,6 +459,10 @@ inline void Comm::finalize()
 {
     #if defined _BEO_MPI_
     if (MPI_COMM_NULL != comm_) MPI_Comm_free(&comm_);
+    #elif defined _BEO_THREADS_
+    group_ = nullptr;
+    #elif defined _BEO_SHM_
+    transport_ = nullptr;
     #endif
 }
 
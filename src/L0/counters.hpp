@@ -0,0 +1,376 @@
+/*****************************************
+ * counters.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Counters, the
+ *   per-task performance counters.
+ *
+ * The counters are always on. They count
+ *   messages and bytes sent to and
+ *   received from each peer, the time
+ *   spent blocked in Request::wait and
+ *   beo::barrier, the bytes read from and
+ *   written to files, the chunks
+ *   allocated, and cache hits and misses.
+ *   Each update is one relaxed atomic add.
+ *
+ * Peers are task ids on the comm the
+ *   message was sent on. Messages to
+ *   peers past num_peers() are only
+ *   counted in the totals.
+ *
+ * The beo::Enviroment owns the counters
+ *   and registers them with set_counters.
+ *   beo::counters() returns the registered
+ *   counters, or default ones if there
+ *   are none. With _BEO_THREADS_ the
+ *   registration is per task thread, as
+ *   for the thread pool.
+ *
+ * See Enviroment/report.hpp for the
+ *   summary across tasks
+*****************************************/
+#ifndef _BEO_COUNTERS_HPP_
+#define _BEO_COUNTERS_HPP_
+
+#include <stdint.h>
+#include <memory>
+#include <atomic>
+#include <chrono>
+
+namespace beo
+{
+
+class Counters
+{
+    public:
+
+        using clock_t = std::chrono::steady_clock;
+
+        enum class Time : int32_t
+        {
+            wait,
+            barrier,
+            num_times
+        };
+
+        //Snapshot of the totals
+        struct Totals
+        {
+            uint64_t messages_sent{0};
+
+            uint64_t bytes_sent{0};
+
+            uint64_t messages_received{0};
+
+            uint64_t bytes_received{0};
+
+            double   wait_seconds{0};
+
+            double   barrier_seconds{0};
+
+            uint64_t file_bytes_read{0};
+
+            uint64_t file_bytes_written{0};
+
+            uint64_t chunk_allocations{0};
+
+            uint64_t chunk_bytes_allocated{0};
+
+            uint64_t cache_hits{0};
+
+            uint64_t cache_misses{0};
+        };
+
+    protected:
+
+        using counter_t = std::atomic<uint64_t>;
+
+        struct Peer
+        {
+            counter_t messages_sent{0};
+
+            counter_t bytes_sent{0};
+
+            counter_t messages_received{0};
+
+            counter_t bytes_received{0};
+        };
+
+        std::unique_ptr<Peer[]> peers_;
+
+        int       num_peers_{0};
+
+        counter_t messages_sent_{0};
+
+        counter_t bytes_sent_{0};
+
+        counter_t messages_received_{0};
+
+        counter_t bytes_received_{0};
+
+        counter_t time_ns_[(int) Time::num_times]{};
+
+        counter_t file_bytes_read_{0};
+
+        counter_t file_bytes_written_{0};
+
+        counter_t chunk_allocations_{0};
+
+        counter_t chunk_bytes_allocated_{0};
+
+        counter_t cache_hits_{0};
+
+        counter_t cache_misses_{0};
+
+        static void add(counter_t& counter, const uint64_t value) {counter.fetch_add(value, std::memory_order_relaxed);}
+
+        static uint64_t get(const counter_t& counter) {return counter.load(std::memory_order_relaxed);}
+
+    public:
+
+        Counters() {}
+
+        Counters(const Counters& other) = delete;
+
+        Counters& operator=(const Counters& other) = delete;
+
+        //sizes the per-peer counters and zeros everything. Not thread safe
+        void init(const int num_peers);
+
+        //zeros everything
+        void reset();
+
+        int num_peers() const {return num_peers_;}
+
+        //task me saw a message of bytes from src_id to dest_id
+        void message(const int me, const int dest_id, const int src_id, const size_t bytes);
+
+        void sent(const int peer, const size_t bytes);
+
+        void received(const int peer, const size_t bytes);
+
+        void add_time(const Time time, const int64_t ns) {add(time_ns_[(int) time], (uint64_t) ns);}
+
+        void file_read(const size_t bytes) {add(file_bytes_read_, bytes);}
+
+        void file_written(const size_t bytes) {add(file_bytes_written_, bytes);}
+
+        void chunk_allocated(const size_t bytes) {add(chunk_allocations_, 1); add(chunk_bytes_allocated_, bytes);}
+
+        void cache_hit() {add(cache_hits_, 1);}
+
+        void cache_miss() {add(cache_misses_, 1);}
+
+        Totals totals() const;
+
+        double seconds(const Time time) const {return get(time_ns_[(int) time]) * 1.0e-9;}
+
+        uint64_t messages_sent(const int peer) const {return valid(peer) ? get(peers_[peer].messages_sent) : 0;}
+
+        uint64_t bytes_sent(const int peer) const {return valid(peer) ? get(peers_[peer].bytes_sent) : 0;}
+
+        uint64_t messages_received(const int peer) const {return valid(peer) ? get(peers_[peer].messages_received) : 0;}
+
+        uint64_t bytes_received(const int peer) const {return valid(peer) ? get(peers_[peer].bytes_received) : 0;}
+
+        bool valid(const int peer) const {return peer >= 0 && peer < num_peers_;}
+};
+
+/*****************************************
+ * Counter_Timer
+ *
+ * Adds the time it was alive to one of
+ *   the counters
+*****************************************/
+class Counter_Timer
+{
+    protected:
+
+        Counters&                     counters_;
+
+        Counters::Time                time_;
+
+        Counters::clock_t::time_point start_;
+
+    public:
+
+        Counter_Timer(Counters& counters, const Counters::Time time)
+        : counters_(counters), time_(time), start_(Counters::clock_t::now()) {}
+
+       ~Counter_Timer()
+        {
+            counters_.add_time(time_, std::chrono::duration_cast<std::chrono::nanoseconds>(Counters::clock_t::now() - start_).count());
+        }
+
+        Counter_Timer(const Counter_Timer& other) = delete;
+
+        Counter_Timer& operator=(const Counter_Timer& other) = delete;
+};
+
+//Access to the counters of the calling task
+Counters& counters();
+
+void set_counters(Counters* counters);
+
+/*****************************************
+ * init/reset
+*****************************************/
+inline void Counters::init(const int num_peers)
+{
+    num_peers_ = (num_peers > 0) ? num_peers : 0;
+
+    peers_.reset((num_peers_ > 0) ? new Peer[num_peers_] : nullptr);
+
+    reset();
+}
+
+inline void Counters::reset()
+{
+    for (int peer = 0; peer < num_peers_; peer++)
+    {
+        peers_[peer].messages_sent     = 0;
+        peers_[peer].bytes_sent        = 0;
+        peers_[peer].messages_received = 0;
+        peers_[peer].bytes_received    = 0;
+    }
+
+    messages_sent_     = 0;
+    bytes_sent_        = 0;
+    messages_received_ = 0;
+    bytes_received_    = 0;
+
+    for (auto& time_ns : time_ns_) time_ns = 0;
+
+    file_bytes_read_       = 0;
+    file_bytes_written_    = 0;
+    chunk_allocations_     = 0;
+    chunk_bytes_allocated_ = 0;
+    cache_hits_            = 0;
+    cache_misses_          = 0;
+}
+
+/*****************************************
+ * message
+ *
+ * Counts a send_recv from the point of
+ *   view of task me. Copies to self are
+ *   not messages
+*****************************************/
+inline void Counters::message(const int me, const int dest_id, const int src_id, const size_t bytes)
+{
+    if (dest_id == src_id) return;
+
+    if (me == src_id) sent(dest_id, bytes);
+
+    else if (me == dest_id) received(src_id, bytes);
+}
+
+inline void Counters::sent(const int peer, const size_t bytes)
+{
+    add(messages_sent_, 1);
+    add(bytes_sent_, bytes);
+
+    if (valid(peer))
+    {
+        add(peers_[peer].messages_sent, 1);
+        add(peers_[peer].bytes_sent, bytes);
+    }
+}
+
+inline void Counters::received(const int peer, const size_t bytes)
+{
+    add(messages_received_, 1);
+    add(bytes_received_, bytes);
+
+    if (valid(peer))
+    {
+        add(peers_[peer].messages_received, 1);
+        add(peers_[peer].bytes_received, bytes);
+    }
+}
+
+/*****************************************
+ * totals
+*****************************************/
+inline Counters::Totals Counters::totals() const
+{
+    Totals totals;
+
+    totals.messages_sent         = get(messages_sent_);
+    totals.bytes_sent            = get(bytes_sent_);
+    totals.messages_received     = get(messages_received_);
+    totals.bytes_received        = get(bytes_received_);
+    totals.wait_seconds          = seconds(Time::wait);
+    totals.barrier_seconds       = seconds(Time::barrier);
+    totals.file_bytes_read       = get(file_bytes_read_);
+    totals.file_bytes_written    = get(file_bytes_written_);
+    totals.chunk_allocations     = get(chunk_allocations_);
+    totals.chunk_bytes_allocated = get(chunk_bytes_allocated_);
+    totals.cache_hits            = get(cache_hits_);
+    totals.cache_misses          = get(cache_misses_);
+
+    return totals;
+}
+
+/*****************************************
+ * counters registration
+ *
+ * The registered counters are used if
+ *   there are any, otherwise default ones
+ *
+ * adopt_counters gives a thread pool task
+ *   the counters of the task that
+ *   submitted it. Only needed with
+ *   _BEO_THREADS_, where the registration
+ *   is per thread
+*****************************************/
+inline Counters*& registered_counters()
+{
+    #if defined _BEO_THREADS_
+
+    static thread_local Counters* counters = nullptr;
+
+    #else
+
+    static Counters* counters = nullptr;
+
+    #endif
+
+    return counters;
+}
+
+inline void set_counters(Counters* counters)
+{
+    registered_counters() = counters;
+}
+
+inline void adopt_counters(Counters* counters)
+{
+    #if defined _BEO_THREADS_
+
+    registered_counters() = counters;
+
+    #else
+
+    (void) counters;
+
+    #endif
+}
+
+inline Counters& counters()
+{
+    Counters* counters = registered_counters();
+
+    if (nullptr != counters) return *counters;
+
+    static Counters default_counters;
+
+    return default_counters;
+}
+
+} //end namespace beo
+
+#endif
@@ -0,0 +1,155 @@
+/*****************************************
+ * datatype.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Datatype, which
+ *   maps C++ types onto MPI_Datatypes,
+ *   and beo::Op, the reduction operations
+ *   that beo supports.
+ *
+ * apply_op performs an Op on local
+ *   buffers, and is what the non-MPI
+ *   paths use in place of MPI.
+ *   atomic_apply_op does the same to one
+ *   element that other threads (or
+ *   processes sharing the memory) may be
+ *   updating at the same time
+*****************************************/
+#ifndef _BEO_DATATYPE_HPP_
+#define _BEO_DATATYPE_HPP_
+
+#if defined _BEO_MPI_
+#include <mpi.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <algorithm>
+
+namespace beo
+{
+
+//Reduction operations
+enum class Op {sum, prod, max, min, replace};
+
+/*****************************************
+ * Datatype
+ *
+ * Datatype<T>::type() returns the MPI_Datatype
+ *   of T
+*****************************************/
+template<typename T>
+struct Datatype;
+
+#if defined _BEO_MPI_
+
+#define _BEO_DATATYPE_(T, MPI_T) \
+template<> struct Datatype<T> {static MPI_Datatype type() {return MPI_T;}};
+
+_BEO_DATATYPE_(char,               MPI_CHAR)
+_BEO_DATATYPE_(signed char,        MPI_SIGNED_CHAR)
+_BEO_DATATYPE_(unsigned char,      MPI_UNSIGNED_CHAR)
+_BEO_DATATYPE_(short,              MPI_SHORT)
+_BEO_DATATYPE_(unsigned short,     MPI_UNSIGNED_SHORT)
+_BEO_DATATYPE_(int,                MPI_INT)
+_BEO_DATATYPE_(unsigned int,       MPI_UNSIGNED)
+_BEO_DATATYPE_(long,               MPI_LONG)
+_BEO_DATATYPE_(unsigned long,      MPI_UNSIGNED_LONG)
+_BEO_DATATYPE_(long long,          MPI_LONG_LONG)
+_BEO_DATATYPE_(unsigned long long, MPI_UNSIGNED_LONG_LONG)
+_BEO_DATATYPE_(float,              MPI_FLOAT)
+_BEO_DATATYPE_(double,             MPI_DOUBLE)
+_BEO_DATATYPE_(long double,        MPI_LONG_DOUBLE)
+
+#undef _BEO_DATATYPE_
+
+/*****************************************
+ * mpi_op
+ *
+ * returns the MPI_Op of a beo::Op
+*****************************************/
+inline MPI_Op mpi_op(const Op op)
+{
+    switch (op)
+    {
+        case Op::sum     : return MPI_SUM;
+        case Op::prod    : return MPI_PROD;
+        case Op::max     : return MPI_MAX;
+        case Op::min     : return MPI_MIN;
+        case Op::replace : return MPI_REPLACE;
+    }
+    return MPI_OP_NULL;
+}
+
+#endif
+
+/*****************************************
+ * apply_op
+ *
+ * dest[i] = dest[i] op src[i] for i < count
+*****************************************/
+template<typename T>
+inline void apply_op(const Op op,
+                     T* dest,
+                     const T* src,
+                     const size_t count)
+{
+    switch (op)
+    {
+        case Op::sum :
+            for (size_t i = 0; i < count; i++) dest[i] += src[i];
+            break;
+        case Op::prod :
+            for (size_t i = 0; i < count; i++) dest[i] *= src[i];
+            break;
+        case Op::max :
+            for (size_t i = 0; i < count; i++) dest[i] = std::max(dest[i], src[i]);
+            break;
+        case Op::min :
+            for (size_t i = 0; i < count; i++) dest[i] = std::min(dest[i], src[i]);
+            break;
+        case Op::replace :
+            for (size_t i = 0; i < count; i++) dest[i] = src[i];
+            break;
+    }
+}
+
+/*****************************************
+ * atomic_apply_op
+ *
+ * *dest = *dest op value, atomically,
+ *   with a compare-exchange loop so any T
+ *   and Op work without a lock
+*****************************************/
+template<typename T>
+inline void atomic_apply_op(const Op op,
+                            T* dest,
+                            const T value)
+{
+    static_assert(sizeof(std::atomic<T>) == sizeof(T), "beo::atomic_apply_op needs a lock-free T");
+
+    auto& elm = *(std::atomic<T>*) dest;
+
+    if (Op::replace == op)
+    {
+        elm.store(value, std::memory_order_relaxed);
+        return;
+    }
+
+    T old = elm.load(std::memory_order_relaxed);
+    T next;
+
+    do
+    {
+        next = old;
+        apply_op<T>(op, &next, &value, 1);
+    }
+    while (!elm.compare_exchange_weak(old, next, std::memory_order_relaxed));
+}
+
+} //end namespace beo
+
+#endif
@@ -12,8 +12,25 @@
 #define BEO_SUCCESS 0
 #define BEO_FAIL 1
 
+//Backends. Without any, beo runs as a single task
+//  _BEO_MPI_     : tasks are MPI processes
+//  _BEO_THREADS_ : tasks are threads of one process
+//  _BEO_SHM_     : tasks are processes on one host, 
+//                  talking through POSIX shared memory
+#if (defined _BEO_MPI_ && defined _BEO_THREADS_) || \
+    (defined _BEO_MPI_ && defined _BEO_SHM_)     || \
+    (defined _BEO_THREADS_ && defined _BEO_SHM_)
+#error "beo: define only one of _BEO_MPI_, _BEO_THREADS_, and _BEO_SHM_"
+#endif
+
 //File IO macros
 #define BEO_OFF_T off_t
 #define BEO_FTELL(X) (ftello(X))
 
+//Alignment (in bytes) of chunks placed in beo-managed memory
+#define BEO_CHUNK_ALIGNMENT 64
+
+//Largest message (in bytes) that send_chunk sends its tag and data in together
+#define BEO_CHUNK_EAGER_BYTES 4096
+
 #endif
@@ -0,0 +1,370 @@
+/*****************************************
+ * event_loop.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Event_Loop, which
+ *   runs a callback when a Request
+ *   completes, e.g.,
+ *
+ *     beo::async_send_recv(comm, chunk.data(), ...)
+ *         .then([&](int stat)
+ *         {
+ *             beo::thread_pool().submit([&]() {return gemm(chunk);});
+ *         });
+ *
+ *     ...compute...
+ *
+ *     env.event_loop().run();
+ *
+ * Request::then hands the request to the
+ *   registered loop (beo::event_loop()),
+ *   which the Enviroment owns. Each
+ *   callback gets the status of its
+ *   request, and is run once, by
+ *   whichever thread calls poll or run:
+ *      poll : fires the callbacks of the
+ *             requests that are complete,
+ *             without blocking
+ *      run  : fires callbacks until none
+ *             are left. Under MPI it
+ *             blocks in MPI_Waitsome on
+ *             all of them at once rather
+ *             than spinning, otherwise it
+ *             helps the thread pool
+ *      test : only tests the requests
+ *             (MPI_Testsome), so MPI moves
+ *             them along, and returns how
+ *             many it completed. Their
+ *             callbacks fire on the next
+ *             poll. The progress engine's
+ *             thread calls this
+ *
+ * Callbacks may add more (e.g., post the
+ *   next recieve), and are run outside of
+ *   the loop's lock. run should only be
+ *   called from one thread at a time.
+ *
+ * Request::then is defined here, so
+ *   include this (or l0.hpp) to use it
+*****************************************/
+#ifndef _BEO_EVENT_LOOP_HPP_
+#define _BEO_EVENT_LOOP_HPP_
+
+#if defined _BEO_MPI_
+#include <mpi.h>
+#endif
+
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <utility>
+#include <iterator>
+#include <functional>
+
+#include "def.hpp"
+#include "request.hpp"
+#include "thread_pool.hpp"
+
+namespace beo
+{
+
+class Event_Loop
+{
+    public:
+
+        using callback_t = Request::callback_t;
+
+    protected:
+
+        struct Event
+        {
+            Request    request;
+
+            callback_t callback;
+        };
+
+        std::mutex         mutex_;
+
+        std::vector<Event> events_;
+
+        size_t             num_fired_{0};
+
+        //events taken out by wait_any while it blocks
+        size_t             num_waiting_{0};
+
+        std::vector<Event> take_complete();
+
+        void wait_any();
+
+    public:
+
+        Event_Loop() {}
+
+        Event_Loop(const Event_Loop& other) = delete;
+
+        Event_Loop& operator=(const Event_Loop& other) = delete;
+
+        void add(Request&& request, callback_t&& callback);
+
+        size_t poll();
+
+        int run();
+
+        size_t test();
+
+        size_t num_pending();
+
+        size_t num_fired() const {return num_fired_;}
+};
+
+/*****************************************
+ * add
+*****************************************/
+inline void Event_Loop::add(Request&& request, callback_t&& callback)
+{
+    std::lock_guard<std::mutex> g(mutex_);
+
+    events_.push_back(Event{std::move(request), std::move(callback)});
+}
+
+inline size_t Event_Loop::num_pending()
+{
+    std::lock_guard<std::mutex> g(mutex_);
+
+    return events_.size() + num_waiting_;
+}
+
+/*****************************************
+ * take_complete
+ *
+ * Removes the events whose requests are
+ *   complete, in the order they were added
+*****************************************/
+inline std::vector<Event_Loop::Event> Event_Loop::take_complete()
+{
+    std::lock_guard<std::mutex> g(mutex_);
+
+    std::vector<Event> done;
+
+    size_t num_kept = 0;
+
+    for (size_t idx = 0; idx < events_.size(); idx++)
+    {
+        if (events_[idx].request.is_complete())
+        {
+            done.push_back(std::move(events_[idx]));
+        }
+
+        else
+        {
+            if (num_kept != idx) events_[num_kept] = std::move(events_[idx]);
+            num_kept++;
+        }
+    }
+
+    events_.resize(num_kept);
+
+    return done;
+}
+
+/*****************************************
+ * poll
+ *
+ * Fires the callbacks of the complete
+ *   requests. Returns how many it fired
+*****************************************/
+inline size_t Event_Loop::poll()
+{
+    auto done = take_complete();
+
+    for (auto& event : done)
+    {
+        const int stat = event.request.wait();
+
+        if (event.callback) event.callback(stat);
+    }
+
+    std::lock_guard<std::mutex> g(mutex_);
+
+    num_fired_ += done.size();
+
+    return done.size();
+}
+
+/*****************************************
+ * wait_any
+ *
+ * Blocks until at least one request may
+ *   be complete.
+ *
+ * Under MPI the events are taken out of
+ *   the loop and waited on without its
+ *   lock, so other threads can still add
+ *   (e.g., post the send that completes
+ *   one of them) and poll. They are put
+ *   back afterwards, ahead of any added
+ *   meanwhile
+*****************************************/
+inline void Event_Loop::wait_any()
+{
+    #if defined _BEO_MPI_
+
+    std::vector<Event> waiting;
+
+    {
+        std::lock_guard<std::mutex> g(mutex_);
+
+        if (events_.empty()) return;
+
+        waiting.swap(events_);
+
+        num_waiting_ += waiting.size();
+    }
+
+    std::vector<MPI_Request> requests(waiting.size());
+    for (size_t idx = 0; idx < waiting.size(); idx++) requests[idx] = waiting[idx].request.request();
+
+    std::vector<int> indices(requests.size());
+    int num_done;
+
+    {
+        Counter_Timer timer(beo::counters(), Counters::Time::wait);
+
+        MPI_Waitsome((int) requests.size(), requests.data(), &num_done, indices.data(), MPI_STATUSES_IGNORE);
+    }
+
+    //completed requests are now MPI_REQUEST_NULL, so poll will see them
+    for (size_t idx = 0; idx < waiting.size(); idx++) waiting[idx].request.request() = requests[idx];
+
+    std::lock_guard<std::mutex> g(mutex_);
+
+    num_waiting_ -= waiting.size();
+
+    events_.insert(events_.begin(),
+                   std::make_move_iterator(waiting.begin()),
+                   std::make_move_iterator(waiting.end()));
+
+    #else
+
+    if (beo::thread_pool().run_one()) return;
+
+    std::lock_guard<std::mutex> g(mutex_);
+
+    if (events_.empty()) return;
+
+    auto& request = events_.front().request.request();
+
+    if (request.valid()) request.wait_for(std::chrono::microseconds(100));
+
+    #endif
+}
+
+/*****************************************
+ * test
+ *
+ * Tests every request without firing any
+ *   callbacks. Under the lock, so it is
+ *   safe next to poll from other threads.
+ *   Returns how many it completed, which
+ *   is always 0 outside of MPI
+*****************************************/
+inline size_t Event_Loop::test()
+{
+    #if defined _BEO_MPI_
+
+    std::lock_guard<std::mutex> g(mutex_);
+
+    if (events_.empty()) return 0;
+
+    std::vector<MPI_Request> requests(events_.size());
+    for (size_t idx = 0; idx < events_.size(); idx++) requests[idx] = events_[idx].request.request();
+
+    std::vector<int> indices(requests.size());
+    int num_done;
+
+    MPI_Testsome((int) requests.size(), requests.data(), &num_done, indices.data(), MPI_STATUSES_IGNORE);
+
+    //completed requests are now MPI_REQUEST_NULL, so poll will see them
+    for (size_t idx = 0; idx < events_.size(); idx++) events_[idx].request.request() = requests[idx];
+
+    //MPI_UNDEFINED if they were all complete already
+    return (num_done > 0) ? (size_t) num_done : 0;
+
+    #else
+
+    return 0;
+
+    #endif
+}
+
+/*****************************************
+ * run
+ *
+ * Fires callbacks until there are none
+ *   left, including ones added by the
+ *   callbacks themselves
+*****************************************/
+inline int Event_Loop::run()
+{
+    while (num_pending() > 0)
+    {
+        if (0 == poll()) wait_any();
+    }
+
+    return BEO_SUCCESS;
+}
+
+/*****************************************
+ * event_loop registration
+ *
+ * The registered loop is used if there
+ *   is one, otherwise a default one
+*****************************************/
+inline Event_Loop*& registered_event_loop()
+{
+    #if defined _BEO_THREADS_
+
+    static thread_local Event_Loop* loop = nullptr;
+
+    #else
+
+    static Event_Loop* loop = nullptr;
+
+    #endif
+
+    return loop;
+}
+
+inline void set_event_loop(Event_Loop* loop)
+{
+    registered_event_loop() = loop;
+}
+
+inline Event_Loop& event_loop()
+{
+    Event_Loop* loop = registered_event_loop();
+
+    if (nullptr != loop) return *loop;
+
+    static Event_Loop default_loop;
+
+    return default_loop;
+}
+
+/*****************************************
+ * Request::then
+ *
+ * Hands the request to the event loop,
+ *   which calls callback(stat) once it
+ *   completes. The request is moved from
+*****************************************/
+inline void Request::then(callback_t&& callback)
+{
+    beo::event_loop().add(std::move(*this), std::move(callback));
+}
+
+} //end namespace beo
+
+#endif
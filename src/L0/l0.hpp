@@ -16,13 +16,22 @@
 
 #include "def.hpp"
 #include "utility.hpp"
+#include "datatype.hpp"
+#include "simd.hpp"
 #include "chunk_tag.hpp"
 #include "chunk_tag_hash.hpp"
 #include "chunk.hpp"
 #include "info.hpp"
+#include "thread_pool.hpp"
+#include "trace.hpp"
+#include "counters.hpp"
 #include "comm.hpp"
 #include "request.hpp"
+#include "event_loop.hpp"
 #include "shared_file.hpp"
 #include "ops.hpp"
+#include "sub_block.hpp"
+#include "chunk_transfer.hpp"
+#include "termination_detector.hpp"
 
 #endif
@@ -9,8 +9,20 @@
  *
  * Included here:
  *	barrier 
+ *      async_barrier
+ *      fuzzy_barrier
  *      send_recieve
  *      async_send_recieve
+ *      broadcast
+ *      reduce
+ *      allreduce
+ *      async_allreduce
+ *      allgather
+ *
+ * The collectives here are flat, over a 
+ *   single beo::Comm. See 
+ *   Enviroment/collectives.hpp for the
+ *   node-aware versions over beo::Comms
 *****************************************/
 #ifndef _BEO_L0_OPS_HPP
 #define _BEO_L0_OPS_HPP
@@ -20,11 +32,17 @@
 #endif
 
 #include <future>
+#include <vector>
+#include <algorithm>
 
 #include "def.hpp"
 #include "utility.hpp"
 #include "request.hpp"
 #include "comm.hpp"
+#include "thread_pool.hpp"
+#include "datatype.hpp"
+#include "trace.hpp"
+#include "counters.hpp"
 
 namespace beo
 {
@@ -37,6 +55,13 @@ void check_task_id(Comm& comm, int task_id);
 //   this barrier is called. 
 int barrier(Comm& comm);
 
+//Nonblocking barrier, complete once every task has entered it
+Request async_barrier(Comm& comm);
+
+//Barrier that calls work() while it waits, see below
+template<typename F>
+int fuzzy_barrier(Comm& comm, F&& work);
+
 //two-way blocking send/recieve
 int send_recv(Comm& comm,
               void*       dest, 
@@ -55,15 +80,65 @@ Request async_send_recv(Comm& comm,
                         int         src_id,
                         int         tag);              
 
+//broadcast bytes of buf from root to all tasks
+int broadcast(Comm& comm,
+              void*       buf,
+              size_t      bytes,
+              int         root);
+
+//in-place reduction of buf onto root
+template<typename T>
+int reduce(Comm& comm,
+           T*          buf,
+           size_t      count,
+           Op          op,
+           int         root);
+
+//in-place reduction of buf onto all tasks
+template<typename T>
+int allreduce(Comm& comm,
+              T*          buf,
+              size_t      count,
+              Op          op);
+
+//nonblocking allreduce, buf must not be touched until the request is complete
+template<typename T>
+Request async_allreduce(Comm& comm,
+                        T*          buf,
+                        size_t      count,
+                        Op          op);
+
+//gather bytes of src from every task into dest, ordered by task id
+int allgather(Comm& comm,
+              void*       dest,
+              const void* src,
+              size_t      bytes);
+
 /*****************************************
  * creates a barrier on the beo::Comm 
 *****************************************/
 inline int barrier(Comm& comm)
 {
+    BEO_TRACE(barrier, -1, -1, 0);
+
+    Counter_Timer timer(beo::counters(), Counters::Time::barrier);
+
     #if defined _BEO_MPI_
 
     return MPI_Barrier(comm.comm()) == MPI_SUCCESS ? BEO_SUCCESS : BEO_FAIL;
 
+    #elif defined _BEO_THREADS_
+
+    if (nullptr == comm.group()) return BEO_SUCCESS;
+
+    return comm.group()->barrier(comm.context());
+
+    #elif defined _BEO_SHM_
+
+    if (nullptr == comm.transport()) return BEO_SUCCESS;
+
+    return comm.transport()->barrier(comm.ranks(), comm.context(), comm.task_id());
+
     #else 
 
     return BEO_SUCCESS;
@@ -71,6 +146,73 @@ inline int barrier(Comm& comm)
     #endif
 }
 
+/****************************************
+ * async_barrier
+ *
+ * As barrier, but returns a Request that
+ *   completes once every task has entered
+ *   the barrier. Outside of MPI the
+ *   barrier runs on the thread pool, so
+ *   no other collective may be made on
+ *   comm until it is complete
+*****************************************/
+inline Request async_barrier(Comm& comm)
+{
+    BEO_TRACE(async_barrier, -1, -1, 0);
+
+    #if defined _BEO_MPI_
+
+    MPI_Request fake;
+
+    int tmp = MPI_Ibarrier(comm.comm(), &fake);
+
+    if (MPI_SUCCESS != tmp) exit(1);
+
+    Request request = std::move(fake);
+
+    return request;
+
+    #else
+
+    Comm* ptr = &comm;
+
+    Request request = beo::thread_pool().submit([=]()
+    {
+        return beo::barrier(*ptr);
+    });
+
+    return request;
+
+    #endif
+}
+
+/****************************************
+ * fuzzy_barrier
+ *
+ * Enters the barrier, then calls work()
+ *   until the other tasks have entered it
+ *   too. work() returns false once this 
+ *   task is out of local work, after 
+ *   which this blocks as barrier does. 
+ *   e.g.,
+ *
+ *     beo::fuzzy_barrier(comm, [&]() {return beo::event_loop().poll() > 0;});
+ *
+ * work() may not make collectives on comm
+*****************************************/
+template<typename F>
+inline int fuzzy_barrier(Comm& comm, F&& work)
+{
+    Request request = async_barrier(comm);
+
+    while (!request.is_complete())
+    {
+        if (!work()) break;
+    }
+
+    return request.wait();
+}
+
 /****************************************
  * send_recv 
  *
@@ -102,6 +244,12 @@ inline int send_recv(Comm& comm,
         printf("beo::send_recv Task %d input src_id(%d) is invalid\n", comm.task_id(), src_id);
         exit(1);
     }
+
+    BEO_TRACE_IF(comm.task_id() == src_id || comm.task_id() == dest_id,
+                 send_recv, (comm.task_id() == src_id) ? dest_id : src_id, tag, bytes);
+
+    beo::counters().message(comm.task_id(), dest_id, src_id, bytes);
+
     #if defined _BEO_MPI_
 
     //MPI-case where both sender and reciever are same task on same comm
@@ -142,6 +290,52 @@ inline int send_recv(Comm& comm,
         return BEO_SUCCESS;
     }
 
+    //Threads case, the sender and reciever each wait for the copy
+    #elif defined _BEO_THREADS_
+
+    if (src_id == dest_id && comm.task_id() == src_id)
+    {
+       return beo::memmove(dest, src, bytes);
+    }
+
+    else if (comm.task_id() == src_id)
+    {
+        return comm.group()->send(comm.context(), src_id, dest_id, tag, src, bytes).get();
+    }
+
+    else if (comm.task_id() == dest_id)
+    {
+        return comm.group()->recv(comm.context(), src_id, dest_id, tag, dest, bytes).get();
+    }
+
+    else
+    {
+        return BEO_SUCCESS;
+    }
+
+    //Shared-memory case, the sender waits until the data is in the ring
+    #elif defined _BEO_SHM_
+
+    if (src_id == dest_id && comm.task_id() == src_id)
+    {
+       return beo::memmove(dest, src, bytes);
+    }
+
+    else if (comm.task_id() == src_id)
+    {
+        return comm.transport()->send(comm.context(), comm.rank_of(dest_id), tag, src, bytes).get();
+    }
+
+    else if (comm.task_id() == dest_id)
+    {
+        return comm.transport()->recv(comm.context(), comm.rank_of(src_id), tag, dest, bytes).get();
+    }
+
+    else
+    {
+        return BEO_SUCCESS;
+    }
+
     //non-MPI case
     #else
 
@@ -176,6 +370,11 @@ inline Request async_send_recv(Comm& comm,
         printf("beo::send_recv Task %d input src_id(%d) is invalid\n", comm.task_id(), src_id);
         exit(1);
     }
+
+    BEO_TRACE_IF(comm.task_id() == src_id || comm.task_id() == dest_id,
+                 async_send_recv, (comm.task_id() == src_id) ? dest_id : src_id, tag, bytes);
+
+    beo::counters().message(comm.task_id(), dest_id, src_id, bytes);
     
     #if defined _BEO_MPI_
 
@@ -234,10 +433,62 @@ inline Request async_send_recv(Comm& comm,
         return request; 
     }
 
+    //Threads case
+    #elif defined _BEO_THREADS_
+
+    if (src_id == dest_id && comm.task_id() == src_id)
+    {
+        beo::memmove(dest, src, bytes);
+        return Request();
+    }
+
+    else if (comm.task_id() == src_id)
+    {
+        Request request = comm.group()->send(comm.context(), src_id, dest_id, tag, src, bytes);
+        return request; 
+    }
+
+    else if (comm.task_id() == dest_id)
+    {
+        Request request = comm.group()->recv(comm.context(), src_id, dest_id, tag, dest, bytes);
+        return request; 
+    }
+
+    else
+    {
+        return Request();
+    }
+
+    //Shared-memory case
+    #elif defined _BEO_SHM_
+
+    if (src_id == dest_id && comm.task_id() == src_id)
+    {
+        beo::memmove(dest, src, bytes);
+        return Request();
+    }
+
+    else if (comm.task_id() == src_id)
+    {
+        Request request = comm.transport()->send(comm.context(), comm.rank_of(dest_id), tag, src, bytes);
+        return request; 
+    }
+
+    else if (comm.task_id() == dest_id)
+    {
+        Request request = comm.transport()->recv(comm.context(), comm.rank_of(src_id), tag, dest, bytes);
+        return request; 
+    }
+
+    else
+    {
+        return Request();
+    }
+
     //non-MPI case
     #else
 
-    Request request = std::async(std::launch::async, [=]()
+    Request request = beo::thread_pool().submit([=]()
     {
         return beo::memmove(dest, src, bytes);
     });
@@ -246,7 +497,336 @@ inline Request async_send_recv(Comm& comm,
     #endif
 }
 
+/****************************************
+ * broadcast
+ *
+ * Broadcasts bytes of buf from the root
+ *   task to all others 
+****************************************/
+inline int broadcast(Comm& comm,
+                     void*       buf,
+                     size_t      bytes,
+                     int         root)
+{
+    if (root >= comm.num_tasks())
+    {
+        printf("beo::broadcast Task %d input root(%d) is invalid\n", comm.task_id(), root);
+        exit(1);
+    }
+
+    BEO_TRACE(broadcast, root, -1, bytes);
+
+    #if defined _BEO_MPI_
+
+    int tmp = MPI_Bcast(buf,
+                        bytes,
+                        MPI_CHAR,
+                        root,
+                        comm.comm());
+
+    return (MPI_SUCCESS == tmp) ? BEO_SUCCESS : BEO_FAIL; 
+
+    #elif defined _BEO_THREADS_
+
+    if (nullptr == comm.group()) return BEO_SUCCESS;
+
+    const auto& slots = comm.group()->exchange(comm.context(), comm.task_id(), buf);
+
+    if (comm.task_id() != root) beo::memmove(buf, slots[root], bytes);
+
+    return comm.group()->barrier(comm.context());
 
+    #elif defined _BEO_SHM_
+
+    if (nullptr == comm.transport()) return BEO_SUCCESS;
+
+    return comm.transport()->broadcast(comm.ranks(), comm.context(), comm.task_id(), buf, bytes, root);
+
+    #else
+
+    (void) buf;
+    (void) bytes;
+
+    return BEO_SUCCESS;
+
+    #endif
+}
+
+/****************************************
+ * reduce
+ *
+ * In-place reduction of count elements of
+ *   buf with op. Only the root's buf holds 
+ *   the result, other tasks' are unchanged
+****************************************/
+template<typename T>
+inline int reduce(Comm& comm,
+                  T*          buf,
+                  size_t      count,
+                  Op          op,
+                  int         root)
+{
+    if (root >= comm.num_tasks())
+    {
+        printf("beo::reduce Task %d input root(%d) is invalid\n", comm.task_id(), root);
+        exit(1);
+    }
+
+    BEO_TRACE(reduce, root, -1, count * sizeof(T));
+
+    #if defined _BEO_MPI_
+
+    int tmp = MPI_Reduce((comm.task_id() == root) ? MPI_IN_PLACE : buf,
+                         buf,
+                         count,
+                         Datatype<T>::type(),
+                         mpi_op(op),
+                         root,
+                         comm.comm());
+
+    return (MPI_SUCCESS == tmp) ? BEO_SUCCESS : BEO_FAIL; 
+
+    #elif defined _BEO_THREADS_
+
+    if (nullptr == comm.group()) return BEO_SUCCESS;
+
+    const auto& slots = comm.group()->exchange(comm.context(), comm.task_id(), buf);
+
+    if (comm.task_id() == root)
+    {
+        for (int task = 0; task < comm.num_tasks(); task++)
+        {
+            if (task != root) apply_op<T>(op, buf, (const T*) slots[task], count);
+        }
+    }
+
+    return comm.group()->barrier(comm.context());
+
+    #elif defined _BEO_SHM_
+
+    if (nullptr == comm.transport()) return BEO_SUCCESS;
+
+    const bool is_root = (comm.task_id() == root);
+
+    std::vector<T> all(is_root ? count * comm.num_tasks() : 0);
+
+    int stat = comm.transport()->gather(comm.ranks(), comm.context(), comm.task_id(),
+                                        all.data(), buf, count * sizeof(T), root);
+
+    if (is_root)
+    {
+        for (int task = 0; task < comm.num_tasks(); task++)
+        {
+            if (task != root) apply_op<T>(op, buf, all.data() + task * count, count);
+        }
+    }
+
+    return stat;
+
+    #else
+
+    (void) buf;
+    (void) count;
+    (void) op;
+
+    return BEO_SUCCESS;
+
+    #endif
+}
+
+/****************************************
+ * allreduce
+ *
+ * In-place reduction of count elements of
+ *   buf with op, with the result on every 
+ *   task
+****************************************/
+template<typename T>
+inline int allreduce(Comm& comm,
+                     T*          buf,
+                     size_t      count,
+                     Op          op)
+{
+    BEO_TRACE(allreduce, -1, -1, count * sizeof(T));
+
+    #if defined _BEO_MPI_
+
+    int tmp = MPI_Allreduce(MPI_IN_PLACE,
+                            buf,
+                            count,
+                            Datatype<T>::type(),
+                            mpi_op(op),
+                            comm.comm());
+
+    return (MPI_SUCCESS == tmp) ? BEO_SUCCESS : BEO_FAIL; 
+
+    #elif defined _BEO_THREADS_
+
+    if (nullptr == comm.group()) return BEO_SUCCESS;
+
+    const auto& slots = comm.group()->exchange(comm.context(), comm.task_id(), buf);
+
+    //every task reduces in the same order, so all get identical results
+    std::vector<T> result((const T*) slots[0], (const T*) slots[0] + count);
+
+    for (int task = 1; task < comm.num_tasks(); task++)
+    {
+        apply_op<T>(op, result.data(), (const T*) slots[task], count);
+    }
+
+    comm.group()->barrier(comm.context());
+
+    std::copy(result.begin(), result.end(), buf);
+
+    return comm.group()->barrier(comm.context());
+
+    #elif defined _BEO_SHM_
+
+    //reduce onto task 0 in task order, then share the result
+    if (nullptr == comm.transport()) return BEO_SUCCESS;
+
+    const bool is_root = comm.is_master();
+
+    std::vector<T> all(is_root ? count * comm.num_tasks() : 0);
+
+    int stat = comm.transport()->gather(comm.ranks(), comm.context(), comm.task_id(),
+                                        all.data(), buf, count * sizeof(T), 0);
+
+    if (is_root)
+    {
+        for (int task = 1; task < comm.num_tasks(); task++)
+        {
+            apply_op<T>(op, all.data(), all.data() + task * count, count);
+        }
+
+        std::copy(all.begin(), all.begin() + count, buf);
+    }
+
+    stat |= comm.transport()->broadcast(comm.ranks(), comm.context(), comm.task_id(),
+                                        buf, count * sizeof(T), 0);
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+
+    #else
+
+    (void) comm;
+    (void) buf;
+    (void) count;
+    (void) op;
+
+    return BEO_SUCCESS;
+
+    #endif
+}
+
+/****************************************
+ * async_allreduce
+ *
+ * As allreduce, but returns a Request.
+ *   Outside of MPI the allreduce runs on
+ *   the thread pool, so no other
+ *   collective may be made on comm until
+ *   it is complete (use a copy of the comm)
+****************************************/
+template<typename T>
+inline Request async_allreduce(Comm& comm,
+                               T*          buf,
+                               size_t      count,
+                               Op          op)
+{
+    BEO_TRACE(async_allreduce, -1, -1, count * sizeof(T));
+
+    #if defined _BEO_MPI_
+
+    MPI_Request fake;
+
+    int tmp = MPI_Iallreduce(MPI_IN_PLACE,
+                             buf,
+                             count,
+                             Datatype<T>::type(),
+                             mpi_op(op),
+                             comm.comm(),
+                             &fake);
+
+    if (MPI_SUCCESS != tmp) exit(1);
+
+    Request request = std::move(fake);
+
+    return request;
+
+    #else
+
+    Comm* ptr = &comm;
+
+    Request request = beo::thread_pool().submit([=]()
+    {
+        return beo::allreduce(*ptr, buf, count, op);
+    });
+
+    return request;
+
+    #endif
+}
+
+/****************************************
+ * allgather
+ *
+ * Gathers bytes of src from every task
+ *   into dest, which must hold 
+ *   bytes * num_tasks
+****************************************/
+inline int allgather(Comm& comm,
+                     void*       dest,
+                     const void* src,
+                     size_t      bytes)
+{
+    BEO_TRACE(allgather, -1, -1, bytes);
+
+    #if defined _BEO_MPI_
+
+    int tmp = MPI_Allgather(src,
+                            bytes,
+                            MPI_CHAR,
+                            dest,
+                            bytes,
+                            MPI_CHAR,
+                            comm.comm());
+
+    return (MPI_SUCCESS == tmp) ? BEO_SUCCESS : BEO_FAIL; 
+
+    #elif defined _BEO_THREADS_
+
+    if (nullptr == comm.group()) return beo::memmove(dest, src, bytes);
+
+    const auto& slots = comm.group()->exchange(comm.context(), comm.task_id(), src);
+
+    for (int task = 0; task < comm.num_tasks(); task++)
+    {
+        beo::memmove((char*) dest + task * bytes, slots[task], bytes);
+    }
+
+    return comm.group()->barrier(comm.context());
+
+    #elif defined _BEO_SHM_
+
+    if (nullptr == comm.transport()) return beo::memmove(dest, src, bytes);
+
+    int stat = comm.transport()->gather(comm.ranks(), comm.context(), comm.task_id(),
+                                        dest, src, bytes, 0);
+
+    stat |= comm.transport()->broadcast(comm.ranks(), comm.context(), comm.task_id(),
+                                        dest, comm.num_tasks() * bytes, 0);
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+
+    #else
+
+    (void) comm;
+
+    return beo::memmove(dest, src, bytes);
+
+    #endif
+}
 
 }//end namespace beo
 
@@ -16,9 +16,13 @@
 #endif
 
 #include <future>
+#include <functional>
 
 #include "def.hpp"
 #include "comm.hpp"
+#include "thread_pool.hpp"
+#include "trace.hpp"
+#include "counters.hpp"
 
 namespace beo
 {
@@ -37,10 +41,20 @@ class Request
 
         #endif
 
+        using callback_t = std::function<void(int)>;
+
     protected:
 
+        #if defined _BEO_MPI_
+
+        request_t request_{MPI_REQUEST_NULL};
+
+        #else
+
         request_t request_;
 
+        #endif
+
     public:
 
         //Constructors
@@ -65,6 +79,9 @@ class Request
         int wait();
 
         void finalize();
+
+        //Calls callback(stat) from the event loop once complete (see event_loop.hpp)
+        void then(callback_t&& callback);
 };
 
 /*****************************************
@@ -87,11 +104,19 @@ inline void Request::finalize()
  * wait
  *
  * Waits for the request to be complete. 
+ *
+ * In the non-MPI case, the waiting thread 
+ *   helps run queued thread pool tasks 
+ *   until the request is ready
 *****************************************/
 inline int Request::wait()
 {
     if (is_valid())
     {
+        BEO_TRACE(wait, -1, -1, 0);
+
+        Counter_Timer timer(beo::counters(), Counters::Time::wait);
+
         #if defined _BEO_MPI_
 
 
@@ -100,9 +125,13 @@ inline int Request::wait()
 
         #else
 
-        request_.get();
+        while (std::future_status::ready != 
+               request_.wait_for(std::chrono::seconds(0)))
+        {
+            if (!beo::thread_pool().run_one()) request_.wait();
+        }
 
-        return BEO_SUCCESS;
+        return request_.get();
 
         #endif
     }
@@ -133,7 +162,8 @@ inline bool Request::is_complete()
    
     #else
 
-    return !request_.valid();
+    return !request_.valid() || 
+           std::future_status::ready == request_.wait_for(std::chrono::seconds(0));
 
     #endif
 }
@@ -157,15 +187,29 @@ inline bool Request::is_valid()
 }
 /*****************************************
  * Constructors
+ *
+ * The request moved from is left null, so
+ *   it is never waited on twice
 *****************************************/
 inline Request::Request(request_t&& other)
 {
     request_ = std::move(other);
+
+    #if defined _BEO_MPI_
+    other = MPI_REQUEST_NULL;
+    #endif
 }
 
 inline Request::Request(Request&& other)
 {
-    if (&other != this) request_ = std::move(other.request_);
+    if (&other != this)
+    {
+        request_ = std::move(other.request_);
+
+        #if defined _BEO_MPI_
+        other.request_ = MPI_REQUEST_NULL;
+        #endif
+    }
 }
 
 /*****************************************
@@ -174,13 +218,24 @@ inline Request::Request(Request&& other)
 inline Request& Request::operator=(request_t&& other)
 {
     request_ = std::move(other);
+
+    #if defined _BEO_MPI_
+    other = MPI_REQUEST_NULL;
+    #endif
+
     return *this;
 }
 
 inline Request& Request::operator=(Request&& other)
 {
     if (&other == this) return *this;
+
     request_ = std::move(other.request_);
+
+    #if defined _BEO_MPI_
+    other.request_ = MPI_REQUEST_NULL;
+    #endif
+
     return *this;
 }
 
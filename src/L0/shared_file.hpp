@@ -36,6 +36,10 @@
 #include "def.hpp"
 #include "comm.hpp"
 #include "request.hpp"
+#include "thread_pool.hpp"
+#include "ops.hpp"
+#include "trace.hpp"
+#include "counters.hpp"
 
 namespace beo
 {
@@ -163,6 +167,8 @@ inline Request Shared_File::async_read_at(const BEO_OFF_T off,
                                    void* buf, 
                                    const size_t bytes)
 {
+    BEO_TRACE(file_async_read_at, -1, -1, bytes);
+
     #if defined _BEO_MPI_
     
     MPI_Request fake;
@@ -174,14 +180,20 @@ inline Request Shared_File::async_read_at(const BEO_OFF_T off,
                                  MPI_CHAR, 
                                  &fake);
 
+    beo::counters().file_read(bytes);
+
     Request request = std::move(fake);
   
     return request;
 
     #else
 
-    Request request = std::async(std::launch::async, [=]()
+    //counted by read_at, on the counters of this task
+    Counters* counters = &beo::counters();
+
+    Request request = beo::thread_pool().submit([this, counters, off, buf, bytes]()
     {
+        beo::adopt_counters(counters);
         return read_at(off, buf, bytes);
     });
  
@@ -200,6 +212,8 @@ inline Request Shared_File::async_write_at(const BEO_OFF_T off,
                                     const void* buf, 
                                     const size_t bytes)
 {
+    BEO_TRACE(file_async_write_at, -1, -1, bytes);
+
     #if defined _BEO_MPI_
     
     MPI_Request fake;
@@ -211,14 +225,20 @@ inline Request Shared_File::async_write_at(const BEO_OFF_T off,
                                   MPI_CHAR, 
                                   &fake);
 
+    beo::counters().file_written(bytes);
+
     Request request = std::move(fake);
   
     return request;
 
     #else
 
-    Request request = std::async(std::launch::async, [=]()
+    //counted by write_at, on the counters of this task
+    Counters* counters = &beo::counters();
+
+    Request request = beo::thread_pool().submit([this, counters, off, buf, bytes]()
     {
+        beo::adopt_counters(counters);
         return write_at(off, buf, bytes);
     });
  
@@ -243,6 +263,8 @@ inline Request Shared_File::async_read_at_all(const BEO_OFF_T off,
                                        void* buf, 
                                        const size_t bytes)
 {
+    BEO_TRACE(file_async_read_at_all, -1, -1, bytes);
+
     #if defined _BEO_MPI_
     
     MPI_Request fake;
@@ -254,14 +276,20 @@ inline Request Shared_File::async_read_at_all(const BEO_OFF_T off,
                                      MPI_CHAR, 
                                      &fake);
 
+    beo::counters().file_read(bytes);
+
     Request request = std::move(fake);
   
     return request;
 
     #else
 
-    Request request = std::async(std::launch::async, [=]()
+    //counted by read_at_all, on the counters of this task
+    Counters* counters = &beo::counters();
+
+    Request request = beo::thread_pool().submit([this, counters, off, buf, bytes]()
     {
+        beo::adopt_counters(counters);
         return read_at_all(off, buf, bytes);
     });
  
@@ -286,6 +314,8 @@ inline Request Shared_File::async_write_at_all(const BEO_OFF_T off,
                                         const void* buf, 
                                         const size_t bytes)
 {
+    BEO_TRACE(file_async_write_at_all, -1, -1, bytes);
+
     #if defined _BEO_MPI_
     
     MPI_Request fake;
@@ -297,14 +327,20 @@ inline Request Shared_File::async_write_at_all(const BEO_OFF_T off,
                                       MPI_CHAR, 
                                       &fake);
 
+    beo::counters().file_written(bytes);
+
     Request request = std::move(fake);
   
     return request;
 
     #else
 
-    Request request = std::async(std::launch::async, [=]()
+    //counted by write_at_all, on the counters of this task
+    Counters* counters = &beo::counters();
+
+    Request request = beo::thread_pool().submit([this, counters, off, buf, bytes]()
     {
+        beo::adopt_counters(counters);
         return write_at_all(off, buf, bytes);
     });
  
@@ -327,6 +363,10 @@ inline int Shared_File::read_at(const BEO_OFF_T off,
                          void* buf,
                          const size_t bytes)
 {
+    BEO_TRACE(file_read_at, -1, -1, bytes);
+
+    beo::counters().file_read(bytes);
+
     std::lock_guard<mutex_t> g(m);
 
     #if defined _BEO_MPI_
@@ -370,6 +410,10 @@ inline int Shared_File::write_at(const BEO_OFF_T off,
                           const void* buf,
                           const size_t bytes)
 {
+    BEO_TRACE(file_write_at, -1, -1, bytes);
+
+    beo::counters().file_written(bytes);
+
 
     std::lock_guard<mutex_t> g(m);
 
@@ -421,6 +465,10 @@ inline int Shared_File::read_at_all(const BEO_OFF_T off,
                              void* buf,
                              const size_t bytes)
 {
+    BEO_TRACE(file_read_at_all, -1, -1, bytes);
+
+    beo::counters().file_read(bytes);
+
     std::lock_guard<mutex_t> g(m);
 
     #if defined _BEO_MPI_
@@ -463,6 +511,10 @@ inline int Shared_File::write_at_all(const BEO_OFF_T off,
                               const void* buf,
                               const size_t bytes)
 {
+    BEO_TRACE(file_write_at_all, -1, -1, bytes);
+
+    beo::counters().file_written(bytes);
+
 
     std::lock_guard<mutex_t> g(m);
 
@@ -496,6 +548,10 @@ inline int Shared_File::write_at_all(const BEO_OFF_T off,
 inline int Shared_File::read(void* buf,
                       size_t bytes)
 {
+    BEO_TRACE(file_read, -1, -1, bytes);
+
+    beo::counters().file_read(bytes);
+
 
     #if defined _BEO_MPI_
 
@@ -531,6 +587,10 @@ inline int Shared_File::read(void* buf,
 inline int Shared_File::write(const void* buf,
                        size_t bytes)
 {
+    BEO_TRACE(file_write, -1, -1, bytes);
+
+    beo::counters().file_written(bytes);
+
 
     #if defined _BEO_MPI_
 
@@ -639,15 +699,37 @@ inline int Shared_File::open(Comm& comm, const std::string& mode)
         return BEO_FAIL;
     }
 
+    //is_open_ must agree on every task, as close() is collective
+    is_open_ = (MPI_SUCCESS ==
+                MPI_File_open(comm.comm(),
+                              name_.data(),
+                              mpi_mode,
+                              MPI_INFO_NULL,
+                              &file_));
+
+    mode_    = mode;
+
+    return is_open_ ? BEO_SUCCESS : BEO_FAIL;
+
+    #elif defined _BEO_THREADS_ || defined _BEO_SHM_
+
+    //the master creates (or truncates) the file, and the other
+    //  tasks then open it without truncating
+    const bool is_write = ("w+" == mode || "w" == mode);
+
+    if (comm.is_master() || !is_write) file_ = fopen(name_.data(), mode.data());
+
+    beo::barrier(comm);
+
+    if (!comm.is_master() && is_write) file_ = fopen(name_.data(), "r+");
+
+    beo::barrier(comm);
+
     is_open_ = (nullptr != file_) ? true : false; 
 
-    return (MPI_SUCCESS ==
-            MPI_File_open(comm.comm(), 
-                          name_.data(),
-                          mpi_mode,
-                          MPI_INFO_NULL,
-                          &file_))
-        ? BEO_SUCCESS : BEO_FAIL;
+    mode_    = mode;
+
+    return (nullptr != file_) ? BEO_SUCCESS : BEO_FAIL; 
 
     #else
 
@@ -656,7 +738,7 @@ inline int Shared_File::open(Comm& comm, const std::string& mode)
    
     is_open_ = (nullptr != file_) ? true : false; 
 
-    mode_    = (nullptr != file_) ? true : false;
+    mode_    = mode;
 
     return (nullptr != file_) ? BEO_SUCCESS : BEO_FAIL; 
 
@@ -0,0 +1,1061 @@
+/*****************************************
+ * shm_transport.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Shm_Transport,
+ *   the backend used when beo is built
+ *   with _BEO_SHM_. Separately launched
+ *   processes on one (Linux) host act as
+ *   the tasks, and talk through POSIX
+ *   shared memory with no MPI runtime.
+ *
+ * Each process is told who it is with
+ *   enviroment variables:
+ *      BEO_SHM_SIZE       : number of tasks
+ *      BEO_SHM_RANK       : this task's id
+ *      BEO_SHM_NAME       : name of the run,
+ *                           unique per run
+ *                           (default "beo")
+ *      BEO_SHM_NONCE      : any string unique
+ *                           to the run, which
+ *                           the tasks check
+ *                           the segment with
+ *      BEO_SHM_RING_BYTES : bytes per ring
+ *                           (default 256 KiB)
+ *      BEO_SHM_SPIN       : polls before the
+ *                           progress thread
+ *                           sleeps (default
+ *                           1000)
+ *   examples/shm_run.sh sets these up. With
+ *   BEO_SHM_SIZE unset (or 1) beo runs as
+ *   a single task.
+ *
+ * Task 0 creates one shm_open segment which
+ *   holds a single-producer, single-consumer
+ *   ring buffer for every ordered pair of
+ *   tasks, and a futex doorbell per task.
+ *   The segment is unlinked once everyone
+ *   has attached, so nothing is left behind.
+ *
+ * A run that crashed can still leave a
+ *   segment under its name. Task 0 writes
+ *   the run's nonce into the header just
+ *   before marking it ready, and the other
+ *   tasks only attach to a ready segment
+ *   with their own nonce, so they never
+ *   use a stale one. With neither
+ *   BEO_SHM_NAME nor BEO_SHM_NONCE set,
+ *   there is nothing to tell runs apart,
+ *   and init refuses to start.
+ *
+ * Messages are a header (context, tag,
+ *   bytes) and the payload, streamed
+ *   through the ring, so messages may be
+ *   larger than the ring. A progress
+ *   thread per process moves the data: it
+ *   writes posted sends, and reads arriving
+ *   messages straight into matching posted
+ *   recieves, or into an unexpected queue.
+ *   Writing or reading rings the peer's
+ *   doorbell, and an idle progress thread
+ *   spins briefly and then sleeps on its
+ *   own doorbell.
+ *
+ * Collectives are built from point-to-point
+ *   messages on negative tags, through task
+ *   0 of the comm.
+*****************************************/
+#ifndef _BEO_SHM_TRANSPORT_HPP_
+#define _BEO_SHM_TRANSPORT_HPP_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <future>
+#include <algorithm>
+#include <functional>
+
+#include "def.hpp"
+
+namespace beo
+{
+
+class Shm_Transport
+{
+    public:
+
+        using context_t = uint64_t;
+
+        using mutex_t   = std::mutex;
+
+        using promise_t = std::shared_ptr<std::promise<int>>;
+
+        //run just before the future of a send or recieve is ready
+        using on_done_t = std::function<void()>;
+
+        //tags used by the collectives. User tags must be >= 0
+        static const int barrier_tag   = -1;
+
+        static const int broadcast_tag = -2;
+
+        static const int gather_tag    = -3;
+
+    protected:
+
+        static const uint32_t magic = 0xbe0511;
+
+        struct Header
+        {
+            std::atomic<uint32_t> ready;
+
+            std::atomic<int32_t>  attached;
+
+            int32_t               num_tasks;
+
+            uint64_t              ring_bytes;
+
+            uint64_t              nonce;
+        };
+
+        struct alignas(64) Doorbell
+        {
+            std::atomic<uint32_t> seq;
+
+            std::atomic<uint32_t> sleeping;
+        };
+
+        //the ring's data follows it in the segment
+        struct Ring
+        {
+            alignas(64) std::atomic<uint64_t> head;     //bytes written
+
+            alignas(64) std::atomic<uint64_t> tail;     //bytes read
+        };
+
+        struct Message_Header
+        {
+            context_t context;
+
+            int32_t   tag;
+
+            uint32_t  pad;
+
+            uint64_t  bytes;
+        };
+
+        struct Send
+        {
+            context_t   context;
+
+            int         tag;
+
+            const char* buf;
+
+            size_t      bytes;
+
+            size_t      pos;
+
+            bool        started;
+
+            promise_t   done;
+
+            on_done_t   on_done;
+        };
+
+        struct Recv
+        {
+            context_t context;
+
+            int       src;
+
+            int       tag;
+
+            char*     buf;
+
+            size_t    bytes;
+
+            promise_t done;
+
+            on_done_t on_done;
+        };
+
+        struct Unexpected
+        {
+            context_t         context;
+
+            int               src;
+
+            int               tag;
+
+            std::vector<char> data;
+
+            bool              complete{false};
+
+            bool              claimed{false};
+
+            Recv              recv;
+        };
+
+        //the message being read from each source
+        struct Incoming
+        {
+            bool                        active{false};
+
+            Message_Header              header;
+
+            size_t                      pos{0};
+
+            char*                       dest{nullptr};
+
+            size_t                      dest_bytes{0};
+
+            promise_t                   done;
+
+            on_done_t                   on_done;
+
+            std::shared_ptr<Unexpected> unexpected;
+        };
+
+        std::string                  name_;
+
+        int                          rank_{0};
+
+        int                          num_tasks_{1};
+
+        size_t                       ring_bytes_{0};
+
+        int                          spin_{1000};
+
+        uint64_t                     nonce_{0};
+
+        char*                        map_{nullptr};
+
+        size_t                       map_bytes_{0};
+
+        Header*                      header_{nullptr};
+
+        Doorbell*                    doorbells_{nullptr};
+
+        char*                        rings_{nullptr};
+
+        mutex_t                      mutex_;
+
+        std::vector<std::deque<Send>> sends_;
+
+        std::vector<Incoming>        incoming_;
+
+        std::deque<Recv>             posted_;
+
+        std::list<std::shared_ptr<Unexpected>> unexpected_;
+
+        std::thread                  thread_;
+
+        std::atomic<bool>            stop_{false};
+
+        static std::shared_ptr<Shm_Transport>& world_ptr();
+
+        static int env_int(const char* name, const int def);
+
+        static uint64_t env_nonce();
+
+        Ring& ring(const int src, const int dest);
+
+        char* ring_data(const int src, const int dest) {return (char*) &ring(src, dest) + sizeof(Ring);}
+
+        void copy_in(const int dest, const uint64_t pos, const void* buf, const size_t bytes);
+
+        void copy_out(const int src, const uint64_t pos, void* buf, const size_t bytes);
+
+        void ring_bell(const int task);
+
+        void wait_bell(const uint32_t seq);
+
+        void start(Incoming& in, const int src);
+
+        void finish(Incoming& in);
+
+        bool progress();
+
+        void thread_loop();
+
+        int init();
+
+    public:
+
+        Shm_Transport() {}
+
+       ~Shm_Transport();
+
+        Shm_Transport(const Shm_Transport& other) = delete;
+
+        Shm_Transport& operator=(const Shm_Transport& other) = delete;
+
+        //The transport of this process, nullptr if running as one task
+        static std::shared_ptr<Shm_Transport> world();
+
+        static void finalize_world();
+
+        static std::string base_name();
+
+        //context of the n-th copy of a comm with context parent
+        static context_t child_context(const context_t parent, const uint64_t n);
+
+        int rank() const {return rank_;}
+
+        int num_tasks() const {return num_tasks_;}
+
+        std::future<int> send(const context_t context,
+                              const int dest,
+                              const int tag,
+                              const void* buf,
+                              const size_t bytes,
+                              on_done_t&& on_done = nullptr);
+
+        std::future<int> recv(const context_t context,
+                              const int src,
+                              const int tag,
+                              void* buf,
+                              const size_t bytes,
+                              on_done_t&& on_done = nullptr);
+
+        //collectives over the tasks ranks, where me indexes ranks
+        int barrier(const std::vector<int>& ranks,
+                    const context_t context,
+                    const int me);
+
+        int broadcast(const std::vector<int>& ranks,
+                      const context_t context,
+                      const int me,
+                      void* buf,
+                      const size_t bytes,
+                      const int root);
+
+        //the root's dest holds every task's bytes, in order
+        int gather(const std::vector<int>& ranks,
+                   const context_t context,
+                   const int me,
+                   void* dest,
+                   const void* src,
+                   const size_t bytes,
+                   const int root);
+};
+
+/*****************************************
+ * static helpers
+*****************************************/
+inline std::shared_ptr<Shm_Transport>& Shm_Transport::world_ptr()
+{
+    static std::shared_ptr<Shm_Transport> world;
+    return world;
+}
+
+inline int Shm_Transport::env_int(const char* name, const int def)
+{
+    const char* env = getenv(name);
+
+    return (nullptr != env) ? atoi(env) : def;
+}
+
+/*****************************************
+ * env_nonce
+ *
+ * Hash (FNV-1a) of BEO_SHM_NONCE, or 0 if
+ *   it is not set
+*****************************************/
+inline uint64_t Shm_Transport::env_nonce()
+{
+    const char* env = getenv("BEO_SHM_NONCE");
+
+    if (nullptr == env) return 0;
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (const char* c = env; '\0' != *c; c++) hash = (hash ^ (uint8_t) *c) * 0x100000001b3ULL;
+
+    return hash;
+}
+
+inline std::string Shm_Transport::base_name()
+{
+    const char* env = getenv("BEO_SHM_NAME");
+
+    return (nullptr != env) ? std::string(env) : std::string("beo");
+}
+
+inline Shm_Transport::context_t Shm_Transport::child_context(const context_t parent, const uint64_t n)
+{
+    //splitmix64
+    uint64_t z = parent + n * 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/*****************************************
+ * world
+ *
+ * Attaches to the run on first use
+*****************************************/
+inline std::shared_ptr<Shm_Transport> Shm_Transport::world()
+{
+    auto& world = world_ptr();
+
+    if (nullptr == world && env_int("BEO_SHM_SIZE", 1) > 1)
+    {
+        world = std::make_shared<Shm_Transport>();
+        world->init();
+    }
+
+    return world;
+}
+
+inline void Shm_Transport::finalize_world()
+{
+    world_ptr() = nullptr;
+}
+
+/*****************************************
+ * init
+ *
+ * Task 0 creates the segment, the rest
+ *   wait for it and attach
+*****************************************/
+inline int Shm_Transport::init()
+{
+    name_       = "/" + base_name();
+    num_tasks_  = env_int("BEO_SHM_SIZE", 1);
+    rank_       = env_int("BEO_SHM_RANK", 0);
+    ring_bytes_ = (size_t) env_int("BEO_SHM_RING_BYTES", 262144);
+    spin_       = env_int("BEO_SHM_SPIN", 1000);
+    nonce_      = env_nonce();
+
+    if (rank_ < 0 || rank_ >= num_tasks_)
+    {
+        printf("beo::Shm_Transport::init BEO_SHM_RANK(%d) is invalid for BEO_SHM_SIZE(%d)\n", rank_, num_tasks_);
+        exit(1);
+    }
+
+    if (nullptr == getenv("BEO_SHM_NAME") && nullptr == getenv("BEO_SHM_NONCE"))
+    {
+        printf("beo::Shm_Transport::init set BEO_SHM_NAME or BEO_SHM_NONCE uniquely for each run (see examples/shm_run.sh)\n");
+        exit(1);
+    }
+
+    ring_bytes_ = (std::max(ring_bytes_, (size_t) 4096) + 63) / 64 * 64;
+
+    const size_t ring_stride = sizeof(Ring) + ring_bytes_;
+
+    map_bytes_ = 64 + num_tasks_ * sizeof(Doorbell) + (size_t) num_tasks_ * num_tasks_ * ring_stride;
+
+    void* ptr = MAP_FAILED;
+
+    if (0 == rank_)
+    {
+        shm_unlink(name_.c_str());
+
+        int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+        if (fd < 0 || 0 != ftruncate(fd, (off_t) map_bytes_))
+        {
+            printf("beo::Shm_Transport::init could not create %s\n", name_.c_str());
+            exit(1);
+        }
+
+        ptr = mmap(nullptr, map_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+        ::close(fd);
+
+        if (MAP_FAILED == ptr)
+        {
+            printf("beo::Shm_Transport::init could not map %s\n", name_.c_str());
+            exit(1);
+        }
+
+        header_ = (Header*) ptr;
+
+        header_->num_tasks  = num_tasks_;
+        header_->ring_bytes = ring_bytes_;
+        header_->nonce      = nonce_;
+        header_->attached.store(0);
+        header_->ready.store(magic, std::memory_order_release);
+    }
+
+    else
+    {
+        //wait (up to a minute) for task 0 to create the segment of this run. One
+        //  that is not ready with this run's nonce may be left by an old run, and
+        //  is opened again by name until task 0 has replaced it
+        for (int attempt = 0; attempt < 60000 && MAP_FAILED == ptr; attempt++)
+        {
+            int fd = shm_open(name_.c_str(), O_RDWR, 0600);
+
+            struct stat st;
+            if (fd >= 0 && 0 == fstat(fd, &st) && (size_t) st.st_size == map_bytes_)
+            {
+                ptr = mmap(nullptr, map_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+
+            if (fd >= 0) ::close(fd);
+
+            if (MAP_FAILED != ptr)
+            {
+                header_ = (Header*) ptr;
+
+                if (magic == header_->ready.load(std::memory_order_acquire) && nonce_ == header_->nonce) break;
+
+                munmap(ptr, map_bytes_);
+                ptr = MAP_FAILED;
+            }
+
+            usleep(1000);
+        }
+
+        if (MAP_FAILED == ptr)
+        {
+            printf("beo::Shm_Transport::init task %d could not attach to %s\n", rank_, name_.c_str());
+            exit(1);
+        }
+    }
+
+    map_       = (char*) ptr;
+    header_    = (Header*) map_;
+    doorbells_ = (Doorbell*) (map_ + 64);
+    rings_     = map_ + 64 + num_tasks_ * sizeof(Doorbell);
+
+    if (header_->num_tasks != num_tasks_ || header_->ring_bytes != ring_bytes_)
+    {
+        printf("beo::Shm_Transport::init task %d does not agree with task 0 on the size of %s\n", rank_, name_.c_str());
+        exit(1);
+    }
+
+    header_->attached.fetch_add(1);
+
+    //once everyone is attached the name is no longer needed
+    if (0 == rank_)
+    {
+        while (header_->attached.load() < num_tasks_) usleep(100);
+        shm_unlink(name_.c_str());
+    }
+
+    sends_.resize(num_tasks_);
+    incoming_.resize(num_tasks_);
+
+    thread_ = std::thread(&Shm_Transport::thread_loop, this);
+
+    return BEO_SUCCESS;
+}
+
+/*****************************************
+ * Destructor
+ *
+ * Stops the progress thread and unmaps
+ *   the segment
+*****************************************/
+inline Shm_Transport::~Shm_Transport()
+{
+    if (thread_.joinable())
+    {
+        stop_ = true;
+        ring_bell(rank_);
+        thread_.join();
+    }
+
+    if (nullptr != map_) munmap(map_, map_bytes_);
+}
+
+/*****************************************
+ * ring access
+*****************************************/
+inline Shm_Transport::Ring& Shm_Transport::ring(const int src, const int dest)
+{
+    return *(Ring*) (rings_ + ((size_t) src * num_tasks_ + dest) * (sizeof(Ring) + ring_bytes_));
+}
+
+//copies bytes into the ring to dest, starting at stream position pos
+inline void Shm_Transport::copy_in(const int dest, const uint64_t pos, const void* buf, const size_t bytes)
+{
+    if (0 == bytes) return;
+
+    char*        data  = ring_data(rank_, dest);
+    const size_t start = pos % ring_bytes_;
+    const size_t first = std::min(bytes, ring_bytes_ - start);
+
+    memcpy(data + start, buf, first);
+    if (bytes > first) memcpy(data, (const char*) buf + first, bytes - first);
+}
+
+//copies bytes out of the ring from src, starting at stream position pos
+inline void Shm_Transport::copy_out(const int src, const uint64_t pos, void* buf, const size_t bytes)
+{
+    if (0 == bytes || nullptr == buf) return;
+
+    const char*  data  = ring_data(src, rank_);
+    const size_t start = pos % ring_bytes_;
+    const size_t first = std::min(bytes, ring_bytes_ - start);
+
+    memcpy(buf, data + start, first);
+    if (bytes > first) memcpy((char*) buf + first, data, bytes - first);
+}
+
+/*****************************************
+ * doorbells
+ *
+ * The futex is only woken if its owner
+ *   says it may be asleep
+*****************************************/
+inline void Shm_Transport::ring_bell(const int task)
+{
+    auto& bell = doorbells_[task];
+
+    bell.seq.fetch_add(1);
+
+    if (0 != bell.sleeping.load())
+    {
+        syscall(SYS_futex, (uint32_t*) &bell.seq, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+}
+
+inline void Shm_Transport::wait_bell(const uint32_t seq)
+{
+    auto& bell = doorbells_[rank_];
+
+    bell.sleeping.store(1);
+
+    struct timespec timeout = {0, 1000000};
+
+    syscall(SYS_futex, (uint32_t*) &bell.seq, FUTEX_WAIT, seq, &timeout, nullptr, 0);
+
+    bell.sleeping.store(0);
+}
+
+/*****************************************
+ * send
+ *
+ * Queues the send for the progress thread.
+ *   The future is ready once buf may be
+ *   reused, and on_done, if any, has run
+*****************************************/
+inline std::future<int> Shm_Transport::send(const context_t context,
+                                            const int dest,
+                                            const int tag,
+                                            const void* buf,
+                                            const size_t bytes,
+                                            on_done_t&& on_done)
+{
+    auto done   = std::make_shared<std::promise<int>>();
+    auto future = done->get_future();
+
+    {
+        std::lock_guard<mutex_t> g(mutex_);
+        sends_[dest].push_back({context, tag, (const char*) buf, bytes, 0, false, done, std::move(on_done)});
+    }
+
+    ring_bell(rank_);
+
+    return future;
+}
+
+/*****************************************
+ * recv
+ *
+ * Matches with an unexpected message if
+ *   there is one, otherwise posts the
+ *   recieve. The future is ready once buf
+ *   holds the data, and on_done, if any,
+ *   has run
+*****************************************/
+inline std::future<int> Shm_Transport::recv(const context_t context,
+                                            const int src,
+                                            const int tag,
+                                            void* buf,
+                                            const size_t bytes,
+                                            on_done_t&& on_done)
+{
+    auto done   = std::make_shared<std::promise<int>>();
+    auto future = done->get_future();
+
+    Recv recv{context, src, tag, (char*) buf, bytes, done, std::move(on_done)};
+
+    {
+        std::lock_guard<mutex_t> g(mutex_);
+
+        for (auto itr = unexpected_.begin(); itr != unexpected_.end(); itr++)
+        {
+            auto& msg = **itr;
+
+            if (msg.claimed || msg.context != context || msg.src != src || msg.tag != tag) continue;
+
+            if (msg.complete)
+            {
+                if (!msg.data.empty()) memcpy(buf, msg.data.data(), std::min(bytes, msg.data.size()));
+                unexpected_.erase(itr);
+
+                if (nullptr != recv.on_done) recv.on_done();
+                done->set_value(BEO_SUCCESS);
+            }
+
+            //still arriving, finish will copy it
+            else
+            {
+                msg.claimed = true;
+                msg.recv    = std::move(recv);
+            }
+
+            return future;
+        }
+
+        posted_.push_back(std::move(recv));
+    }
+
+    ring_bell(rank_);
+
+    return future;
+}
+
+/*****************************************
+ * start
+ *
+ * A new message has arrived from src. Read
+ *   it into a posted recieve if one matches,
+ *   otherwise into a new unexpected message
+*****************************************/
+inline void Shm_Transport::start(Incoming& in, const int src)
+{
+    const auto& header = in.header;
+
+    in.active = true;
+    in.pos    = 0;
+
+    for (auto itr = posted_.begin(); itr != posted_.end(); itr++)
+    {
+        if (itr->context == header.context && itr->src == src && itr->tag == header.tag)
+        {
+            in.dest       = itr->buf;
+            in.dest_bytes = std::min((size_t) header.bytes, itr->bytes);
+            in.done       = itr->done;
+            in.on_done    = std::move(itr->on_done);
+            posted_.erase(itr);
+            return;
+        }
+    }
+
+    auto msg = std::make_shared<Unexpected>();
+    msg->context = header.context;
+    msg->src     = src;
+    msg->tag     = header.tag;
+    msg->data.resize(header.bytes);
+
+    unexpected_.push_back(msg);
+
+    in.dest       = msg->data.data();
+    in.dest_bytes = header.bytes;
+    in.unexpected = msg;
+}
+
+/*****************************************
+ * finish
+*****************************************/
+inline void Shm_Transport::finish(Incoming& in)
+{
+    if (nullptr != in.done)
+    {
+        if (nullptr != in.on_done) in.on_done();
+        in.done->set_value(BEO_SUCCESS);
+    }
+
+    else
+    {
+        auto msg = in.unexpected;
+
+        msg->complete = true;
+
+        if (msg->claimed)
+        {
+            if (!msg->data.empty()) memcpy(msg->recv.buf, msg->data.data(), std::min(msg->recv.bytes, msg->data.size()));
+            unexpected_.remove(msg);
+
+            if (nullptr != msg->recv.on_done) msg->recv.on_done();
+            msg->recv.done->set_value(BEO_SUCCESS);
+        }
+    }
+
+    in = Incoming();
+}
+
+/*****************************************
+ * progress
+ *
+ * Writes as much of the queued sends, and
+ *   reads as much of the arriving messages,
+ *   as the rings allow. Returns true if
+ *   anything moved
+*****************************************/
+inline bool Shm_Transport::progress()
+{
+    std::lock_guard<mutex_t> g(mutex_);
+
+    bool moved = false;
+
+    //sends, in order per destination
+    for (int dest = 0; dest < num_tasks_; dest++)
+    {
+        auto& queue = sends_[dest];
+        auto& r     = ring(rank_, dest);
+
+        const uint64_t first = r.head.load(std::memory_order_relaxed);
+        uint64_t       head  = first;
+
+        while (!queue.empty())
+        {
+            auto& send = queue.front();
+
+            size_t space = ring_bytes_ - (size_t) (head - r.tail.load(std::memory_order_acquire));
+
+            if (!send.started)
+            {
+                if (space < sizeof(Message_Header)) break;
+
+                Message_Header header{send.context, send.tag, 0, send.bytes};
+                copy_in(dest, head, &header, sizeof(Message_Header));
+                head  += sizeof(Message_Header);
+                space -= sizeof(Message_Header);
+
+                send.started = true;
+            }
+
+            const size_t bytes = std::min(space, send.bytes - send.pos);
+
+            copy_in(dest, head, send.buf + send.pos, bytes);
+            head     += bytes;
+            send.pos += bytes;
+
+            if (send.pos < send.bytes) break;
+
+            if (nullptr != send.on_done) send.on_done();
+            send.done->set_value(BEO_SUCCESS);
+            queue.pop_front();
+        }
+
+        if (head != first)
+        {
+            r.head.store(head, std::memory_order_release);
+            ring_bell(dest);
+            moved = true;
+        }
+    }
+
+    //arriving messages
+    for (int src = 0; src < num_tasks_; src++)
+    {
+        auto& r  = ring(src, rank_);
+        auto& in = incoming_[src];
+
+        const uint64_t first = r.tail.load(std::memory_order_relaxed);
+        uint64_t       tail  = first;
+
+        while (true)
+        {
+            size_t avail = (size_t) (r.head.load(std::memory_order_acquire) - tail);
+
+            if (!in.active)
+            {
+                if (avail < sizeof(Message_Header)) break;
+
+                copy_out(src, tail, &in.header, sizeof(Message_Header));
+                tail  += sizeof(Message_Header);
+                avail -= sizeof(Message_Header);
+
+                start(in, src);
+            }
+
+            const size_t bytes = std::min(avail, (size_t) in.header.bytes - in.pos);
+
+            //only the part that fits in the recieve is kept
+            const size_t keep = (in.pos < in.dest_bytes) ? std::min(bytes, in.dest_bytes - in.pos) : 0;
+
+            copy_out(src, tail, in.dest + in.pos, keep);
+            tail   += bytes;
+            in.pos += bytes;
+
+            if (in.pos < in.header.bytes) break;
+
+            finish(in);
+        }
+
+        if (tail != first)
+        {
+            r.tail.store(tail, std::memory_order_release);
+            ring_bell(src);
+            moved = true;
+        }
+    }
+
+    return moved;
+}
+
+/*****************************************
+ * thread_loop
+ *
+ * Runs progress until stopped, sleeping on
+ *   the doorbell when there is nothing to do
+*****************************************/
+inline void Shm_Transport::thread_loop()
+{
+    int idle = 0;
+
+    while (true)
+    {
+        const uint32_t seq = doorbells_[rank_].seq.load();
+
+        if (progress())
+        {
+            idle = 0;
+            continue;
+        }
+
+        if (stop_) break;
+
+        if (++idle < spin_)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        wait_bell(seq);
+
+        idle = 0;
+    }
+}
+
+/*****************************************
+ * barrier
+ *
+ * Everyone checks in with ranks[0], which
+ *   then releases them
+*****************************************/
+inline int Shm_Transport::barrier(const std::vector<int>& ranks,
+                                  const context_t context,
+                                  const int me)
+{
+    const int n = (int) ranks.size();
+
+    std::vector<std::future<int>> pending;
+
+    if (0 == me)
+    {
+        for (int task = 1; task < n; task++) pending.push_back(recv(context, ranks[task], barrier_tag, nullptr, 0));
+        for (auto& future : pending) future.wait();
+        pending.clear();
+
+        for (int task = 1; task < n; task++) pending.push_back(send(context, ranks[task], barrier_tag, nullptr, 0));
+    }
+
+    else
+    {
+        pending.push_back(send(context, ranks[0], barrier_tag, nullptr, 0));
+        pending.push_back(recv(context, ranks[0], barrier_tag, nullptr, 0));
+    }
+
+    int stat = BEO_SUCCESS;
+
+    for (auto& future : pending) stat |= future.get();
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+/*****************************************
+ * broadcast
+*****************************************/
+inline int Shm_Transport::broadcast(const std::vector<int>& ranks,
+                                    const context_t context,
+                                    const int me,
+                                    void* buf,
+                                    const size_t bytes,
+                                    const int root)
+{
+    const int n = (int) ranks.size();
+
+    std::vector<std::future<int>> pending;
+
+    if (root == me)
+    {
+        for (int task = 0; task < n; task++)
+        {
+            if (task != root) pending.push_back(send(context, ranks[task], broadcast_tag, buf, bytes));
+        }
+    }
+
+    else
+    {
+        pending.push_back(recv(context, ranks[root], broadcast_tag, buf, bytes));
+    }
+
+    int stat = BEO_SUCCESS;
+
+    for (auto& future : pending) stat |= future.get();
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+/*****************************************
+ * gather
+*****************************************/
+inline int Shm_Transport::gather(const std::vector<int>& ranks,
+                                 const context_t context,
+                                 const int me,
+                                 void* dest,
+                                 const void* src,
+                                 const size_t bytes,
+                                 const int root)
+{
+    const int n = (int) ranks.size();
+
+    std::vector<std::future<int>> pending;
+
+    if (root == me)
+    {
+        for (int task = 0; task < n; task++)
+        {
+            char* ptr = (char*) dest + task * bytes;
+
+            if (task == root) memmove(ptr, src, bytes);
+
+            else pending.push_back(recv(context, ranks[task], gather_tag, ptr, bytes));
+        }
+    }
+
+    else
+    {
+        pending.push_back(send(context, ranks[root], gather_tag, src, bytes));
+    }
+
+    int stat = BEO_SUCCESS;
+
+    for (auto& future : pending) stat |= future.get();
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+} //end namespace beo
+
+#endif
@@ -0,0 +1,221 @@
+/*****************************************
+ * shm_window.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Shm_Window, the
+ *   _BEO_SHM_ stand-in for an
+ *   MPI_Win_allocate_shared window.
+ *
+ * Each task of the comm creates its own
+ *   shm_open segment, and maps those of
+ *   its peers, so every task can load and
+ *   store into the memory of every other.
+ *   The segments are unlinked as soon as
+ *   everyone has mapped them.
+ *
+ * Each segment starts with a spinlock,
+ *   so that updates to a task's memory
+ *   (e.g., accumulates) can be made
+ *   atomic with lock(task)/unlock(task).
+ *
+ * allocate and free are collective over
+ *   the comm
+*****************************************/
+#ifndef _BEO_SHM_WINDOW_HPP_
+#define _BEO_SHM_WINDOW_HPP_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+
+#include "def.hpp"
+#include "comm.hpp"
+#include "ops.hpp"
+#include "shm_transport.hpp"
+
+namespace beo
+{
+
+class Shm_Window
+{
+    public:
+
+        //bytes before each task's memory, which hold the lock
+        static const size_t header_bytes = BEO_CHUNK_ALIGNMENT;
+
+    protected:
+
+        struct Segment
+        {
+            char*  map{nullptr};
+
+            size_t bytes{0};
+        };
+
+        //what a peer needs to find a segment
+        struct Id
+        {
+            int32_t  pid;
+
+            int32_t  serial;
+
+            uint64_t bytes;
+        };
+
+        std::vector<Segment> segments_;
+
+        static int& serial();
+
+        static std::string segment_name(const Id& id);
+
+        std::atomic<uint32_t>& lock_word(const int task) {return *(std::atomic<uint32_t>*) segments_[task].map;}
+
+    public:
+
+        Shm_Window() {}
+
+       ~Shm_Window() {}
+
+        Shm_Window(const Shm_Window& other) = delete;
+
+        Shm_Window& operator=(const Shm_Window& other) = delete;
+
+        bool is_allocated() const {return !segments_.empty();}
+
+        int allocate(Comm& comm, const size_t bytes);
+
+        int free(Comm& comm);
+
+        char* base(const int task) {return segments_[task].map + header_bytes;}
+
+        void lock(const int task);
+
+        void unlock(const int task);
+};
+
+/*****************************************
+ * naming
+ *
+ * Segments are named by the run, the
+ *   process, and how many this process
+ *   has made, so they never collide
+*****************************************/
+inline int& Shm_Window::serial()
+{
+    static int serial = 0;
+    return serial;
+}
+
+inline std::string Shm_Window::segment_name(const Id& id)
+{
+    return "/" + Shm_Transport::base_name()
+         + "." + std::to_string(id.pid)
+         + "." + std::to_string(id.serial);
+}
+
+/*****************************************
+ * allocate
+ *
+ * Creates bytes of memory on this task,
+ *   and maps that of every other task
+*****************************************/
+inline int Shm_Window::allocate(Comm& comm, const size_t bytes)
+{
+    if (is_allocated()) return BEO_FAIL;
+
+    const Id mine{(int32_t) getpid(), serial()++, (uint64_t) bytes};
+
+    std::vector<Id> ids(comm.num_tasks());
+
+    const std::string name = segment_name(mine);
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+    if (fd < 0 || 0 != ftruncate(fd, (off_t) (header_bytes + bytes)))
+    {
+        printf("beo::Shm_Window::allocate Task %d could not create %s\n", comm.task_id(), name.c_str());
+        exit(1);
+    }
+
+    if (BEO_SUCCESS != beo::allgather(comm, ids.data(), &mine, sizeof(Id))) return BEO_FAIL;
+
+    segments_.resize(comm.num_tasks());
+
+    for (int task = 0; task < comm.num_tasks(); task++)
+    {
+        const size_t map_bytes = header_bytes + ids[task].bytes;
+
+        int task_fd = (task == comm.task_id()) ? fd : shm_open(segment_name(ids[task]).c_str(), O_RDWR, 0600);
+
+        void* ptr = (task_fd >= 0)
+                  ? mmap(nullptr, map_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, task_fd, 0)
+                  : MAP_FAILED;
+
+        if (MAP_FAILED == ptr)
+        {
+            printf("beo::Shm_Window::allocate Task %d could not map the memory of task %d\n", comm.task_id(), task);
+            exit(1);
+        }
+
+        if (task_fd >= 0) ::close(task_fd);
+
+        segments_[task].map   = (char*) ptr;
+        segments_[task].bytes = map_bytes;
+    }
+
+    //everyone has mapped everything, so the names can go
+    int stat = beo::barrier(comm);
+
+    shm_unlink(name.c_str());
+
+    return stat;
+}
+
+/*****************************************
+ * free
+*****************************************/
+inline int Shm_Window::free(Comm& comm)
+{
+    if (!is_allocated()) return BEO_SUCCESS;
+
+    //no peer may still be using this task's memory
+    int stat = beo::barrier(comm);
+
+    for (auto& segment : segments_) munmap(segment.map, segment.bytes);
+
+    segments_.clear();
+
+    return stat;
+}
+
+/*****************************************
+ * lock/unlock
+*****************************************/
+inline void Shm_Window::lock(const int task)
+{
+    auto& word = lock_word(task);
+
+    while (0 != word.exchange(1, std::memory_order_acquire))
+    {
+        while (0 != word.load(std::memory_order_relaxed)) std::this_thread::yield();
+    }
+}
+
+inline void Shm_Window::unlock(const int task)
+{
+    lock_word(task).store(0, std::memory_order_release);
+}
+
+} //end namespace beo
+
+#endif
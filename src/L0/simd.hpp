@@ -0,0 +1,207 @@
+/*****************************************
+ * simd.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Simd, a thin
+ *   wrapper over the vector registers
+ *   of the machine beo is compiled for.
+ *
+ * Simd<T>::width is the number of T in a
+ *   register: 8 doubles or 16 floats with
+ *   AVX-512 (__AVX512F__), 4 or 8 with
+ *   AVX2 (__AVX2__), and 1 otherwise, or
+ *   for other types, in which case the
+ *   kernels use their scalar loops. Pick
+ *   the instruction set with the usual
+ *   compiler flags (e.g., -march=native).
+ *   _BEO_NO_SIMD_ turns the wrapper off.
+ *
+ * Loads and stores are unaligned, since
+ *   the kernels may start anywhere in a
+ *   chunk
+*****************************************/
+#ifndef _BEO_SIMD_HPP_
+#define _BEO_SIMD_HPP_
+
+#if !defined _BEO_NO_SIMD_ && (defined __AVX512F__ || defined __AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <stddef.h>
+
+namespace beo
+{
+
+//scalar fallback
+template<typename T>
+struct Simd
+{
+    static const size_t width = 1;
+};
+
+#if !defined _BEO_NO_SIMD_ && defined __AVX512F__
+
+template<>
+struct Simd<double>
+{
+    using reg_t = __m512d;
+
+    static const size_t width = 8;
+
+    static reg_t load(const double* p) {return _mm512_loadu_pd(p);}
+
+    static void  store(double* p, const reg_t a) {_mm512_storeu_pd(p, a);}
+
+    static reg_t set1(const double a) {return _mm512_set1_pd(a);}
+
+    static reg_t add(const reg_t a, const reg_t b) {return _mm512_add_pd(a, b);}
+
+    static reg_t sub(const reg_t a, const reg_t b) {return _mm512_sub_pd(a, b);}
+
+    static reg_t mul(const reg_t a, const reg_t b) {return _mm512_mul_pd(a, b);}
+
+    static reg_t div(const reg_t a, const reg_t b) {return _mm512_div_pd(a, b);}
+
+    //a * b + c
+    static reg_t fma(const reg_t a, const reg_t b, const reg_t c) {return _mm512_fmadd_pd(a, b, c);}
+
+    static reg_t max(const reg_t a, const reg_t b) {return _mm512_max_pd(a, b);}
+
+    static reg_t abs(const reg_t a) {return _mm512_abs_pd(a);}
+
+    static double sum(const reg_t a) {return _mm512_reduce_add_pd(a);}
+
+    static double max(const reg_t a) {return _mm512_reduce_max_pd(a);}
+};
+
+template<>
+struct Simd<float>
+{
+    using reg_t = __m512;
+
+    static const size_t width = 16;
+
+    static reg_t load(const float* p) {return _mm512_loadu_ps(p);}
+
+    static void  store(float* p, const reg_t a) {_mm512_storeu_ps(p, a);}
+
+    static reg_t set1(const float a) {return _mm512_set1_ps(a);}
+
+    static reg_t add(const reg_t a, const reg_t b) {return _mm512_add_ps(a, b);}
+
+    static reg_t sub(const reg_t a, const reg_t b) {return _mm512_sub_ps(a, b);}
+
+    static reg_t mul(const reg_t a, const reg_t b) {return _mm512_mul_ps(a, b);}
+
+    static reg_t div(const reg_t a, const reg_t b) {return _mm512_div_ps(a, b);}
+
+    static reg_t fma(const reg_t a, const reg_t b, const reg_t c) {return _mm512_fmadd_ps(a, b, c);}
+
+    static reg_t max(const reg_t a, const reg_t b) {return _mm512_max_ps(a, b);}
+
+    static reg_t abs(const reg_t a) {return _mm512_abs_ps(a);}
+
+    static float sum(const reg_t a) {return _mm512_reduce_add_ps(a);}
+
+    static float max(const reg_t a) {return _mm512_reduce_max_ps(a);}
+};
+
+#elif !defined _BEO_NO_SIMD_ && defined __AVX2__
+
+template<>
+struct Simd<double>
+{
+    using reg_t = __m256d;
+
+    static const size_t width = 4;
+
+    static reg_t load(const double* p) {return _mm256_loadu_pd(p);}
+
+    static void  store(double* p, const reg_t a) {_mm256_storeu_pd(p, a);}
+
+    static reg_t set1(const double a) {return _mm256_set1_pd(a);}
+
+    static reg_t add(const reg_t a, const reg_t b) {return _mm256_add_pd(a, b);}
+
+    static reg_t sub(const reg_t a, const reg_t b) {return _mm256_sub_pd(a, b);}
+
+    static reg_t mul(const reg_t a, const reg_t b) {return _mm256_mul_pd(a, b);}
+
+    static reg_t div(const reg_t a, const reg_t b) {return _mm256_div_pd(a, b);}
+
+    #if defined __FMA__
+    static reg_t fma(const reg_t a, const reg_t b, const reg_t c) {return _mm256_fmadd_pd(a, b, c);}
+    #else
+    static reg_t fma(const reg_t a, const reg_t b, const reg_t c) {return add(mul(a, b), c);}
+    #endif
+
+    static reg_t max(const reg_t a, const reg_t b) {return _mm256_max_pd(a, b);}
+
+    static reg_t abs(const reg_t a) {return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a);}
+
+    static double sum(const reg_t a)
+    {
+        const __m128d s = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+    }
+
+    static double max(const reg_t a)
+    {
+        const __m128d m = _mm_max_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+        return _mm_cvtsd_f64(_mm_max_sd(m, _mm_unpackhi_pd(m, m)));
+    }
+};
+
+template<>
+struct Simd<float>
+{
+    using reg_t = __m256;
+
+    static const size_t width = 8;
+
+    static reg_t load(const float* p) {return _mm256_loadu_ps(p);}
+
+    static void  store(float* p, const reg_t a) {_mm256_storeu_ps(p, a);}
+
+    static reg_t set1(const float a) {return _mm256_set1_ps(a);}
+
+    static reg_t add(const reg_t a, const reg_t b) {return _mm256_add_ps(a, b);}
+
+    static reg_t sub(const reg_t a, const reg_t b) {return _mm256_sub_ps(a, b);}
+
+    static reg_t mul(const reg_t a, const reg_t b) {return _mm256_mul_ps(a, b);}
+
+    static reg_t div(const reg_t a, const reg_t b) {return _mm256_div_ps(a, b);}
+
+    #if defined __FMA__
+    static reg_t fma(const reg_t a, const reg_t b, const reg_t c) {return _mm256_fmadd_ps(a, b, c);}
+    #else
+    static reg_t fma(const reg_t a, const reg_t b, const reg_t c) {return add(mul(a, b), c);}
+    #endif
+
+    static reg_t max(const reg_t a, const reg_t b) {return _mm256_max_ps(a, b);}
+
+    static reg_t abs(const reg_t a) {return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a);}
+
+    static float sum(const reg_t a)
+    {
+        __m128 s = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+        s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        return _mm_cvtss_f32(_mm_add_ss(s, _mm_movehdup_ps(s)));
+    }
+
+    static float max(const reg_t a)
+    {
+        __m128 m = _mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+        m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+        return _mm_cvtss_f32(_mm_max_ss(m, _mm_movehdup_ps(m)));
+    }
+};
+
+#endif
+
+} //end namespace beo
+
+#endif
@@ -0,0 +1,782 @@
+/*****************************************
+ * sub_block.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Sub_Block, which
+ *   describes a rectangular piece of a
+ *   beo::Chunk (a slab, a range of rows,
+ *   a corner, ...) by its starts and
+ *   lengths within the chunk, and the
+ *   operations that move one without
+ *   packing it by hand.
+ *
+ * Chunks are row-major in their index
+ *   order, with elm_bytes per element.
+ *
+ * With MPI, a block that is not one
+ *   contiguous span is sent, recieved,
+ *   read and written through a subarray
+ *   MPI_Datatype, straight from the
+ *   chunk. The datatypes are made once per
+ *   shape and cached, see Sub_Block::type.
+ *   Call free_subarray_types before
+ *   MPI_Finalize (Enviroment::finalize
+ *   does this).
+ *
+ * The other backends pack and unpack
+ *   blocks a contiguous run at a time
+ *   with Simd copies, and skip the pack
+ *   entirely when the block is contiguous
+ *
+ * Included here:
+ *      copy_block
+ *      send_recv
+ *      async_send_recv
+ *      read_block_at
+ *      write_block_at
+*****************************************/
+#ifndef _BEO_SUB_BLOCK_HPP_
+#define _BEO_SUB_BLOCK_HPP_
+
+#if defined _BEO_MPI_
+#include <mpi.h>
+#include <map>
+#include <limits.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <memory>
+#include <future>
+#include <mutex>
+
+#include "def.hpp"
+#include "simd.hpp"
+#include "chunk.hpp"
+#include "comm.hpp"
+#include "request.hpp"
+#include "thread_pool.hpp"
+#include "shared_file.hpp"
+#include "ops.hpp"
+#include "trace.hpp"
+#include "counters.hpp"
+
+namespace beo
+{
+
+/*****************************************
+ * copy_bytes
+ *
+ * memcpy for the runs of a block, a Simd
+ *   register at a time
+*****************************************/
+template<typename S = Simd<double>>
+inline void copy_bytes(void* dest, const void* src, const size_t bytes)
+{
+    if constexpr (S::width > 1)
+    {
+        const size_t step = S::width * sizeof(double);
+
+        char*       d = (char*) dest;
+        const char* s = (const char*) src;
+
+        size_t i = 0;
+        for (; i + step <= bytes; i += step) S::store((double*) (d + i), S::load((const double*) (s + i)));
+
+        if (i < bytes) memcpy(d + i, s + i, bytes - i);
+    }
+
+    else
+    {
+        memcpy(dest, src, bytes);
+    }
+}
+
+class Sub_Block
+{
+    public:
+
+        using offsets_t = Chunk::offsets_t;
+
+        using lengths_t = Chunk::lengths_t;
+
+    protected:
+
+        Chunk*    chunk_{nullptr};
+
+        offsets_t starts_;
+
+        lengths_t lengths_;
+
+        size_t    elm_bytes_{0};
+
+    public:
+
+        Sub_Block() {}
+
+        Sub_Block(Chunk& chunk,
+                  const offsets_t& starts,
+                  const lengths_t& lengths,
+                  const size_t elm_bytes);
+
+        Chunk& chunk() const {return *chunk_;}
+
+        const offsets_t& starts() const {return starts_;}
+
+        const lengths_t& lengths() const {return lengths_;}
+
+        size_t ndim() const {return lengths_.size();}
+
+        size_t elm_bytes() const {return elm_bytes_;}
+
+        bool is_empty() const {return nullptr == chunk_;}
+
+        //Number of elements in the block
+        size_t size() const;
+
+        size_t bytes() const {return size() * elm_bytes_;}
+
+        //True if the block is one span of the chunk
+        bool is_contiguous() const;
+
+        //Pointer to the first element of the block
+        char* first() const;
+
+        //Calls func(byte offset, bytes) on each contiguous run, in order
+        template<typename F>
+        void for_each_run(F&& func) const;
+
+        //Copies the block to/from bytes() of contiguous buf
+        void pack(void* buf) const;
+
+        void unpack(const void* buf) const;
+
+        #if defined _BEO_MPI_
+
+        //The cached subarray type of the block, relative to chunk().data()
+        MPI_Datatype type() const;
+
+        #endif
+};
+
+/*****************************************
+ * Constructor
+ *
+ * Checks that the block lies inside the
+ *   chunk, and exits if not
+*****************************************/
+inline Sub_Block::Sub_Block(Chunk& chunk,
+                            const offsets_t& starts,
+                            const lengths_t& lengths,
+                            const size_t elm_bytes)
+    : chunk_(&chunk), starts_(starts), lengths_(lengths), elm_bytes_(elm_bytes)
+{
+    bool is_valid = (starts.size() == chunk.ndim()) && (lengths.size() == chunk.ndim());
+
+    for (size_t idx = 0; is_valid && idx < chunk.ndim(); idx++)
+    {
+        is_valid = starts[idx] + lengths[idx] <= chunk.length(idx);
+    }
+
+    if (!is_valid)
+    {
+        printf("beo::Sub_Block block does not fit inside its chunk\n");
+        exit(1);
+    }
+}
+
+/*****************************************
+ * size
+*****************************************/
+inline size_t Sub_Block::size() const
+{
+    if (is_empty()) return 0;
+
+    size_t sz = 1;
+    for (const auto len : lengths_) sz *= len;
+    return sz;
+}
+
+/*****************************************
+ * is_contiguous
+ *
+ * After the first index with a length
+ *   other than one, the block must span
+ *   the whole chunk
+*****************************************/
+inline bool Sub_Block::is_contiguous() const
+{
+    if (0 == size()) return true;
+
+    size_t idx = 0;
+    while (idx < ndim() && 1 == lengths_[idx]) idx++;
+
+    for (idx++; idx < ndim(); idx++)
+    {
+        if (lengths_[idx] != chunk_->length(idx)) return false;
+    }
+
+    return true;
+}
+
+/*****************************************
+ * first
+*****************************************/
+inline char* Sub_Block::first() const
+{
+    size_t off = 0;
+    for (size_t idx = 0; idx < ndim(); idx++) off = off * chunk_->length(idx) + starts_[idx];
+    return (char*) chunk_->data() + off * elm_bytes_;
+}
+
+/*****************************************
+ * for_each_run
+ *
+ * The run is the trailing indices that
+ *   span the chunk, plus the first that
+ *   does not. The leading indices are
+ *   stepped through like an odometer
+*****************************************/
+template<typename F>
+inline void Sub_Block::for_each_run(F&& func) const
+{
+    if (0 == size()) return;
+
+    const size_t n = ndim();
+
+    std::vector<size_t> strides(n, 1);
+    for (size_t idx = n; idx-- > 1;) strides[idx - 1] = strides[idx] * chunk_->length(idx);
+
+    size_t outer = n;
+    size_t run   = 1;
+    while (outer > 0)
+    {
+        outer--;
+        run *= lengths_[outer];
+        if (lengths_[outer] != chunk_->length(outer)) break;
+    }
+
+    std::vector<size_t> pos(outer, 0);
+
+    while (true)
+    {
+        size_t off = 0;
+        for (size_t idx = 0; idx < n; idx++) off += (starts_[idx] + ((idx < outer) ? pos[idx] : 0)) * strides[idx];
+
+        func(off * elm_bytes_, run * elm_bytes_);
+
+        size_t idx = outer;
+        while (idx > 0)
+        {
+            idx--;
+            if (++pos[idx] < lengths_[idx]) break;
+            pos[idx] = 0;
+            if (0 == idx) return;
+        }
+
+        if (0 == outer) return;
+    }
+}
+
+/*****************************************
+ * pack / unpack
+*****************************************/
+inline void Sub_Block::pack(void* buf) const
+{
+    char*       dest = (char*) buf;
+    const char* base = (const char*) chunk_->data();
+
+    for_each_run([&dest, base](const size_t off, const size_t bytes)
+    {
+        copy_bytes(dest, base + off, bytes);
+        dest += bytes;
+    });
+}
+
+inline void Sub_Block::unpack(const void* buf) const
+{
+    const char* src  = (const char*) buf;
+    char*       base = (char*) chunk_->data();
+
+    for_each_run([&src, base](const size_t off, const size_t bytes)
+    {
+        copy_bytes(base + off, src, bytes);
+        src += bytes;
+    });
+}
+
+#if defined _BEO_MPI_
+
+/*****************************************
+ * Subarray_Types
+ *
+ * The cache of committed subarray types,
+ *   keyed on the element size, the chunk
+ *   lengths, and the block starts and
+ *   lengths
+*****************************************/
+struct Subarray_Types
+{
+    std::mutex m;
+
+    std::map<std::vector<size_t>, MPI_Datatype> types;
+};
+
+inline Subarray_Types& subarray_types()
+{
+    static Subarray_Types cache;
+    return cache;
+}
+
+/*****************************************
+ * free_subarray_types
+ *
+ * Frees the cached types. Call this
+ *   before MPI_Finalize
+*****************************************/
+inline void free_subarray_types()
+{
+    auto& cache = subarray_types();
+
+    std::lock_guard<std::mutex> g(cache.m);
+
+    for (auto& [key, type] : cache.types) MPI_Type_free(&type);
+
+    cache.types.clear();
+}
+
+/*****************************************
+ * type
+*****************************************/
+inline MPI_Datatype Sub_Block::type() const
+{
+    const size_t n = ndim();
+
+    std::vector<size_t> key;
+    key.reserve(3 * n + 1);
+    key.push_back(elm_bytes_);
+    for (size_t idx = 0; idx < n; idx++) key.push_back(chunk_->length(idx));
+    key.insert(key.end(), starts_.begin(), starts_.end());
+    key.insert(key.end(), lengths_.begin(), lengths_.end());
+
+    auto& cache = subarray_types();
+
+    std::lock_guard<std::mutex> g(cache.m);
+
+    auto itr = cache.types.find(key);
+    if (itr != cache.types.end()) return itr->second;
+
+    std::vector<int> sizes(n), subsizes(n), starts(n);
+    for (size_t idx = 0; idx < n; idx++)
+    {
+        if (chunk_->length(idx) > INT_MAX || elm_bytes_ > INT_MAX)
+        {
+            printf("beo::Sub_Block::type chunk is too large for an MPI subarray\n");
+            exit(1);
+        }
+
+        sizes[idx]    = (int) chunk_->length(idx);
+        subsizes[idx] = (int) lengths_[idx];
+        starts[idx]   = (int) starts_[idx];
+    }
+
+    MPI_Datatype elm, type;
+
+    MPI_Type_contiguous((int) elm_bytes_, MPI_BYTE, &elm);
+
+    MPI_Type_create_subarray((int) n,
+                             sizes.data(),
+                             subsizes.data(),
+                             starts.data(),
+                             MPI_ORDER_C,
+                             elm,
+                             &type);
+
+    MPI_Type_commit(&type);
+
+    MPI_Type_free(&elm);
+
+    cache.types.emplace(std::move(key), type);
+
+    return type;
+}
+
+#endif
+
+/*****************************************
+ * copy_block
+ *
+ * Copies src into dest on this task. The
+ *   blocks must have the same number of
+ *   bytes
+*****************************************/
+inline int copy_block(const Sub_Block& dest,
+                      const Sub_Block& src)
+{
+    if (dest.bytes() != src.bytes()) return BEO_FAIL;
+
+    if (src.is_contiguous())
+    {
+        dest.unpack(src.first());
+    }
+
+    else if (dest.is_contiguous())
+    {
+        src.pack(dest.first());
+    }
+
+    else
+    {
+        std::vector<char> buf(src.bytes());
+        src.pack(buf.data());
+        dest.unpack(buf.data());
+    }
+
+    return BEO_SUCCESS;
+}
+
+/*****************************************
+ * send_recv
+ *
+ * two-way blocking send/recieve of a
+ *   block, as send_recv in ops.hpp. Only
+ *   the sender's src and the reciever's
+ *   dest are used, the other may be an
+ *   empty Sub_Block
+*****************************************/
+inline int send_recv(Comm& comm,
+                     const Sub_Block& dest,
+                     const Sub_Block& src,
+                     int              dest_id,
+                     int              src_id,
+                     int              tag)
+{
+    //Check for valid dest and src ids
+    if (dest_id >= comm.num_tasks())
+    {
+        printf("beo::send_recv Task %d input dest_id(%d) is invalid\n", comm.task_id(), dest_id);
+        exit(1);
+    }
+
+    if (src_id >= comm.num_tasks())
+    {
+        printf("beo::send_recv Task %d input src_id(%d) is invalid\n", comm.task_id(), src_id);
+        exit(1);
+    }
+
+    const bool is_sender = comm.task_id() == src_id;
+
+    const size_t bytes = is_sender ? src.bytes() : dest.bytes();
+
+    BEO_TRACE_IF(is_sender || comm.task_id() == dest_id,
+                 send_recv, is_sender ? dest_id : src_id, tag, bytes);
+
+    beo::counters().message(comm.task_id(), dest_id, src_id, bytes);
+
+    if (src_id == dest_id && is_sender) return copy_block(dest, src);
+
+    #if defined _BEO_MPI_
+
+    if (is_sender)
+    {
+        const int tmp = src.is_contiguous()
+                      ? MPI_Send(src.first(), bytes, MPI_CHAR, dest_id, tag, comm.comm())
+                      : MPI_Send(src.chunk().data(), 1, src.type(), dest_id, tag, comm.comm());
+
+        return (MPI_SUCCESS == tmp) ? BEO_SUCCESS : BEO_FAIL;
+    }
+
+    else if (comm.task_id() == dest_id)
+    {
+        const int tmp = dest.is_contiguous()
+                      ? MPI_Recv(dest.first(), bytes, MPI_CHAR, src_id, tag, comm.comm(), MPI_STATUS_IGNORE)
+                      : MPI_Recv(dest.chunk().data(), 1, dest.type(), src_id, tag, comm.comm(), MPI_STATUS_IGNORE);
+
+        return (MPI_SUCCESS == tmp) ? BEO_SUCCESS : BEO_FAIL;
+    }
+
+    return BEO_SUCCESS;
+
+    #elif defined _BEO_THREADS_ || defined _BEO_SHM_
+
+    if (is_sender)
+    {
+        std::vector<char> buf;
+
+        const void* ptr = src.first();
+
+        if (!src.is_contiguous())
+        {
+            buf.resize(bytes);
+            src.pack(buf.data());
+            ptr = buf.data();
+        }
+
+        #if defined _BEO_THREADS_
+        return comm.group()->send(comm.context(), src_id, dest_id, tag, ptr, bytes).get();
+        #else
+        return comm.transport()->send(comm.context(), comm.rank_of(dest_id), tag, ptr, bytes).get();
+        #endif
+    }
+
+    else if (comm.task_id() == dest_id)
+    {
+        std::vector<char> buf;
+
+        void* ptr = dest.first();
+
+        if (!dest.is_contiguous())
+        {
+            buf.resize(bytes);
+            ptr = buf.data();
+        }
+
+        #if defined _BEO_THREADS_
+        const int stat = comm.group()->recv(comm.context(), src_id, dest_id, tag, ptr, bytes).get();
+        #else
+        const int stat = comm.transport()->recv(comm.context(), comm.rank_of(src_id), tag, ptr, bytes).get();
+        #endif
+
+        if (!buf.empty()) dest.unpack(buf.data());
+
+        return stat;
+    }
+
+    return BEO_SUCCESS;
+
+    //non-MPI case
+    #else
+
+    (void) tag;
+
+    return copy_block(dest, src);
+
+    #endif
+}
+
+/*****************************************
+ * async_send_recv
+ *
+ * Asynchronous send recieve of a block.
+ *   With threads or shared memory, a
+ *   block that is not contiguous is sent
+ *   packed, and unpacked by the transport
+ *   as it arrives, before the request is
+ *   complete
+*****************************************/
+inline Request async_send_recv(Comm& comm,
+                               const Sub_Block& dest,
+                               const Sub_Block& src,
+                               int              dest_id,
+                               int              src_id,
+                               int              tag)
+{
+    //Check for valid dest and src ids
+    if (dest_id >= comm.num_tasks())
+    {
+        printf("beo::async_send_recv Task %d input dest_id(%d) is invalid\n", comm.task_id(), dest_id);
+        exit(1);
+    }
+
+    if (src_id >= comm.num_tasks())
+    {
+        printf("beo::async_send_recv Task %d input src_id(%d) is invalid\n", comm.task_id(), src_id);
+        exit(1);
+    }
+
+    const bool is_sender = comm.task_id() == src_id;
+
+    const size_t bytes = is_sender ? src.bytes() : dest.bytes();
+
+    BEO_TRACE_IF(is_sender || comm.task_id() == dest_id,
+                 async_send_recv, is_sender ? dest_id : src_id, tag, bytes);
+
+    beo::counters().message(comm.task_id(), dest_id, src_id, bytes);
+
+    #if defined _BEO_MPI_
+
+    MPI_Request fake = MPI_REQUEST_NULL;
+
+    if (src_id == dest_id && is_sender)
+    {
+        copy_block(dest, src);
+    }
+
+    else if (is_sender)
+    {
+        const int tmp = src.is_contiguous()
+                      ? MPI_Isend(src.first(), bytes, MPI_CHAR, dest_id, tag, comm.comm(), &fake)
+                      : MPI_Isend(src.chunk().data(), 1, src.type(), dest_id, tag, comm.comm(), &fake);
+
+        if (tmp != MPI_SUCCESS) exit(1);
+    }
+
+    else if (comm.task_id() == dest_id)
+    {
+        const int tmp = dest.is_contiguous()
+                      ? MPI_Irecv(dest.first(), bytes, MPI_CHAR, src_id, tag, comm.comm(), &fake)
+                      : MPI_Irecv(dest.chunk().data(), 1, dest.type(), src_id, tag, comm.comm(), &fake);
+
+        if (tmp != MPI_SUCCESS) exit(1);
+    }
+
+    Request request = std::move(fake);
+    return request;
+
+    #elif defined _BEO_THREADS_ || defined _BEO_SHM_
+
+    if (src_id == dest_id && is_sender)
+    {
+        copy_block(dest, src);
+        return Request();
+    }
+
+    else if (is_sender)
+    {
+        if (src.is_contiguous())
+        {
+            #if defined _BEO_THREADS_
+            Request request = comm.group()->send(comm.context(), src_id, dest_id, tag, src.first(), bytes);
+            #else
+            Request request = comm.transport()->send(comm.context(), comm.rank_of(dest_id), tag, src.first(), bytes);
+            #endif
+            return request;
+        }
+
+        //the transport keeps the packed copy until it is sent
+        auto buf = std::make_shared<std::vector<char>>(bytes);
+        src.pack(buf->data());
+
+        #if defined _BEO_THREADS_
+        Request request = comm.group()->send(comm.context(), src_id, dest_id, tag, buf->data(), bytes, [buf]() {});
+        #else
+        Request request = comm.transport()->send(comm.context(), comm.rank_of(dest_id), tag, buf->data(), bytes, [buf]() {});
+        #endif
+        return request;
+    }
+
+    else if (comm.task_id() == dest_id)
+    {
+        if (dest.is_contiguous())
+        {
+            #if defined _BEO_THREADS_
+            Request request = comm.group()->recv(comm.context(), src_id, dest_id, tag, dest.first(), bytes);
+            #else
+            Request request = comm.transport()->recv(comm.context(), comm.rank_of(src_id), tag, dest.first(), bytes);
+            #endif
+            return request;
+        }
+
+        auto buf    = std::make_shared<std::vector<char>>(bytes);
+        auto unpack = [dest, buf]() {dest.unpack(buf->data());};
+
+        #if defined _BEO_THREADS_
+        Request request = comm.group()->recv(comm.context(), src_id, dest_id, tag, buf->data(), bytes, unpack);
+        #else
+        Request request = comm.transport()->recv(comm.context(), comm.rank_of(src_id), tag, buf->data(), bytes, unpack);
+        #endif
+        return request;
+    }
+
+    return Request();
+
+    //non-MPI case
+    #else
+
+    (void) tag;
+
+    Request request = beo::thread_pool().submit([dest, src]()
+    {
+        return copy_block(dest, src);
+    });
+    return request;
+
+    #endif
+}
+
+/*****************************************
+ * read_block_at
+ *
+ * Reads block.bytes() from off in the
+ *   file into the block
+*****************************************/
+inline int read_block_at(Shared_File& file,
+                         const BEO_OFF_T off,
+                         const Sub_Block& block)
+{
+    if (block.is_contiguous()) return file.read_at(off, block.first(), block.bytes());
+
+    #if defined _BEO_MPI_
+
+    BEO_TRACE(file_read_at, -1, -1, block.bytes());
+
+    beo::counters().file_read(block.bytes());
+
+    std::lock_guard<Shared_File::mutex_t> g(file.mutex());
+
+    return (MPI_SUCCESS == MPI_File_read_at(file.file(),
+                                            off,
+                                            block.chunk().data(),
+                                            1,
+                                            block.type(),
+                                            MPI_STATUS_IGNORE))
+           ? BEO_SUCCESS : BEO_FAIL;
+
+    #else
+
+    std::vector<char> buf(block.bytes());
+
+    if (BEO_SUCCESS != file.read_at(off, buf.data(), buf.size())) return BEO_FAIL;
+
+    block.unpack(buf.data());
+
+    return BEO_SUCCESS;
+
+    #endif
+}
+
+/*****************************************
+ * write_block_at
+ *
+ * Writes the block contiguously at off
+ *   in the file
+*****************************************/
+inline int write_block_at(Shared_File& file,
+                          const BEO_OFF_T off,
+                          const Sub_Block& block)
+{
+    if (block.is_contiguous()) return file.write_at(off, block.first(), block.bytes());
+
+    #if defined _BEO_MPI_
+
+    BEO_TRACE(file_write_at, -1, -1, block.bytes());
+
+    beo::counters().file_written(block.bytes());
+
+    std::lock_guard<Shared_File::mutex_t> g(file.mutex());
+
+    return (MPI_SUCCESS == MPI_File_write_at(file.file(),
+                                             off,
+                                             block.chunk().data(),
+                                             1,
+                                             block.type(),
+                                             MPI_STATUS_IGNORE))
+           ? BEO_SUCCESS : BEO_FAIL;
+
+    #else
+
+    std::vector<char> buf(block.bytes());
+
+    block.pack(buf.data());
+
+    return file.write_at(off, buf.data(), buf.size());
+
+    #endif
+}
+
+} //end namespace beo
+
+#endif
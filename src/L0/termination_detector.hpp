@@ -0,0 +1,209 @@
+/*****************************************
+ * termination_detector.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Termination_Detector,
+ *   which tells the tasks of a comm when
+ *   all of them are out of work, for
+ *   workloads where tasks make work for
+ *   each other (e.g., sending contributions
+ *   to the owners of chunks), so a barrier
+ *   cannot tell when they are done.
+ *
+ * Each task counts the messages it sends
+ *   and recieves with sent() and received().
+ *   Once it has no work left, it polls
+ *   is_complete() (or calls wait()), which
+ *   sums the counts over the tasks with
+ *   async_allreduce, one wave at a time.
+ *   Once two waves in a row see the same
+ *   totals, with as many recieved as sent,
+ *   no message is in flight and no task
+ *   has work, so every task sees it is
+ *   done on the same wave (Mattern's four
+ *   counter method).
+ *
+ * A task that recieves a message while
+ *   polling is busy again, and must handle
+ *   it (and count what it sends) before it
+ *   polls again. wait() fires the
+ *   Request::then callbacks of the event
+ *   loop while it polls, so message
+ *   handlers can be written as those. Work
+ *   handed to the thread pool must be done
+ *   before polling.
+ *
+ * init and finalize are collective. The
+ *   detector uses its own copy of the comm
+*****************************************/
+#ifndef _BEO_TERMINATION_DETECTOR_HPP_
+#define _BEO_TERMINATION_DETECTOR_HPP_
+
+#if defined _BEO_MPI_
+#include <mpi.h>
+#endif
+
+#include <atomic>
+#include <thread>
+
+#include "def.hpp"
+#include "comm.hpp"
+#include "request.hpp"
+#include "thread_pool.hpp"
+#include "event_loop.hpp"
+#include "ops.hpp"
+
+namespace beo
+{
+
+class Termination_Detector
+{
+    public:
+
+        using count_t = unsigned long long;
+
+    protected:
+
+        Comm                 comm_;
+
+        std::atomic<count_t> num_sent_{0};
+
+        std::atomic<count_t> num_received_{0};
+
+        //{sent, recieved} of the wave in flight, and of the one before
+        count_t              wave_[2]{0, 0};
+
+        count_t              last_[2]{0, 0};
+
+        bool                 has_last_{false};
+
+        bool                 in_wave_{false};
+
+        bool                 is_done_{false};
+
+        size_t               num_waves_{0};
+
+        Request              request_;
+
+    public:
+
+        Termination_Detector() {}
+
+       ~Termination_Detector() {}
+
+        Termination_Detector(const Termination_Detector& other) = delete;
+
+        Termination_Detector& operator=(const Termination_Detector& other) = delete;
+
+        void init(Comm& comm);
+
+        void finalize();
+
+        void sent(const count_t n = 1) {num_sent_ += n;}
+
+        void received(const count_t n = 1) {num_received_ += n;}
+
+        //Only call once this task is out of work
+        bool is_complete();
+
+        int wait();
+
+        bool is_done() const {return is_done_;}
+
+        size_t num_waves() const {return num_waves_;}
+};
+
+/*****************************************
+ * init
+ *
+ * Starts counting on a copy of comm
+*****************************************/
+inline void Termination_Detector::init(Comm& comm)
+{
+    comm_ = comm;
+
+    num_sent_     = 0;
+    num_received_ = 0;
+    has_last_     = false;
+    in_wave_      = false;
+    is_done_      = false;
+    num_waves_    = 0;
+}
+
+/*****************************************
+ * finalize
+*****************************************/
+inline void Termination_Detector::finalize()
+{
+    if (in_wave_) request_.wait();
+
+    in_wave_ = false;
+
+    comm_.finalize();
+}
+
+/*****************************************
+ * is_complete
+ *
+ * Checks the wave in flight, and starts
+ *   the next one. True once every task is
+ *   done
+*****************************************/
+inline bool Termination_Detector::is_complete()
+{
+    if (is_done_) return true;
+
+    if (in_wave_)
+    {
+        if (!request_.is_complete()) return false;
+
+        request_.wait();
+
+        in_wave_ = false;
+
+        num_waves_++;
+
+        if (has_last_ && wave_[0] == wave_[1] && wave_[0] == last_[0] && wave_[1] == last_[1])
+        {
+            is_done_ = true;
+            return true;
+        }
+
+        last_[0] = wave_[0];
+        last_[1] = wave_[1];
+        has_last_ = true;
+    }
+
+    wave_[0] = num_sent_;
+    wave_[1] = num_received_;
+
+    request_ = beo::async_allreduce(comm_, wave_, 2, Op::sum);
+
+    in_wave_ = true;
+
+    return false;
+}
+
+/*****************************************
+ * wait
+ *
+ * Polls until every task is done, firing
+ *   event loop callbacks in between
+*****************************************/
+inline int Termination_Detector::wait()
+{
+    while (!is_complete())
+    {
+        if (beo::event_loop().poll() > 0) continue;
+
+        if (!beo::thread_pool().run_one()) std::this_thread::yield();
+    }
+
+    return BEO_SUCCESS;
+}
+
+} //end namespace beo
+
+#endif
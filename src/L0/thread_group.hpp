@@ -0,0 +1,508 @@
+/*****************************************
+ * thread_group.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Thread_Group,
+ *   the backend used when beo is built
+ *   with _BEO_THREADS_. N threads in one
+ *   process act as N tasks, so multi-task
+ *   code runs without MPI installed.
+ *
+ * Start the tasks with beo::launch(N, func).
+ *   Each thread runs func, and the
+ *   beo::Enviroment made inside it sees a
+ *   world of N tasks.
+ *
+ * Point-to-point messages are matched
+ *   by (context, source, tag) in a
+ *   mailbox per destination. Large
+ *   messages are copied once, directly
+ *   from the sender's buffer into the
+ *   reciever's, when both sides have
+ *   arrived. Messages of eager_bytes or
+ *   less are copied out of the sender's
+ *   buffer right away, so their sends
+ *   complete without a matching recieve.
+ *
+ * Collectives exchange pointers to each
+ *   task's buffer, and work on them in
+ *   place.
+ *
+ * Each copy of a beo::Comm gets its own
+ *   context (the equivalent of
+ *   MPI_Comm_dup), so copies must be made
+ *   in the same order on every task, just
+ *   as with MPI.
+*****************************************/
+#ifndef _BEO_THREAD_GROUP_HPP_
+#define _BEO_THREAD_GROUP_HPP_
+
+#include <string.h>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <future>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+#include "def.hpp"
+
+namespace beo
+{
+
+class Thread_Group
+{
+    public:
+
+        using mutex_t   = std::mutex;
+
+        using promise_t = std::shared_ptr<std::promise<int>>;
+
+        //run just before the future of a send or recieve is ready
+        using on_done_t = std::function<void()>;
+
+        //The group and task id of the calling thread
+        struct Current
+        {
+            std::shared_ptr<Thread_Group> group;
+
+            int task_id{0};
+        };
+
+        static const size_t eager_bytes = 4096;
+
+    protected:
+
+        struct Send
+        {
+            int               context;
+
+            int               src_id;
+
+            int               tag;
+
+            const void*       buf;
+
+            size_t            bytes;
+
+            std::vector<char> eager;
+
+            promise_t         done;
+
+            on_done_t         on_done;
+        };
+
+        struct Recv
+        {
+            int       context;
+
+            int       src_id;
+
+            int       tag;
+
+            void*     buf;
+
+            size_t    bytes;
+
+            promise_t done;
+
+            on_done_t on_done;
+        };
+
+        struct Mailbox
+        {
+            mutex_t          m;
+
+            std::deque<Send> sends;
+
+            std::deque<Recv> recvs;
+        };
+
+        struct Collective
+        {
+            mutex_t                  m;
+
+            std::condition_variable  cv;
+
+            int                      arrived{0};
+
+            size_t                   generation{0};
+
+            std::vector<const void*> slots;
+
+            std::map<int, std::shared_ptr<Thread_Group>> splits;
+        };
+
+        int                                     num_tasks_;
+
+        std::vector<std::unique_ptr<Mailbox>>   mailboxes_;
+
+        mutex_t                                 mutex_;
+
+        std::map<int, std::unique_ptr<Collective>> collectives_;
+
+        std::vector<int>                        contexts_;
+
+        Collective& collective(const int context);
+
+    public:
+
+        Thread_Group(const int num_tasks);
+
+        Thread_Group(const Thread_Group& other) = delete;
+
+        Thread_Group& operator=(const Thread_Group& other) = delete;
+
+        int num_tasks() const {return num_tasks_;}
+
+        static Current& current();
+
+        //new context for a copy of a comm, made by task_id
+        int dup_context(const int task_id);
+
+        std::future<int> send(const int context,
+                              const int src_id,
+                              const int dest_id,
+                              const int tag,
+                              const void* buf,
+                              const size_t bytes,
+                              on_done_t&& on_done = nullptr);
+
+        std::future<int> recv(const int context,
+                              const int src_id,
+                              const int dest_id,
+                              const int tag,
+                              void* buf,
+                              const size_t bytes,
+                              on_done_t&& on_done = nullptr);
+
+        int barrier(const int context);
+
+        //publish a pointer, and get everyone's. Slots may be
+        //  read until the next barrier on the context
+        const std::vector<const void*>& exchange(const int context,
+                                                 const int task_id,
+                                                 const void* mine);
+
+        //a color < 0 leaves the task out, returning nullptr
+        std::shared_ptr<Thread_Group> split(const int context,
+                                            const int task_id,
+                                            const int color,
+                                            const int key,
+                                            int& new_id);
+};
+
+//Runs func on num_tasks threads, each a task of one Thread_Group
+int launch(const int num_tasks, const std::function<void()>& func);
+
+/*****************************************
+ * Constructor
+*****************************************/
+inline Thread_Group::Thread_Group(const int num_tasks)
+{
+    num_tasks_ = (num_tasks > 0) ? num_tasks : 1;
+
+    for (int task = 0; task < num_tasks_; task++) mailboxes_.emplace_back(new Mailbox);
+
+    contexts_.assign(num_tasks_, 0);
+}
+
+/*****************************************
+ * current
+*****************************************/
+inline Thread_Group::Current& Thread_Group::current()
+{
+    static thread_local Current current;
+    return current;
+}
+
+/*****************************************
+ * dup_context
+ *
+ * The k-th copy made on each task gets
+ *   the same context, with no need to
+ *   synchronize
+*****************************************/
+inline int Thread_Group::dup_context(const int task_id)
+{
+    std::lock_guard<mutex_t> g(mutex_);
+
+    return ++contexts_[task_id];
+}
+
+/*****************************************
+ * collective
+ *
+ * the collective state of a context
+*****************************************/
+inline Thread_Group::Collective& Thread_Group::collective(const int context)
+{
+    std::lock_guard<mutex_t> g(mutex_);
+
+    auto& ptr = collectives_[context];
+
+    if (nullptr == ptr)
+    {
+        ptr.reset(new Collective);
+        ptr->slots.assign(num_tasks_, nullptr);
+    }
+
+    return *ptr;
+}
+
+/*****************************************
+ * send
+ *
+ * Matches with a posted recieve if there is
+ *   one, otherwise queues the send. The
+ *   future is ready once buf may be reused,
+ *   and on_done, if any, has run
+*****************************************/
+inline std::future<int> Thread_Group::send(const int context,
+                                           const int src_id,
+                                           const int dest_id,
+                                           const int tag,
+                                           const void* buf,
+                                           const size_t bytes,
+                                           on_done_t&& on_done)
+{
+    auto done   = std::make_shared<std::promise<int>>();
+    auto future = done->get_future();
+
+    auto& box = *mailboxes_[dest_id];
+
+    std::unique_lock<mutex_t> lk(box.m);
+
+    for (auto itr = box.recvs.begin(); itr != box.recvs.end(); itr++)
+    {
+        if (itr->context == context && itr->src_id == src_id && itr->tag == tag)
+        {
+            Recv recv = std::move(*itr);
+            box.recvs.erase(itr);
+            lk.unlock();
+
+            if (bytes > 0) memcpy(recv.buf, buf, std::min(bytes, recv.bytes));
+
+            if (nullptr != recv.on_done) recv.on_done();
+            recv.done->set_value(BEO_SUCCESS);
+
+            if (nullptr != on_done) on_done();
+            done->set_value(BEO_SUCCESS);
+
+            return future;
+        }
+    }
+
+    Send send{context, src_id, tag, buf, bytes, {}, done, std::move(on_done)};
+
+    if (bytes <= eager_bytes)
+    {
+        send.eager.assign((const char*) buf, (const char*) buf + bytes);
+        send.buf  = send.eager.data();
+        send.done = nullptr;
+
+        if (nullptr != send.on_done) send.on_done();
+        send.on_done = nullptr;
+        done->set_value(BEO_SUCCESS);
+    }
+
+    box.sends.push_back(std::move(send));
+
+    return future;
+}
+
+/*****************************************
+ * recv
+ *
+ * Matches with a queued send if there is
+ *   one, otherwise posts the recieve. The
+ *   future is ready once buf holds the data,
+ *   and on_done, if any, has run
+*****************************************/
+inline std::future<int> Thread_Group::recv(const int context,
+                                           const int src_id,
+                                           const int dest_id,
+                                           const int tag,
+                                           void* buf,
+                                           const size_t bytes,
+                                           on_done_t&& on_done)
+{
+    auto done   = std::make_shared<std::promise<int>>();
+    auto future = done->get_future();
+
+    auto& box = *mailboxes_[dest_id];
+
+    std::unique_lock<mutex_t> lk(box.m);
+
+    for (auto itr = box.sends.begin(); itr != box.sends.end(); itr++)
+    {
+        if (itr->context == context && itr->src_id == src_id && itr->tag == tag)
+        {
+            Send send = std::move(*itr);
+            box.sends.erase(itr);
+            lk.unlock();
+
+            if (send.bytes > 0) memcpy(buf, send.buf, std::min(bytes, send.bytes));
+
+            if (nullptr != send.done)
+            {
+                if (nullptr != send.on_done) send.on_done();
+                send.done->set_value(BEO_SUCCESS);
+            }
+
+            if (nullptr != on_done) on_done();
+            done->set_value(BEO_SUCCESS);
+
+            return future;
+        }
+    }
+
+    box.recvs.push_back({context, src_id, tag, buf, bytes, done, std::move(on_done)});
+
+    return future;
+}
+
+/*****************************************
+ * barrier
+*****************************************/
+inline int Thread_Group::barrier(const int context)
+{
+    auto& coll = collective(context);
+
+    std::unique_lock<mutex_t> lk(coll.m);
+
+    const size_t generation = coll.generation;
+
+    if (++coll.arrived == num_tasks_)
+    {
+        coll.arrived = 0;
+        coll.generation++;
+        coll.cv.notify_all();
+    }
+
+    else
+    {
+        coll.cv.wait(lk, [&]() {return generation != coll.generation;});
+    }
+
+    return BEO_SUCCESS;
+}
+
+/*****************************************
+ * exchange
+*****************************************/
+inline const std::vector<const void*>& Thread_Group::exchange(const int context,
+                                                              const int task_id,
+                                                              const void* mine)
+{
+    auto& coll = collective(context);
+
+    {
+        std::lock_guard<mutex_t> g(coll.m);
+        coll.slots[task_id] = mine;
+    }
+
+    barrier(context);
+
+    return coll.slots;
+}
+
+/*****************************************
+ * split
+ *
+ * The first member of each color makes
+ *   the new group, and hands it to the rest
+*****************************************/
+inline std::shared_ptr<Thread_Group> Thread_Group::split(const int context,
+                                                         const int task_id,
+                                                         const int color,
+                                                         const int key,
+                                                         int& new_id)
+{
+    const int mine[2] = {color, key};
+
+    const auto& slots = exchange(context, task_id, mine);
+
+    //members of my color, ordered by key then task id
+    std::vector<std::pair<int, int>> members;
+    for (int task = 0; task < num_tasks_; task++)
+    {
+        const int* other = (const int*) slots[task];
+        if (color >= 0 && other[0] == color) members.push_back({other[1], task});
+    }
+    std::sort(members.begin(), members.end());
+
+    auto& coll = collective(context);
+
+    const bool is_leader = !members.empty() && members[0].second == task_id;
+
+    if (is_leader)
+    {
+        std::lock_guard<mutex_t> g(coll.m);
+        coll.splits[color] = std::make_shared<Thread_Group>((int) members.size());
+    }
+
+    barrier(context);
+
+    std::shared_ptr<Thread_Group> group;
+
+    new_id = -1;
+
+    if (color >= 0)
+    {
+        std::lock_guard<mutex_t> g(coll.m);
+        group = coll.splits[color];
+        for (size_t i = 0; i < members.size(); i++) if (members[i].second == task_id) new_id = (int) i;
+    }
+
+    barrier(context);
+
+    if (is_leader)
+    {
+        std::lock_guard<mutex_t> g(coll.m);
+        coll.splits.erase(color);
+    }
+
+    return group;
+}
+
+/*****************************************
+ * launch
+ *
+ * Runs func on num_tasks threads. Returns
+ *   once they have all finished
+*****************************************/
+inline int launch(const int num_tasks, const std::function<void()>& func)
+{
+    auto group = std::make_shared<Thread_Group>(num_tasks);
+
+    std::vector<std::thread> threads;
+
+    for (int task = 0; task < group->num_tasks(); task++)
+    {
+        threads.emplace_back([group, task, &func]()
+        {
+            Thread_Group::current().group   = group;
+            Thread_Group::current().task_id = task;
+
+            func();
+
+            Thread_Group::current().group   = nullptr;
+            Thread_Group::current().task_id = 0;
+        });
+    }
+
+    for (auto& thread : threads) thread.join();
+
+    return BEO_SUCCESS;
+}
+
+} //end namespace beo
+
+#endif
@@ -0,0 +1,706 @@
+/*****************************************
+ * thread_pool.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for the beo::Thread_Pool
+ *   class, which is a bounded,
+ *   work-stealing pool of threads that
+ *   the asynchronous non-MPI operations
+ *   are run on
+ *
+ * Each worker owns a deque of tasks.
+ *   Workers pop from the back of their
+ *   own deque, and steal from the front
+ *   of the other workers' deques when
+ *   their own is empty. Tasks submitted
+ *   from outside the pool are dealt
+ *   round-robin to the workers, unless
+ *   submit_to names one.
+ *
+ * Workers steal from the workers of their
+ *   own NUMA domain first. On Linux the
+ *   domains are read from sysfs, and if
+ *   there is more than one, each worker
+ *   is pinned to the cpus of its domain
+ *   (those this process may run on).
+ *   set_domains overrides this.
+ *
+ * The pool is bounded by max_queue_depth.
+ *   When that many tasks are already
+ *   queued, submit runs the task on the
+ *   calling thread instead (caller-runs),
+ *   so 10k async reads never means 10k
+ *   threads or an unbounded queue.
+ *
+ * The beo::Enviroment owns a pool and
+ *   registers it with set_thread_pool.
+ *   beo::thread_pool() returns the
+ *   registered pool, or a lazily created
+ *   default one if there is none. With
+ *   _BEO_THREADS_ the registration is per
+ *   task thread, and the owner of a pool
+ *   registers its own pool (and event
+ *   loop and counters) on the workers
+ *   with set_worker_init, so tasks run on
+ *   them see those of the task.
+ *
+ * The size of the default pool can be
+ *   set with the BEO_NUM_THREADS
+ *   enviroment variable
+*****************************************/
+#ifndef _BEO_THREAD_POOL_HPP_
+#define _BEO_THREAD_POOL_HPP_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <future>
+#include <functional>
+#include <condition_variable>
+
+#if defined __linux__
+#include <sched.h>
+#include <pthread.h>
+#endif
+
+#include "def.hpp"
+
+namespace beo
+{
+
+class Thread_Pool
+{
+    public:
+
+        using task_t  = std::function<void()>;
+
+        using mutex_t = std::mutex;
+
+        //Snapshot of the pool statistics
+        struct Stats
+        {
+            size_t num_threads{0};
+
+            size_t max_queue_depth{0};
+
+            size_t submitted{0};
+
+            size_t run_inline{0};
+
+            //per-worker statistics
+            std::vector<size_t> queue_depth;
+
+            std::vector<size_t> max_depth_seen;
+
+            std::vector<size_t> executed;
+
+            std::vector<size_t> stolen;
+        };
+
+    protected:
+
+        struct Worker
+        {
+            std::deque<task_t> queue;
+
+            mutex_t m;
+
+            size_t max_depth{0};
+
+            std::atomic<size_t> executed{0};
+
+            std::atomic<size_t> stolen{0};
+
+            std::atomic<int> domain{0};
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+
+        std::vector<std::thread> threads_;
+
+        mutex_t init_mutex_;
+
+        mutex_t sleep_mutex_;
+
+        std::condition_variable sleep_cv_;
+
+        std::atomic<bool>   is_running_{false};
+
+        std::atomic<bool>   stop_{false};
+
+        std::atomic<size_t> queued_{0};
+
+        std::atomic<size_t> next_{0};
+
+        std::atomic<size_t> submitted_{0};
+
+        std::atomic<size_t> run_inline_{0};
+
+        size_t max_queue_depth_{0};
+
+        //run by each worker as it starts
+        task_t worker_init_;
+
+        //cpus of each NUMA domain the workers are pinned to, if more than one
+        std::vector<std::vector<int>> domain_cpus_;
+
+        //id of the worker on the calling thread, -1 if not a worker of this pool
+        static int& worker_id();
+
+        static Thread_Pool*& worker_pool();
+
+        void worker_loop(const int id);
+
+        bool pop(const int id, task_t& task);
+
+        void push(task_t&& task, const int id = -1);
+
+        bool steal(const int id, const int victim, task_t& task);
+
+        void pin(const int id);
+
+    public:
+
+        Thread_Pool() {}
+
+        Thread_Pool(const size_t num_threads,
+                    const size_t max_queue_depth);
+
+       ~Thread_Pool() {finalize();}
+
+        Thread_Pool(const Thread_Pool& other) = delete;
+
+        Thread_Pool& operator=(const Thread_Pool& other) = delete;
+
+        int init(const size_t num_threads,
+                 const size_t max_queue_depth);
+
+        int init();
+
+        void finalize();
+
+        //Run by each worker as it starts. Set it before the pool is
+        //  started, e.g., to register the owning task's pool on it
+        void set_worker_init(task_t&& init) {worker_init_ = std::move(init);}
+
+        bool is_running() const {return is_running_;}
+
+        size_t num_threads() const {return threads_.size();}
+
+        size_t max_queue_depth() const {return max_queue_depth_;}
+
+        size_t queue_depth() const {return queued_;}
+
+        template<typename F>
+        std::future<int> submit(F&& func);
+
+        //As submit, but queued on the given worker
+        template<typename F>
+        std::future<int> submit_to(const size_t worker, F&& func);
+
+        int domain(const size_t worker) const {return workers_[worker]->domain;}
+
+        //NUMA domain of each worker, for stealing. Does not pin them
+        int set_domains(const std::vector<int>& domains);
+
+        bool run_one();
+
+        Stats stats();
+
+        static size_t default_num_threads();
+
+        static std::vector<std::vector<int>> numa_cpus();
+};
+
+//Access to the pool that async operations are run on
+Thread_Pool& thread_pool();
+
+void set_thread_pool(Thread_Pool* pool);
+
+/*****************************************
+ * static helpers
+*****************************************/
+inline int& Thread_Pool::worker_id()
+{
+    static thread_local int id = -1;
+    return id;
+}
+
+inline Thread_Pool*& Thread_Pool::worker_pool()
+{
+    static thread_local Thread_Pool* pool = nullptr;
+    return pool;
+}
+
+/*****************************************
+ * default_num_threads
+ *
+ * BEO_NUM_THREADS if set, otherwise the
+ *   hardware concurrency
+*****************************************/
+inline size_t Thread_Pool::default_num_threads()
+{
+    const char* env = getenv("BEO_NUM_THREADS");
+
+    if (nullptr != env && atoi(env) > 0) return (size_t) atoi(env);
+
+    const size_t hw = std::thread::hardware_concurrency();
+
+    return (hw > 0) ? hw : 1;
+}
+
+/*****************************************
+ * numa_cpus
+ *
+ * The cpus of each NUMA domain that this
+ *   process may run on, from sysfs. Empty
+ *   if that is not known
+*****************************************/
+inline std::vector<std::vector<int>> Thread_Pool::numa_cpus()
+{
+    std::vector<std::vector<int>> domains;
+
+    #if defined __linux__
+
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (0 != sched_getaffinity(0, sizeof(allowed), &allowed)) return domains;
+
+    for (int node = 0; ; node++)
+    {
+        const std::string name = "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+
+        FILE* fp = fopen(name.c_str(), "r");
+        if (nullptr == fp) break;
+
+        //e.g., 0-3,8-11
+        std::vector<int> cpus;
+        int first, last;
+        while (1 == fscanf(fp, "%d", &first))
+        {
+            last = first;
+            if (1 == fscanf(fp, "-%d", &last)) {}
+            for (int cpu = first; cpu <= last; cpu++)
+            {
+                if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+            }
+            if (',' != fgetc(fp)) break;
+        }
+
+        fclose(fp);
+
+        if (!cpus.empty()) domains.push_back(std::move(cpus));
+    }
+
+    #endif
+
+    return domains;
+}
+
+/*****************************************
+ * Constructors
+*****************************************/
+inline Thread_Pool::Thread_Pool(const size_t num_threads,
+                                const size_t max_queue_depth)
+{
+    init(num_threads, max_queue_depth);
+}
+
+/*****************************************
+ * init
+ *
+ * Starts the worker threads. A max_queue_depth
+ *   of 0 defaults to 64 tasks per thread
+ *
+ * Returns BEO_FAIL if the pool is already
+ *   running
+*****************************************/
+inline int Thread_Pool::init(const size_t num_threads,
+                             const size_t max_queue_depth)
+{
+    std::lock_guard<mutex_t> g(init_mutex_);
+
+    if (is_running()) return BEO_FAIL;
+
+    const size_t nthreads = (num_threads > 0) ? num_threads : 1;
+
+    max_queue_depth_ = (max_queue_depth > 0) ? max_queue_depth : 64 * nthreads;
+
+    stop_ = false;
+
+    workers_.clear();
+    for (size_t i = 0; i < nthreads; i++) workers_.emplace_back(new Worker);
+
+    //workers are spread over the domains in blocks
+    domain_cpus_ = numa_cpus();
+    if (domain_cpus_.size() < 2) domain_cpus_.clear();
+    for (size_t i = 0; i < nthreads && !domain_cpus_.empty(); i++)
+    {
+        workers_[i]->domain = (int) (i * domain_cpus_.size() / nthreads);
+    }
+
+    threads_.reserve(nthreads);
+    for (size_t i = 0; i < nthreads; i++)
+    {
+        threads_.emplace_back(&Thread_Pool::worker_loop, this, (int) i);
+    }
+
+    is_running_ = true;
+
+    return BEO_SUCCESS;
+}
+
+inline int Thread_Pool::init()
+{
+    return init(default_num_threads(), 0);
+}
+
+/*****************************************
+ * set_domains
+ *
+ * One domain per worker. Returns BEO_FAIL
+ *   if the pool is not running or the
+ *   sizes do not match
+*****************************************/
+inline int Thread_Pool::set_domains(const std::vector<int>& domains)
+{
+    if (!is_running() || domains.size() != workers_.size()) return BEO_FAIL;
+
+    for (size_t i = 0; i < domains.size(); i++) workers_[i]->domain = domains[i];
+
+    return BEO_SUCCESS;
+}
+
+/*****************************************
+ * pin
+ *
+ * Pins the calling worker to the cpus of
+ *   its domain
+*****************************************/
+inline void Thread_Pool::pin(const int id)
+{
+    #if defined __linux__
+
+    if (domain_cpus_.empty()) return;
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (const int cpu : domain_cpus_[workers_[id]->domain]) CPU_SET(cpu, &cpus);
+
+    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+
+    #else
+
+    (void) id;
+
+    #endif
+}
+
+/*****************************************
+ * finalize
+ *
+ * Runs whatever is still queued, then
+ *   joins the worker threads
+*****************************************/
+inline void Thread_Pool::finalize()
+{
+    std::lock_guard<mutex_t> g(init_mutex_);
+
+    if (!is_running()) return;
+
+    {
+        std::lock_guard<mutex_t> sg(sleep_mutex_);
+        stop_ = true;
+    }
+    sleep_cv_.notify_all();
+
+    for (auto& thread : threads_) thread.join();
+
+    threads_.clear();
+
+    is_running_ = false;
+}
+
+/*****************************************
+ * push
+ *
+ * Tasks go to the back of worker id's
+ *   deque. Without an id, tasks submitted
+ *   from a worker go to that worker,
+ *   otherwise they are dealt round-robin
+*****************************************/
+inline void Thread_Pool::push(task_t&& task, const int id)
+{
+    const size_t target = (id >= 0) ? (size_t) id
+                        : (worker_pool() == this && worker_id() >= 0)
+                        ? (size_t) worker_id()
+                        : next_++ % workers_.size();
+
+    auto& worker = *workers_[target];
+
+    {
+        std::lock_guard<mutex_t> g(worker.m);
+        worker.queue.push_back(std::move(task));
+        if (worker.queue.size() > worker.max_depth) worker.max_depth = worker.queue.size();
+        queued_++;
+    }
+
+    {
+        std::lock_guard<mutex_t> sg(sleep_mutex_);
+    }
+    sleep_cv_.notify_one();
+}
+
+/*****************************************
+ * pop
+ *
+ * Takes a task from the back of worker id's
+ *   own deque, or steals one from the front
+ *   of another's, trying those in the same
+ *   domain first. An id of -1 only steals.
+*****************************************/
+inline bool Thread_Pool::pop(const int id, task_t& task)
+{
+    const int nworkers = (int) workers_.size();
+
+    if (id >= 0)
+    {
+        auto& worker = *workers_[id];
+        std::lock_guard<mutex_t> g(worker.m);
+        if (!worker.queue.empty())
+        {
+            task = std::move(worker.queue.back());
+            worker.queue.pop_back();
+            queued_--;
+            return true;
+        }
+    }
+
+    const int start = (id >= 0) ? id + 1 : (int) (next_ % nworkers);
+
+    const int domain = (id >= 0) ? workers_[id]->domain.load() : -1;
+
+    //near victims, then far ones
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int i = 0; i < nworkers; i++)
+        {
+            const int victim = (start + i) % nworkers;
+            if (victim == id) continue;
+
+            const bool is_near = domain < 0 || workers_[victim]->domain == domain;
+            if (is_near != (0 == pass)) continue;
+
+            if (steal(id, victim, task)) return true;
+        }
+    }
+
+    return false;
+}
+
+inline bool Thread_Pool::steal(const int id, const int victim, task_t& task)
+{
+    auto& worker = *workers_[victim];
+    std::lock_guard<mutex_t> g(worker.m);
+
+    if (worker.queue.empty()) return false;
+
+    task = std::move(worker.queue.front());
+    worker.queue.pop_front();
+    queued_--;
+    if (id >= 0) workers_[id]->stolen++;
+
+    return true;
+}
+
+/*****************************************
+ * worker_loop
+*****************************************/
+inline void Thread_Pool::worker_loop(const int id)
+{
+    worker_id()   = id;
+    worker_pool() = this;
+
+    pin(id);
+
+    if (worker_init_) worker_init_();
+
+    task_t task;
+
+    while (true)
+    {
+        if (pop(id, task))
+        {
+            task();
+            task = nullptr;
+            workers_[id]->executed++;
+            continue;
+        }
+
+        std::unique_lock<mutex_t> lk(sleep_mutex_);
+        if (stop_ && 0 == queued_) break;
+        sleep_cv_.wait(lk, [this]() {return stop_ || queued_ > 0;});
+    }
+
+    worker_id()   = -1;
+    worker_pool() = nullptr;
+}
+
+/*****************************************
+ * submit
+ *
+ * Queues func (which returns an int status)
+ *   on the pool and returns a future for
+ *   that status. If the pool is full,
+ *   func is run on the calling thread.
+*****************************************/
+template<typename F>
+inline std::future<int> Thread_Pool::submit(F&& func)
+{
+    if (!is_running()) init();
+
+    auto task = std::make_shared<std::packaged_task<int()>>(std::forward<F>(func));
+
+    auto future = task->get_future();
+
+    submitted_++;
+
+    if (queued_ >= max_queue_depth_)
+    {
+        run_inline_++;
+        (*task)();
+        return future;
+    }
+
+    push([task]() {(*task)();});
+
+    return future;
+}
+
+template<typename F>
+inline std::future<int> Thread_Pool::submit_to(const size_t worker, F&& func)
+{
+    if (!is_running()) init();
+
+    auto task = std::make_shared<std::packaged_task<int()>>(std::forward<F>(func));
+
+    auto future = task->get_future();
+
+    submitted_++;
+
+    if (queued_ >= max_queue_depth_)
+    {
+        run_inline_++;
+        (*task)();
+        return future;
+    }
+
+    push([task]() {(*task)();}, (int) (worker % workers_.size()));
+
+    return future;
+}
+
+/*****************************************
+ * run_one
+ *
+ * Runs one queued task on the calling thread.
+ *   This lets threads that are waiting on
+ *   the pool help drain it.
+ *
+ * Returns false if there was nothing to run
+*****************************************/
+inline bool Thread_Pool::run_one()
+{
+    if (!is_running()) return false;
+
+    task_t task;
+
+    const int id = (worker_pool() == this) ? worker_id() : -1;
+
+    if (!pop(id, task)) return false;
+
+    task();
+
+    if (id >= 0) workers_[id]->executed++;
+
+    return true;
+}
+
+/*****************************************
+ * stats
+ *
+ * Returns a snapshot of the queue-depth
+ *   and task statistics of the pool
+*****************************************/
+inline Thread_Pool::Stats Thread_Pool::stats()
+{
+    Stats stats;
+
+    stats.num_threads     = num_threads();
+    stats.max_queue_depth = max_queue_depth_;
+    stats.submitted       = submitted_;
+    stats.run_inline      = run_inline_;
+
+    for (auto& worker : workers_)
+    {
+        std::lock_guard<mutex_t> g(worker->m);
+        stats.queue_depth.push_back(worker->queue.size());
+        stats.max_depth_seen.push_back(worker->max_depth);
+        stats.executed.push_back(worker->executed);
+        stats.stolen.push_back(worker->stolen);
+    }
+
+    return stats;
+}
+
+/*****************************************
+ * thread_pool registration
+ *
+ * The registered pool is used if there is
+ *   one, otherwise a default pool is
+ *   created on first use
+*****************************************/
+inline std::atomic<Thread_Pool*>& registered_thread_pool()
+{
+    #if defined _BEO_THREADS_
+
+    //each task (thread) has its own enviroment, and so its own pool
+    static thread_local std::atomic<Thread_Pool*> pool{nullptr};
+
+    #else
+
+    //the workers read it while the Enviroment sets it
+    static std::atomic<Thread_Pool*> pool{nullptr};
+
+    #endif
+
+    return pool;
+}
+
+inline void set_thread_pool(Thread_Pool* pool)
+{
+    registered_thread_pool() = pool;
+}
+
+inline Thread_Pool& thread_pool()
+{
+    Thread_Pool* pool = registered_thread_pool();
+
+    if (nullptr != pool) return *pool;
+
+    static Thread_Pool default_pool;
+
+    return default_pool;
+}
+
+} //end namespace beo
+
+#endif
@@ -0,0 +1,385 @@
+/*****************************************
+ * trace.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Trace, the opt-in
+ *   communication tracing. Build with
+ *   _BEO_TRACE_ to turn it on; otherwise
+ *   BEO_TRACE compiles to nothing.
+ *
+ * BEO_TRACE(op, peer, tag, bytes) near the
+ *   top of an operation records, when the
+ *   enclosing scope ends, one event with
+ *   the task, thread, start time, time
+ *   spent (for waits, the time blocked),
+ *   peer, tag, and bytes.
+ *
+ * Each thread records into its own ring
+ *   buffer of BEO_TRACE_EVENTS events
+ *   (default 65536), so recording takes
+ *   no locks. When a ring is full the
+ *   oldest events are overwritten.
+ *
+ * The beo::Enviroment starts the clock in
+ *   its constructor, and at finalize
+ *   merges every task's events into one
+ *   Chrome trace / Perfetto JSON file
+ *   (see Enviroment/tracing.hpp)
+*****************************************/
+#ifndef _BEO_TRACE_HPP_
+#define _BEO_TRACE_HPP_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+namespace beo
+{
+
+class Trace
+{
+    public:
+
+        using clock_t = std::chrono::steady_clock;
+
+        using mutex_t = std::mutex;
+
+        enum class Op : int32_t
+        {
+            send_recv,
+            async_send_recv,
+            barrier,
+            async_barrier,
+            broadcast,
+            reduce,
+            allreduce,
+            async_allreduce,
+            allgather,
+            wait,
+            file_read,
+            file_write,
+            file_read_at,
+            file_write_at,
+            file_read_at_all,
+            file_write_at_all,
+            file_async_read_at,
+            file_async_write_at,
+            file_async_read_at_all,
+            file_async_write_at_all,
+            num_ops
+        };
+
+        //plain data, so it can be sent between tasks
+        struct Event
+        {
+            int64_t  start_ns;
+
+            int64_t  dur_ns;
+
+            uint64_t bytes;
+
+            int32_t  op;
+
+            int32_t  rank;
+
+            int32_t  peer;
+
+            int32_t  tag;
+
+            uint32_t tid;
+
+            uint32_t pad;
+        };
+
+    protected:
+
+        struct Buffer
+        {
+            std::vector<Event>    events;
+
+            std::atomic<uint64_t> count{0};
+
+            uint32_t              tid{0};
+        };
+
+        mutex_t                              mutex_;
+
+        std::vector<std::shared_ptr<Buffer>> buffers_;
+
+        size_t                               capacity_;
+
+        std::atomic<int64_t>                 start_ns_{0};
+
+        std::atomic<bool>                    is_started_{false};
+
+        Trace();
+
+        Buffer& buffer();
+
+    public:
+
+        Trace(const Trace& other) = delete;
+
+        Trace& operator=(const Trace& other) = delete;
+
+        static Trace& instance();
+
+        static const char* name(const int32_t op);
+
+        //world task id of the calling thread's task, -1 if unknown
+        static int& rank();
+
+        //true while the calling thread should not record
+        static bool& is_paused();
+
+        static int64_t clock_ns();
+
+        //starts the clock, if it has not been started already
+        void start();
+
+        //nanoseconds since start
+        int64_t now() const {return clock_ns() - start_ns_;}
+
+        void record(const Op op,
+                    const int64_t start_ns,
+                    const int peer,
+                    const int tag,
+                    const size_t bytes);
+
+        //the events of task rank, and (if with_unknown) of unknown tasks
+        std::vector<Event> events(const int rank, const bool with_unknown);
+
+        //events that were overwritten
+        size_t num_dropped();
+};
+
+/*****************************************
+ * Trace_Scope
+ *
+ * Records one event when it goes out of
+ *   scope
+*****************************************/
+class Trace_Scope
+{
+    protected:
+
+        Trace::Op op_;
+
+        int64_t   start_ns_;
+
+        int       peer_;
+
+        int       tag_;
+
+        size_t    bytes_;
+
+        bool      is_active_;
+
+    public:
+
+        Trace_Scope(const Trace::Op op, const int peer, const int tag, const size_t bytes, const bool is_active = true)
+        : op_(op), start_ns_(is_active ? Trace::instance().now() : 0), peer_(peer), tag_(tag), bytes_(bytes), is_active_(is_active) {}
+
+       ~Trace_Scope() {if (is_active_) Trace::instance().record(op_, start_ns_, peer_, tag_, bytes_);}
+
+        Trace_Scope(const Trace_Scope& other) = delete;
+
+        Trace_Scope& operator=(const Trace_Scope& other) = delete;
+};
+
+//BEO_TRACE_IF only records if is_active, e.g., if this task takes part
+#if defined _BEO_TRACE_
+#define BEO_TRACE(op, peer, tag, bytes) \
+    beo::Trace_Scope beo_trace_scope_(beo::Trace::Op::op, (peer), (tag), (bytes))
+#define BEO_TRACE_IF(is_active, op, peer, tag, bytes) \
+    beo::Trace_Scope beo_trace_scope_(beo::Trace::Op::op, (peer), (tag), (bytes), (is_active))
+#else
+#define BEO_TRACE(op, peer, tag, bytes)
+#define BEO_TRACE_IF(is_active, op, peer, tag, bytes)
+#endif
+
+/*****************************************
+ * Constructor
+*****************************************/
+inline Trace::Trace()
+{
+    const char* env = getenv("BEO_TRACE_EVENTS");
+
+    capacity_ = (nullptr != env && atoi(env) > 0) ? (size_t) atoi(env) : 65536;
+
+    start_ns_ = clock_ns();
+}
+
+/*****************************************
+ * static helpers
+*****************************************/
+inline Trace& Trace::instance()
+{
+    static Trace trace;
+    return trace;
+}
+
+inline const char* Trace::name(const int32_t op)
+{
+    static const char* names[] = {"send_recv",
+                                  "async_send_recv",
+                                  "barrier",
+                                  "async_barrier",
+                                  "broadcast",
+                                  "reduce",
+                                  "allreduce",
+                                  "async_allreduce",
+                                  "allgather",
+                                  "wait",
+                                  "file_read",
+                                  "file_write",
+                                  "file_read_at",
+                                  "file_write_at",
+                                  "file_read_at_all",
+                                  "file_write_at_all",
+                                  "file_async_read_at",
+                                  "file_async_write_at",
+                                  "file_async_read_at_all",
+                                  "file_async_write_at_all"};
+
+    return (op >= 0 && op < (int32_t) Op::num_ops) ? names[op] : "unknown";
+}
+
+inline int& Trace::rank()
+{
+    #if defined _BEO_THREADS_
+
+    static thread_local int rank = -1;
+
+    #else
+
+    static int rank = -1;
+
+    #endif
+
+    return rank;
+}
+
+inline bool& Trace::is_paused()
+{
+    static thread_local bool paused = false;
+    return paused;
+}
+
+inline int64_t Trace::clock_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now().time_since_epoch()).count();
+}
+
+inline void Trace::start()
+{
+    bool expected = false;
+
+    if (is_started_.compare_exchange_strong(expected, true)) start_ns_ = clock_ns();
+}
+
+/*****************************************
+ * buffer
+ *
+ * The calling thread's ring, registered
+ *   on first use. The registry keeps it
+ *   alive after the thread exits
+*****************************************/
+inline Trace::Buffer& Trace::buffer()
+{
+    static thread_local Buffer* local = nullptr;
+
+    if (nullptr == local)
+    {
+        auto buffer = std::make_shared<Buffer>();
+        buffer->events.resize(capacity_);
+
+        std::lock_guard<mutex_t> g(mutex_);
+        buffer->tid = (uint32_t) buffers_.size();
+        buffers_.push_back(buffer);
+
+        local = buffer.get();
+    }
+
+    return *local;
+}
+
+/*****************************************
+ * record
+*****************************************/
+inline void Trace::record(const Op op,
+                          const int64_t start_ns,
+                          const int peer,
+                          const int tag,
+                          const size_t bytes)
+{
+    if (is_paused() || !is_started_) return;
+
+    auto& buf = buffer();
+
+    const uint64_t count = buf.count.load(std::memory_order_relaxed);
+
+    buf.events[count % capacity_] = {start_ns,
+                                     now() - start_ns,
+                                     (uint64_t) bytes,
+                                     (int32_t) op,
+                                     (int32_t) rank(),
+                                     (int32_t) peer,
+                                     (int32_t) tag,
+                                     buf.tid,
+                                     0};
+
+    buf.count.store(count + 1, std::memory_order_release);
+}
+
+/*****************************************
+ * events
+ *
+ * Snapshot of the recorded events, oldest
+ *   first within each thread
+*****************************************/
+inline std::vector<Trace::Event> Trace::events(const int rank, const bool with_unknown)
+{
+    std::lock_guard<mutex_t> g(mutex_);
+
+    std::vector<Event> events;
+
+    for (const auto& buf : buffers_)
+    {
+        const uint64_t count = buf->count.load(std::memory_order_acquire);
+        const uint64_t first = (count > capacity_) ? count - capacity_ : 0;
+
+        for (uint64_t i = first; i < count; i++)
+        {
+            const auto& event = buf->events[i % capacity_];
+            if (event.rank == rank || (with_unknown && event.rank < 0)) events.push_back(event);
+        }
+    }
+
+    return events;
+}
+
+inline size_t Trace::num_dropped()
+{
+    std::lock_guard<mutex_t> g(mutex_);
+
+    size_t dropped = 0;
+
+    for (const auto& buf : buffers_)
+    {
+        const uint64_t count = buf->count.load(std::memory_order_acquire);
+        if (count > capacity_) dropped += count - capacity_;
+    }
+
+    return dropped;
+}
+
+} //end namespace beo
+
+#endif
@@ -0,0 +1,555 @@
+/*****************************************
+ * aggregator.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Aggregator,
+ *   which coalesces many small messages
+ *   to the same task into one.
+ *
+ * post() takes the same arguments as
+ *   beo::async_send_recv. On the sender
+ *   the message is copied into a per-
+ *   destination buffer, which is sent
+ *   as one message once it holds
+ *   flush_bytes, or once its oldest
+ *   message is flush_seconds old. On the
+ *   reciever post() registers where the
+ *   message should go; when the buffer
+ *   arrives it is unpacked back into the
+ *   individual destinations, matched in
+ *   order by source and tag.
+ *
+ * Nothing moves unless progress(),
+ *   flush(), or wait() are called. wait()
+ *   flushes everything and returns once
+ *   this task's posted sends and recieves
+ *   are complete, so both sides should
+ *   call it.
+ *
+ * With _BEO_THREADS_ or _BEO_SHM_ there
+ *   is nothing to gain from packing, and
+ *   each post() is sent directly.
+ *
+ * The Aggregator communicates on its
+ *   own duplicate of the comm, so the
+ *   constructor is collective. Messages
+ *   larger than flush_bytes gain nothing
+ *   here, and should use async_send_recv.
+*****************************************/
+#ifndef _BEO_AGGREGATOR_HPP_
+#define _BEO_AGGREGATOR_HPP_
+
+#if defined _BEO_MPI_
+#include <mpi.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <chrono>
+#include <utility>
+
+#include "../L0/l0.hpp"
+
+namespace beo
+{
+
+class Aggregator
+{
+    public:
+
+        using mutex_t = std::recursive_mutex;
+
+        using clock_t = std::chrono::steady_clock;
+
+        using buffer_t = std::vector<char>;
+
+        mutex_t m;
+
+    protected:
+
+        //Each message in a buffer is a header and then the padded payload
+        struct Header
+        {
+            int    tag;
+
+            size_t bytes;
+        };
+
+        struct Send_Buffer
+        {
+            buffer_t           data;
+
+            clock_t::time_point first;
+
+            size_t             num_messages{0};
+        };
+
+        struct Recv
+        {
+            int    src_id;
+
+            int    tag;
+
+            void*  dest;
+
+            size_t bytes;
+        };
+
+        struct Unexpected
+        {
+            int      src_id;
+
+            int      tag;
+
+            buffer_t data;
+        };
+
+        Comm                     comm_;
+
+        size_t                   flush_bytes_;
+
+        double                   flush_seconds_;
+
+        std::vector<Send_Buffer> send_buffers_;
+
+        std::deque<Recv>         posted_;
+
+        std::deque<Unexpected>   unexpected_;
+
+        #if defined _BEO_MPI_
+
+        std::list<std::pair<buffer_t, MPI_Request>> in_flight_;
+
+        #elif defined _BEO_THREADS_ || defined _BEO_SHM_
+
+        //the tasks share memory, so each message is sent directly,
+        //  from a copy so that src may be reused
+        std::list<std::pair<buffer_t, Request>> in_flight_;
+
+        #endif
+
+        //statistics
+        size_t                   num_posted_{0};
+
+        size_t                   num_sent_{0};
+
+        size_t                   bytes_sent_{0};
+
+        static size_t padded(const size_t bytes) {return (bytes + 7) / 8 * 8;}
+
+        void unpack(const int src_id, const buffer_t& buffer);
+
+        bool match(const int src_id, const int tag, const char* data, const size_t bytes);
+
+    public:
+
+        Aggregator(Comm& comm,
+                   const size_t flush_bytes = 65536,
+                   const double flush_seconds = 1.0e-3);
+
+       ~Aggregator() {}
+
+        Aggregator(const Aggregator& other) = delete;
+
+        Aggregator& operator=(const Aggregator& other) = delete;
+
+        Comm& comm() {return comm_;}
+
+        size_t flush_bytes() const {return flush_bytes_;}
+
+        double flush_seconds() const {return flush_seconds_;}
+
+        int post(void*       dest,
+                 const void* src,
+                 size_t      bytes,
+                 int         dest_id,
+                 int         src_id,
+                 int         tag);
+
+        int flush(const int dest_id);
+
+        int flush();
+
+        int progress();
+
+        bool is_complete();
+
+        int wait();
+
+        void finalize();
+
+        size_t num_posted() const {return num_posted_;}
+
+        size_t num_sent() const {return num_sent_;}
+
+        size_t bytes_sent() const {return bytes_sent_;}
+
+};
+
+/*****************************************
+ * Constructor
+ *
+ * Collective over comm
+*****************************************/
+inline Aggregator::Aggregator(Comm& comm,
+                              const size_t flush_bytes,
+                              const double flush_seconds)
+{
+    comm_          = comm;
+    flush_bytes_   = flush_bytes;
+    flush_seconds_ = flush_seconds;
+
+    send_buffers_.resize(comm_.num_tasks());
+}
+
+/*****************************************
+ * post
+ *
+ * The Aggregator version of async_send_recv.
+ *   The sender's src may be reused as soon
+ *   as this returns. The reciever's dest is
+ *   filled in by a later progress() or wait()
+*****************************************/
+inline int Aggregator::post(void*       dest,
+                            const void* src,
+                            size_t      bytes,
+                            int         dest_id,
+                            int         src_id,
+                            int         tag)
+{
+    if (dest_id >= comm_.num_tasks())
+    {
+        printf("beo::Aggregator::post Task %d input dest_id(%d) is invalid\n", comm_.task_id(), dest_id);
+        exit(1);
+    }
+
+    if (src_id >= comm_.num_tasks())
+    {
+        printf("beo::Aggregator::post Task %d input src_id(%d) is invalid\n", comm_.task_id(), src_id);
+        exit(1);
+    }
+
+    std::lock_guard<mutex_t> g(m);
+
+    const int me = comm_.task_id();
+
+    if (src_id == dest_id && me == src_id) return beo::memmove(dest, src, bytes);
+
+    #if defined _BEO_MPI_
+
+    //sender, append to the buffer for dest_id
+    if (me == src_id)
+    {
+        auto& buffer = send_buffers_[dest_id];
+
+        if (buffer.data.empty()) buffer.first = clock_t::now();
+
+        Header header{tag, bytes};
+
+        const size_t pos = buffer.data.size();
+        buffer.data.resize(pos + sizeof(Header) + padded(bytes));
+        memcpy(buffer.data.data() + pos, &header, sizeof(Header));
+        if (bytes > 0) memcpy(buffer.data.data() + pos + sizeof(Header), src, bytes);
+        buffer.num_messages++;
+
+        num_posted_++;
+
+        if (buffer.data.size() >= flush_bytes_) return flush(dest_id);
+
+        return progress();
+    }
+
+    //reciever, check what has already arrived, otherwise register the dest
+    else if (me == dest_id)
+    {
+        num_posted_++;
+
+        for (auto itr = unexpected_.begin(); itr != unexpected_.end(); itr++)
+        {
+            if (itr->src_id == src_id && itr->tag == tag)
+            {
+                if (bytes > 0) memcpy(dest, itr->data.data(), std::min(bytes, itr->data.size()));
+                unexpected_.erase(itr);
+                return BEO_SUCCESS;
+            }
+        }
+
+        posted_.push_back({src_id, tag, dest, bytes});
+
+        return progress();
+    }
+
+    return BEO_SUCCESS;
+
+    #elif defined _BEO_THREADS_ || defined _BEO_SHM_
+
+    if (me != src_id && me != dest_id) return BEO_SUCCESS;
+
+    num_posted_++;
+
+    buffer_t copy;
+    if (me == src_id) copy.assign((const char*) src, (const char*) src + bytes);
+
+    in_flight_.emplace_back(std::move(copy), Request());
+
+    auto& [data, request] = in_flight_.back();
+
+    request = beo::async_send_recv(comm_, dest, data.data(), bytes, dest_id, src_id, tag);
+
+    if (me == src_id)
+    {
+        num_sent_++;
+        bytes_sent_ += bytes;
+    }
+
+    return BEO_SUCCESS;
+
+    #else
+
+    (void) tag;
+
+    return beo::memmove(dest, src, bytes);
+
+    #endif
+}
+
+/*****************************************
+ * flush
+ *
+ * Sends the buffered messages for dest_id,
+ *   or for every task
+*****************************************/
+inline int Aggregator::flush(const int dest_id)
+{
+    std::lock_guard<mutex_t> g(m);
+
+    auto& buffer = send_buffers_[dest_id];
+
+    if (buffer.data.empty()) return BEO_SUCCESS;
+
+    #if defined _BEO_MPI_
+
+    in_flight_.emplace_back(std::move(buffer.data), MPI_REQUEST_NULL);
+
+    auto& [data, request] = in_flight_.back();
+
+    int stat = MPI_Isend(data.data(),
+                         (int) data.size(),
+                         MPI_CHAR,
+                         dest_id,
+                         0,
+                         comm_.comm(),
+                         &request);
+
+    num_sent_++;
+    bytes_sent_ += data.size();
+
+    #else
+
+    int stat = 0;
+
+    #endif
+
+    buffer.data = buffer_t();
+    buffer.num_messages = 0;
+
+    return (0 == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+inline int Aggregator::flush()
+{
+    std::lock_guard<mutex_t> g(m);
+
+    int stat = BEO_SUCCESS;
+
+    for (int task = 0; task < comm_.num_tasks(); task++) stat |= flush(task);
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+/*****************************************
+ * match
+ *
+ * Copies a message into the first posted
+ *   recieve with the same source and tag.
+ *   Returns false if there is none
+*****************************************/
+inline bool Aggregator::match(const int src_id,
+                              const int tag,
+                              const char* data,
+                              const size_t bytes)
+{
+    for (auto itr = posted_.begin(); itr != posted_.end(); itr++)
+    {
+        if (itr->src_id == src_id && itr->tag == tag)
+        {
+            if (bytes > 0) memcpy(itr->dest, data, std::min(bytes, itr->bytes));
+            posted_.erase(itr);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*****************************************
+ * unpack
+ *
+ * Splits a recieved buffer back into its
+ *   messages
+*****************************************/
+inline void Aggregator::unpack(const int src_id, const buffer_t& buffer)
+{
+    size_t pos = 0;
+
+    while (pos < buffer.size())
+    {
+        Header header;
+        memcpy(&header, buffer.data() + pos, sizeof(Header));
+        pos += sizeof(Header);
+
+        const char* payload = buffer.data() + pos;
+
+        if (!match(src_id, header.tag, payload, header.bytes))
+        {
+            unexpected_.push_back({src_id, header.tag, buffer_t(payload, payload + header.bytes)});
+        }
+
+        pos += padded(header.bytes);
+    }
+}
+
+/*****************************************
+ * progress
+ *
+ * Flushes buffers that are older than
+ *   flush_seconds, completes sends, and
+ *   recieves and unpacks whatever buffers
+ *   have arrived
+*****************************************/
+inline int Aggregator::progress()
+{
+    std::lock_guard<mutex_t> g(m);
+
+    #if defined _BEO_MPI_
+
+    const auto now = clock_t::now();
+
+    for (int task = 0; task < comm_.num_tasks(); task++)
+    {
+        auto& buffer = send_buffers_[task];
+        if (!buffer.data.empty() &&
+            std::chrono::duration<double>(now - buffer.first).count() >= flush_seconds_)
+        {
+            flush(task);
+        }
+    }
+
+    for (auto itr = in_flight_.begin(); itr != in_flight_.end();)
+    {
+        int done = 0;
+        MPI_Test(&itr->second, &done, MPI_STATUS_IGNORE);
+        itr = done ? in_flight_.erase(itr) : std::next(itr);
+    }
+
+    while (true)
+    {
+        int flag = 0;
+        MPI_Status status;
+
+        MPI_Iprobe(MPI_ANY_SOURCE, 0, comm_.comm(), &flag, &status);
+
+        if (!flag) break;
+
+        int count;
+        MPI_Get_count(&status, MPI_CHAR, &count);
+
+        buffer_t buffer(count);
+
+        int stat = MPI_Recv(buffer.data(),
+                            count,
+                            MPI_CHAR,
+                            status.MPI_SOURCE,
+                            0,
+                            comm_.comm(),
+                            MPI_STATUS_IGNORE);
+
+        if (MPI_SUCCESS != stat) return BEO_FAIL;
+
+        unpack(status.MPI_SOURCE, buffer);
+    }
+
+    #endif
+
+    return BEO_SUCCESS;
+}
+
+/*****************************************
+ * is_complete
+ *
+ * true if every message this task posted
+ *   has been sent and recieved
+*****************************************/
+inline bool Aggregator::is_complete()
+{
+    std::lock_guard<mutex_t> g(m);
+
+    progress();
+
+    #if defined _BEO_MPI_
+
+    if (!in_flight_.empty()) return false;
+
+    for (const auto& buffer : send_buffers_) if (!buffer.data.empty()) return false;
+
+    #elif defined _BEO_THREADS_ || defined _BEO_SHM_
+
+    for (auto itr = in_flight_.begin(); itr != in_flight_.end();)
+    {
+        itr = itr->second.is_complete() ? in_flight_.erase(itr) : std::next(itr);
+    }
+
+    if (!in_flight_.empty()) return false;
+
+    #endif
+
+    return posted_.empty();
+}
+
+/*****************************************
+ * wait
+ *
+ * Flushes all buffers, and waits until every
+ *   message this task posted is complete
+*****************************************/
+inline int Aggregator::wait()
+{
+    if (BEO_SUCCESS != flush()) return BEO_FAIL;
+
+    while (!is_complete()) {}
+
+    return BEO_SUCCESS;
+}
+
+/*****************************************
+ * finalize
+ *
+ * Completes everything and frees the comm.
+ *   Call this before MPI_Finalize
+*****************************************/
+inline void Aggregator::finalize()
+{
+    wait();
+
+    comm_.finalize();
+}
+
+} //end namespace beo
+
+#endif
@@ -0,0 +1,720 @@
+/*****************************************
+ * contraction.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Contraction, which
+ *   contracts two block tensors held in
+ *   beo::Global_Data, e.g.,
+ *
+ *     C[i,j] += alpha * A[i,k] * B[k,j]
+ *
+ *   with the indices named by one
+ *   character labels ("ij", "ik", "kj").
+ *   Labels in A and B but not in C are
+ *   summed over. Every label of C must be
+ *   in exactly one of A or B.
+ *
+ * The elements of a chunk are stored
+ *   row-major in the order of its labels
+ *   (the last label is fastest), and the
+ *   tilings must agree: the chunks of A,
+ *   B, and C have the same offsets and
+ *   lengths along a shared label.
+ *
+ * The schedule is owner-computes on C, as
+ *   in SUMMA: each task only updates the
+ *   chunks of C it owns, so C never moves,
+ *   and fetches the A and B chunks each
+ *   needs with one-sided gets. A task
+ *   works through its C chunks row by
+ *   row, so the A chunks of a row are
+ *   reused from a cache of fetched
+ *   chunks, and starts each C chunk's sum
+ *   at a different k (by task id), as in
+ *   Cannon, so that tasks do not all ask
+ *   the same owner for the same chunk at
+ *   once. The next step's chunks are
+ *   fetched while the current step is
+ *   computed.
+ *
+ * Each step packs its A and B chunks into
+ *   matrices (unless they already are),
+ *   and multiplies them with a cache-
+ *   blocked kernel. Its inner loop runs
+ *   along a row of B and C with
+ *   beo::Simd<T> registers (see simd.hpp),
+ *   and is scalar for types Simd does
+ *   not cover. It is not register blocked
+ *   like a tuned GEMM, so large dense
+ *   blocks are better done with BLAS.
+ *
+ * plan is local. execute is collective
+ *   over the comm of C, which must also
+ *   be that of A and B, and syncs C
+ *   before returning. A and B must not
+ *   change during execute.
+*****************************************/
+#ifndef _BEO_CONTRACTION_HPP_
+#define _BEO_CONTRACTION_HPP_
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <tuple>
+#include <algorithm>
+#include <unordered_map>
+
+#include "../L0/l0.hpp"
+#include "data_tag.hpp"
+#include "global_data.hpp"
+
+namespace beo
+{
+
+class Contraction
+{
+    public:
+
+        using key_t     = Chunk_Tag::key_t;
+
+        using lengths_t = Chunk_Tag::lengths_t;
+
+        //one chunk product, C[c] += A[a] * B[b]
+        struct Step
+        {
+            key_t c;
+
+            key_t a;
+
+            key_t b;
+        };
+
+        //bytes of fetched chunks kept for reuse
+        static const size_t default_cache_bytes = 256 * 1024 * 1024;
+
+    protected:
+
+        using lengths_map_t = std::unordered_map<key_t, lengths_t, Chunk_Tag_Hash>;
+
+        //a fetched chunk of A (which = 0) or B (which = 1)
+        struct Tile
+        {
+            std::unique_ptr<Chunk> chunk;
+
+            Request                request;
+
+            std::list<key_t>::iterator lru;
+        };
+
+        using cache_t = std::unordered_map<key_t, Tile, Chunk_Tag_Hash>;
+
+        std::string       c_labels_;
+
+        std::string       a_labels_;
+
+        std::string       b_labels_;
+
+        Global_Data*      c_{nullptr};
+
+        Global_Data*      a_{nullptr};
+
+        Global_Data*      b_{nullptr};
+
+        lengths_map_t     c_lengths_;
+
+        lengths_map_t     a_lengths_;
+
+        lengths_map_t     b_lengths_;
+
+        std::vector<Step> steps_;
+
+        size_t            cache_bytes_;
+
+        //positions of the free labels of A (i), of B (j), and of the summed labels (k)
+        std::vector<size_t> i_in_c_, i_in_a_, j_in_c_, j_in_b_, k_in_a_, k_in_b_;
+
+        int check_labels();
+
+        static key_t project(const key_t& key, const std::vector<size_t>& positions);
+
+        static std::vector<size_t> strides(const lengths_t& lengths);
+
+        template<typename T>
+        static const T* pack(std::vector<T>& dest,
+                             const T* src,
+                             const lengths_t& lengths,
+                             const std::vector<size_t>& rows,
+                             const std::vector<size_t>& cols);
+
+        template<typename T>
+        void multiply(T* c, const T* a, const T* b, const Step& step, const T alpha,
+                      std::vector<T>& a_pack, std::vector<T>& b_pack, std::vector<T>& c_pack);
+
+        const void* fetch(cache_t& cache, std::list<key_t>& lru, size_t& bytes,
+                          const int which, const key_t& key, const Step* keep, const Step* next);
+
+        void prefetch(cache_t& cache, std::list<key_t>& lru, size_t& bytes,
+                      const Step& step, const Step* keep);
+
+    public:
+
+        Contraction(const std::string& c_labels,
+                    const std::string& a_labels,
+                    const std::string& b_labels,
+                    const size_t cache_bytes = default_cache_bytes)
+        : c_labels_(c_labels), a_labels_(a_labels), b_labels_(b_labels), cache_bytes_(cache_bytes) {}
+
+        int plan(Data_Tag& c_tag, Global_Data& c,
+                 Data_Tag& a_tag, Global_Data& a,
+                 Data_Tag& b_tag, Global_Data& b);
+
+        //the chunk products this task will compute, in order
+        const std::vector<Step>& steps() const {return steps_;}
+
+        template<typename T>
+        int execute(const T alpha = T(1));
+};
+
+//plans and executes C[c_labels] += alpha * A[a_labels] * B[b_labels]
+template<typename T>
+int contract(const std::string& c_labels, Data_Tag& c_tag, Global_Data& c,
+             const std::string& a_labels, Data_Tag& a_tag, Global_Data& a,
+             const std::string& b_labels, Data_Tag& b_tag, Global_Data& b,
+             const T alpha = T(1));
+
+/*****************************************
+ * check_labels
+ *
+ * Sorts the labels into i (free in A), j
+ *   (free in B), and k (summed), and
+ *   records where each is in each operand
+*****************************************/
+inline int Contraction::check_labels()
+{
+    i_in_c_.clear(); i_in_a_.clear();
+    j_in_c_.clear(); j_in_b_.clear();
+    k_in_a_.clear(); k_in_b_.clear();
+
+    for (const auto* labels : {&c_labels_, &a_labels_, &b_labels_})
+    {
+        for (size_t p = 0; p < labels->size(); p++)
+        {
+            if (labels->find((*labels)[p], p + 1) != std::string::npos)
+            {
+                printf("beo::Contraction label %c is repeated in %s\n", (*labels)[p], labels->c_str());
+                return BEO_FAIL;
+            }
+        }
+    }
+
+    for (size_t p = 0; p < c_labels_.size(); p++)
+    {
+        const size_t in_a = a_labels_.find(c_labels_[p]);
+        const size_t in_b = b_labels_.find(c_labels_[p]);
+
+        if ((std::string::npos == in_a) == (std::string::npos == in_b))
+        {
+            printf("beo::Contraction label %c of C must be in exactly one of A and B\n", c_labels_[p]);
+            return BEO_FAIL;
+        }
+
+        if (std::string::npos != in_a) {i_in_c_.push_back(p); i_in_a_.push_back(in_a);}
+
+        else {j_in_c_.push_back(p); j_in_b_.push_back(in_b);}
+    }
+
+    for (size_t p = 0; p < a_labels_.size(); p++)
+    {
+        if (std::string::npos != c_labels_.find(a_labels_[p])) continue;
+
+        const size_t in_b = b_labels_.find(a_labels_[p]);
+
+        if (std::string::npos == in_b)
+        {
+            printf("beo::Contraction label %c of A is in neither B nor C\n", a_labels_[p]);
+            return BEO_FAIL;
+        }
+
+        k_in_a_.push_back(p);
+        k_in_b_.push_back(in_b);
+    }
+
+    if (a_labels_.size() != i_in_a_.size() + k_in_a_.size()
+     || b_labels_.size() != j_in_b_.size() + k_in_b_.size())
+    {
+        printf("beo::Contraction every label of B must be in A or C\n");
+        return BEO_FAIL;
+    }
+
+    return BEO_SUCCESS;
+}
+
+/*****************************************
+ * helpers
+*****************************************/
+inline Contraction::key_t Contraction::project(const key_t& key, const std::vector<size_t>& positions)
+{
+    key_t out;
+    out.reserve(positions.size());
+    for (const auto p : positions) out.push_back(key[p]);
+    return out;
+}
+
+//row-major strides, in elements
+inline std::vector<size_t> Contraction::strides(const lengths_t& lengths)
+{
+    std::vector<size_t> out(lengths.size(), 1);
+    for (size_t d = lengths.size(); d-- > 1;) out[d - 1] = out[d] * lengths[d];
+    return out;
+}
+
+/*****************************************
+ * plan
+ *
+ * Finds the chunk products this task
+ *   computes, and orders them
+*****************************************/
+inline int Contraction::plan(Data_Tag& c_tag, Global_Data& c,
+                             Data_Tag& a_tag, Global_Data& a,
+                             Data_Tag& b_tag, Global_Data& b)
+{
+    if (BEO_SUCCESS != check_labels()) return BEO_FAIL;
+
+    if (!c.is_allocated() || !a.is_allocated() || !b.is_allocated()) return BEO_FAIL;
+
+    c_ = &c;
+    a_ = &a;
+    b_ = &b;
+
+    steps_.clear();
+    c_lengths_.clear();
+    a_lengths_.clear();
+    b_lengths_.clear();
+
+    for (auto [tag, labels, lengths] : {std::make_tuple(&c_tag, &c_labels_, &c_lengths_),
+                                        std::make_tuple(&a_tag, &a_labels_, &a_lengths_),
+                                        std::make_tuple(&b_tag, &b_labels_, &b_lengths_)})
+    {
+        std::lock_guard<Data_Tag::mutex_t> g(tag->m);
+
+        for (const auto& [key, chunk_tag] : tag->chunk_tags())
+        {
+            if (key.size() != labels->size())
+            {
+                printf("beo::Contraction chunk of %s has %zu dimensions, not %zu\n",
+                       tag->name().c_str(), key.size(), labels->size());
+                return BEO_FAIL;
+            }
+
+            lengths->insert({key, chunk_tag.lengths()});
+        }
+    }
+
+    //A chunks by their i offsets, and B chunks by their k and j offsets
+    std::unordered_map<key_t, std::vector<key_t>, Chunk_Tag_Hash> a_by_i;
+    std::unordered_map<key_t, key_t, Chunk_Tag_Hash> b_by_kj;
+
+    for (const auto& [key, lengths] : a_lengths_) a_by_i[project(key, i_in_a_)].push_back(key);
+
+    for (const auto& [key, lengths] : b_lengths_)
+    {
+        auto kj = project(key, k_in_b_);
+        for (const auto p : j_in_b_) kj.push_back(key[p]);
+        b_by_kj.insert({kj, key});
+    }
+
+    //this task's C chunks, row by row
+    std::vector<key_t> mine;
+    for (const auto& [key, lengths] : c_lengths_) if (c.is_local(key)) mine.push_back(key);
+
+    std::sort(mine.begin(), mine.end(), [this](const key_t& x, const key_t& y)
+    {
+        auto xi = project(x, i_in_c_), yi = project(y, i_in_c_);
+        if (xi != yi) return xi < yi;
+        return project(x, j_in_c_) < project(y, j_in_c_);
+    });
+
+    const int task_id = c.comm().task_id();
+
+    for (const auto& c_key : mine)
+    {
+        const auto& c_len = c_lengths_[c_key];
+
+        auto itr = a_by_i.find(project(c_key, i_in_c_));
+        if (itr == a_by_i.end()) continue;
+
+        std::vector<key_t> a_keys = itr->second;
+        std::sort(a_keys.begin(), a_keys.end());
+
+        std::vector<Step> row;
+
+        for (const auto& a_key : a_keys)
+        {
+            auto kj = project(a_key, k_in_a_);
+            for (const auto p : j_in_c_) kj.push_back(c_key[p]);
+
+            auto b_itr = b_by_kj.find(kj);
+            if (b_itr == b_by_kj.end()) continue;
+
+            const auto& a_len = a_lengths_[a_key];
+            const auto& b_len = b_lengths_[b_itr->second];
+
+            bool match = true;
+            for (size_t n = 0; n < i_in_c_.size(); n++) match &= (c_len[i_in_c_[n]] == a_len[i_in_a_[n]]);
+            for (size_t n = 0; n < j_in_c_.size(); n++) match &= (c_len[j_in_c_[n]] == b_len[j_in_b_[n]]);
+            for (size_t n = 0; n < k_in_a_.size(); n++) match &= (a_len[k_in_a_[n]] == b_len[k_in_b_[n]]);
+
+            if (!match)
+            {
+                printf("beo::Contraction the tilings of %s, %s, and %s do not agree\n",
+                       c_tag.name().c_str(), a_tag.name().c_str(), b_tag.name().c_str());
+                steps_.clear();
+                return BEO_FAIL;
+            }
+
+            row.push_back({c_key, a_key, b_itr->second});
+        }
+
+        if (row.empty()) continue;
+
+        //skew the start of the sum by task
+        std::rotate(row.begin(), row.begin() + (task_id % row.size()), row.end());
+
+        steps_.insert(steps_.end(), row.begin(), row.end());
+    }
+
+    return BEO_SUCCESS;
+}
+
+/*****************************************
+ * pack
+ *
+ * Returns src as a row-major matrix with
+ *   the dimensions at rows for rows and
+ *   those at cols for columns, copying it
+ *   into dest only if it is not one
+ *   already
+*****************************************/
+template<typename T>
+inline const T* Contraction::pack(std::vector<T>& dest,
+                                  const T* src,
+                                  const lengths_t& lengths,
+                                  const std::vector<size_t>& rows,
+                                  const std::vector<size_t>& cols)
+{
+    std::vector<size_t> order = rows;
+    order.insert(order.end(), cols.begin(), cols.end());
+
+    bool in_order = true;
+    for (size_t d = 0; d < order.size(); d++) in_order &= (order[d] == d);
+
+    if (in_order) return src;
+
+    const auto src_strides = strides(lengths);
+
+    size_t size = 1;
+    for (const auto len : lengths) size *= len;
+
+    dest.resize(size);
+
+    const size_t nd     = order.size();
+    const size_t len    = lengths[order[nd - 1]];
+    const size_t stride = src_strides[order[nd - 1]];
+
+    std::vector<size_t> idx(nd, 0);
+    size_t off = 0;
+
+    for (size_t p = 0; p < size; p += len)
+    {
+        for (size_t l = 0; l < len; l++) dest[p + l] = src[off + l * stride];
+
+        for (size_t d = nd - 1; d-- > 0;)
+        {
+            const size_t dim = order[d];
+
+            off += src_strides[dim];
+
+            if (++idx[d] < lengths[dim]) break;
+
+            off -= idx[d] * src_strides[dim];
+            idx[d] = 0;
+        }
+    }
+
+    return dest.data();
+}
+
+/*****************************************
+ * multiply
+ *
+ * c += alpha * a * b for one step
+*****************************************/
+template<typename T>
+inline void Contraction::multiply(T* c, const T* a, const T* b, const Step& step, const T alpha,
+                                  std::vector<T>& a_pack, std::vector<T>& b_pack, std::vector<T>& c_pack)
+{
+    const auto& c_len = c_lengths_[step.c];
+    const auto& a_len = a_lengths_[step.a];
+    const auto& b_len = b_lengths_[step.b];
+
+    size_t ni = 1, nj = 1, nk = 1;
+    for (const auto p : i_in_c_) ni *= c_len[p];
+    for (const auto p : j_in_c_) nj *= c_len[p];
+    for (const auto p : k_in_a_) nk *= a_len[p];
+
+    const T* am = pack(a_pack, a, a_len, i_in_a_, k_in_a_);
+    const T* bm = pack(b_pack, b, b_len, k_in_b_, j_in_b_);
+
+    //C is written in place if its labels are the i's then the j's
+    bool in_place = true;
+    for (size_t n = 0; n < i_in_c_.size(); n++) in_place &= (i_in_c_[n] == n);
+    for (size_t n = 0; n < j_in_c_.size(); n++) in_place &= (j_in_c_[n] == i_in_c_.size() + n);
+
+    T* cm = c;
+
+    if (!in_place)
+    {
+        c_pack.assign(ni * nj, T(0));
+        cm = c_pack.data();
+    }
+
+    const size_t bi = 64, bk = 256, bj = 512;
+
+    for (size_t i0 = 0; i0 < ni; i0 += bi)
+    {
+        const size_t i1 = std::min(ni, i0 + bi);
+
+        for (size_t k0 = 0; k0 < nk; k0 += bk)
+        {
+            const size_t k1 = std::min(nk, k0 + bk);
+
+            for (size_t j0 = 0; j0 < nj; j0 += bj)
+            {
+                const size_t j1 = std::min(nj, j0 + bj);
+
+                for (size_t i = i0; i < i1; i++)
+                {
+                    T* crow = cm + i * nj;
+
+                    for (size_t k = k0; k < k1; k++)
+                    {
+                        const T  aik  = alpha * am[i * nk + k];
+                        const T* brow = bm + k * nj;
+
+                        size_t j = j0;
+
+                        if constexpr (Simd<T>::width > 1)
+                        {
+                            using S = Simd<T>;
+                            const auto va = S::set1(aik);
+                            for (; j + S::width <= j1; j += S::width)
+                            {
+                                S::store(crow + j, S::fma(va, S::load(brow + j), S::load(crow + j)));
+                            }
+                        }
+
+                        for (; j < j1; j++) crow[j] += aik * brow[j];
+                    }
+                }
+            }
+        }
+    }
+
+    if (in_place) return;
+
+    //scatter the (i, j) matrix into C's order
+    std::vector<size_t> order = i_in_c_;
+    order.insert(order.end(), j_in_c_.begin(), j_in_c_.end());
+
+    const auto c_strides = strides(c_len);
+
+    const size_t nd     = order.size();
+    const size_t len    = c_len[order[nd - 1]];
+    const size_t stride = c_strides[order[nd - 1]];
+
+    std::vector<size_t> idx(nd, 0);
+    size_t off = 0;
+
+    for (size_t p = 0; p < ni * nj; p += len)
+    {
+        for (size_t l = 0; l < len; l++) c[off + l * stride] += cm[p + l];
+
+        for (size_t d = nd - 1; d-- > 0;)
+        {
+            const size_t dim = order[d];
+
+            off += c_strides[dim];
+
+            if (++idx[d] < c_len[dim]) break;
+
+            off -= idx[d] * c_strides[dim];
+            idx[d] = 0;
+        }
+    }
+}
+
+/*****************************************
+ * fetch/prefetch
+ *
+ * fetch returns the data of a chunk of A
+ *   (which = 0) or B (which = 1), from
+ *   the owner's memory if it is this
+ *   task, otherwise from the cache,
+ *   getting it first on a miss.
+ *
+ * Least recently used chunks are dropped
+ *   once the cache holds more than
+ *   cache_bytes, except those of the
+ *   steps keep and next
+*****************************************/
+inline const void* Contraction::fetch(cache_t& cache, std::list<key_t>& lru, size_t& bytes,
+                                      const int which, const key_t& key, const Step* keep, const Step* next)
+{
+    Global_Data& gd = (0 == which) ? *a_ : *b_;
+
+    if (gd.is_local(key)) return gd.local_data(key);
+
+    key_t tagged = key;
+    tagged.insert(tagged.begin(), (size_t) which);
+
+    auto itr = cache.find(tagged);
+
+    if (itr != cache.end())
+    {
+        beo::counters().cache_hit();
+
+        lru.splice(lru.begin(), lru, itr->second.lru);
+
+        itr->second.request.wait();
+
+        return itr->second.chunk->data();
+    }
+
+    beo::counters().cache_miss();
+
+    const auto& lengths = (0 == which) ? a_lengths_[key] : b_lengths_[key];
+
+    Tile tile;
+    tile.chunk.reset(new Chunk(Chunk_Tag(key, lengths)));
+    tile.request = gd.async_get(*tile.chunk);
+
+    lru.push_front(tagged);
+    tile.lru = lru.begin();
+
+    bytes += gd.distribution().location(key).bytes;
+
+    auto& entry = cache.insert({tagged, std::move(tile)}).first->second;
+
+    auto is_kept = [&](const key_t& t)
+    {
+        key_t k(t.begin() + 1, t.end());
+        for (const Step* s : {keep, next})
+        {
+            if (nullptr != s && ((0 == t[0] && k == s->a) || (1 == t[0] && k == s->b))) return true;
+        }
+        return false;
+    };
+
+    for (auto victim = std::prev(lru.end()); bytes > cache_bytes_ && victim != lru.begin();)
+    {
+        auto prev = std::prev(victim);
+
+        if (!is_kept(*victim))
+        {
+            auto& old = cache.at(*victim);
+            old.request.wait();
+
+            key_t k(victim->begin() + 1, victim->end());
+            bytes -= ((0 == (*victim)[0]) ? *a_ : *b_).distribution().location(k).bytes;
+
+            cache.erase(*victim);
+            lru.erase(victim);
+        }
+
+        victim = prev;
+    }
+
+    return entry.chunk->data();
+}
+
+inline void Contraction::prefetch(cache_t& cache, std::list<key_t>& lru, size_t& bytes,
+                                  const Step& step, const Step* keep)
+{
+    fetch(cache, lru, bytes, 0, step.a, keep, &step);
+    fetch(cache, lru, bytes, 1, step.b, keep, &step);
+}
+
+/*****************************************
+ * execute
+ *
+ * Runs the planned steps, then syncs C
+*****************************************/
+template<typename T>
+inline int Contraction::execute(const T alpha)
+{
+    if (nullptr == c_) return BEO_FAIL;
+
+    if (c_->distribution().elm_bytes() != sizeof(T)
+     || a_->distribution().elm_bytes() != sizeof(T)
+     || b_->distribution().elm_bytes() != sizeof(T))
+    {
+        printf("beo::Contraction::execute element size does not match the Global_Data\n");
+        return BEO_FAIL;
+    }
+
+    cache_t          cache;
+    std::list<key_t> lru;
+    size_t           bytes = 0;
+
+    std::vector<T> a_pack, b_pack, c_pack;
+
+    if (!steps_.empty()) prefetch(cache, lru, bytes, steps_[0], nullptr);
+
+    for (size_t s = 0; s < steps_.size(); s++)
+    {
+        const Step& step = steps_[s];
+        const Step* next = (s + 1 < steps_.size()) ? &steps_[s + 1] : nullptr;
+
+        //start getting the next step's chunks before waiting on these
+        if (nullptr != next) prefetch(cache, lru, bytes, *next, &step);
+
+        const T* a = (const T*) fetch(cache, lru, bytes, 0, step.a, &step, next);
+        const T* b = (const T*) fetch(cache, lru, bytes, 1, step.b, &step, next);
+
+        T* c = (T*) c_->local_data(step.c);
+
+        multiply<T>(c, a, b, step, alpha, a_pack, b_pack, c_pack);
+    }
+
+    //outstanding gets must finish before their chunks go
+    for (auto& [key, tile] : cache) tile.request.wait();
+
+    return c_->sync();
+}
+
+/*****************************************
+ * contract
+*****************************************/
+template<typename T>
+inline int contract(const std::string& c_labels, Data_Tag& c_tag, Global_Data& c,
+                    const std::string& a_labels, Data_Tag& a_tag, Global_Data& a,
+                    const std::string& b_labels, Data_Tag& b_tag, Global_Data& b,
+                    const T alpha)
+{
+    Contraction contraction(c_labels, a_labels, b_labels);
+
+    int stat = contraction.plan(c_tag, c, a_tag, a, b_tag, b);
+
+    //execute is collective, so a task that failed to plan still takes part
+    stat |= contraction.execute<T>(alpha);
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+} //end namespace beo
+
+#endif
@@ -33,6 +33,7 @@
 #include <set>
 #include <mutex>
 #include <utility>
+#include <algorithm>
 #include <iostream>
 
 namespace beo
@@ -383,7 +384,9 @@ inline void Data_Tag::add_chunk_tag(const beo::Chunk_Tag::offsets_t& offsets,
 inline void Data_Tag::add_chunk_tag(beo::Chunk_Tag::offsets_t&& offsets,
                              beo::Chunk_Tag::lengths_t&& lengths)
 {
-    chunk_tags_.emplace(std::make_pair(offsets, 
+    auto key = offsets;
+
+    chunk_tags_.emplace(std::make_pair(std::move(key), 
                                        beo::Chunk_Tag{std::move(offsets),
                                                       std::move(lengths)}));
 }
@@ -393,6 +396,30 @@ inline void Data_Tag::reserve(const size_t num)
     chunk_tags_.reserve(num);
 }
 
+/*****************************************
+ * sorted_chunk_tags
+ *
+ * The chunk_tags in sorted order of their
+ *   offsets, which is the same on every
+ *   task (as in beo::Distribution)
+*****************************************/
+inline std::vector<Chunk_Tag*> sorted_chunk_tags(Data_Tag& data_tag)
+{
+    std::lock_guard<Data_Tag::mutex_t> g(data_tag.m);
+
+    std::vector<Chunk_Tag::key_t> keys;
+    keys.reserve(data_tag.num_chunk_tags());
+    for (const auto& [key, chunk_tag] : data_tag.chunk_tags()) keys.push_back(key);
+
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<Chunk_Tag*> chunk_tags;
+    chunk_tags.reserve(keys.size());
+    for (const auto& key : keys) chunk_tags.push_back(&data_tag.chunk_tags().at(key));
+
+    return chunk_tags;
+}
+
 }//end namespace beo
 
 #endif
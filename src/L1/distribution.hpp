@@ -0,0 +1,195 @@
+/*****************************************
+ * distribution.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Distribution,
+ *   which decides which task of a
+ *   communicator owns each chunk of
+ *   a beo::Data_Tag, and where in that
+ *   task's memory the chunk lives.
+ *
+ * The chunks are assigned in sorted
+ *   order of their offsets, each to the
+ *   task with the fewest bytes so far, so
+ *   every task that builds a Distribution
+ *   from the same Data_Tag gets the same
+ *   answer without communicating.
+ *
+ * Each chunk's displacement within the
+ *   owner's memory is aligned to
+ *   BEO_CHUNK_ALIGNMENT bytes
+ *
+*****************************************/
+#ifndef _BEO_DISTRIBUTION_HPP_
+#define _BEO_DISTRIBUTION_HPP_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <queue>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+#include "../L0/def.hpp"
+#include "../L0/chunk_tag.hpp"
+#include "../L0/chunk_tag_hash.hpp"
+#include "data_tag.hpp"
+
+namespace beo
+{
+
+class Distribution
+{
+    public:
+
+        using key_t = beo::Chunk_Tag::key_t;
+
+        struct Location
+        {
+            int    owner{0};
+
+            size_t displacement{0};
+
+            size_t bytes{0};
+        };
+
+        using map_t = std::unordered_map<key_t, Location, beo::Chunk_Tag_Hash>;
+
+    protected:
+
+        map_t               map_;
+
+        std::vector<key_t>  keys_;
+
+        std::vector<size_t> task_bytes_;
+
+        size_t              elm_bytes_{0};
+
+    public:
+
+        Distribution() {}
+
+        Distribution(Data_Tag& data_tag,
+                     const int num_tasks,
+                     const size_t elm_bytes);
+
+        int init(Data_Tag& data_tag,
+                 const int num_tasks,
+                 const size_t elm_bytes);
+
+        int num_tasks() const {return (int) task_bytes_.size();}
+
+        size_t elm_bytes() const {return elm_bytes_;}
+
+        size_t num_chunks() const {return keys_.size();}
+
+        //Chunk offsets, in sorted order
+        const std::vector<key_t>& keys() const {return keys_;}
+
+        //bytes of chunk memory owned by a task
+        size_t bytes(const int task_id) const {return task_bytes_[task_id];}
+
+        bool contains(const key_t& key) const {return map_.find(key) != map_.end();}
+
+        const Location& location(const key_t& key) const;
+
+        int owner(const key_t& key) const {return location(key).owner;}
+
+        size_t displacement(const key_t& key) const {return location(key).displacement;}
+};
+
+/*****************************************
+ * Constructors
+*****************************************/
+inline Distribution::Distribution(Data_Tag& data_tag,
+                                  const int num_tasks,
+                                  const size_t elm_bytes)
+{
+    init(data_tag, num_tasks, elm_bytes);
+}
+
+/*****************************************
+ * init
+ *
+ * Assigns the chunks of data_tag to
+ *   num_tasks tasks, with elm_bytes bytes
+ *   per element
+*****************************************/
+inline int Distribution::init(Data_Tag& data_tag,
+                              const int num_tasks,
+                              const size_t elm_bytes)
+{
+    if (num_tasks < 1) return BEO_FAIL;
+
+    std::lock_guard<Data_Tag::mutex_t> g(data_tag.m);
+
+    map_.clear();
+    keys_.clear();
+    task_bytes_.assign(num_tasks, 0);
+    elm_bytes_ = elm_bytes;
+
+    keys_.reserve(data_tag.num_chunk_tags());
+    for (const auto& [key, chunk_tag] : data_tag.chunk_tags()) keys_.push_back(key);
+
+    std::sort(keys_.begin(), keys_.end());
+
+    //min-heap of (bytes, task_id)
+    using entry_t = std::pair<size_t, int>;
+    std::priority_queue<entry_t, std::vector<entry_t>, std::greater<entry_t>> heap;
+    for (int task = 0; task < num_tasks; task++) heap.push({0, task});
+
+    map_.reserve(keys_.size());
+    for (const auto& key : keys_)
+    {
+        auto [bytes, task] = heap.top();
+        heap.pop();
+
+        Location loc;
+        loc.owner        = task;
+        loc.displacement = bytes;
+        loc.bytes        = data_tag.chunk_tags().find(key)->second.size() * elm_bytes;
+
+        const size_t padded = (loc.bytes + BEO_CHUNK_ALIGNMENT - 1)
+                            / BEO_CHUNK_ALIGNMENT * BEO_CHUNK_ALIGNMENT;
+
+        task_bytes_[task] = bytes + padded;
+
+        heap.push({task_bytes_[task], task});
+
+        map_.insert({key, loc});
+    }
+
+    return BEO_SUCCESS;
+}
+
+/*****************************************
+ * location
+ *
+ * returns where the chunk with the given
+ *   offsets lives
+*****************************************/
+inline const Distribution::Location& Distribution::location(const key_t& key) const
+{
+    auto itr = map_.find(key);
+
+    if (itr != map_.end()) return itr->second;
+
+    std::string offstr = "[";
+    for (const auto elm : key)
+    {
+        offstr += std::to_string(elm);
+        offstr += ", ";
+    }
+    offstr += "]";
+    printf("\nbeo::error - Could not find chunk %s in Distribution\n", offstr.c_str());
+    exit(1);
+}
+
+} //end namespace beo
+
+#endif
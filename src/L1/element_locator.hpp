@@ -0,0 +1,223 @@
+/*****************************************
+ * element_locator.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Element_Locator,
+ *   which maps the global index of an
+ *   element of a beo::Global_Data to the
+ *   task that owns it and its byte
+ *   displacement in that task's memory.
+ *   Scatter_Accumulator and gather are
+ *   built on it.
+ *
+ * Indices are global, ndim per element,
+ *   and chunks are row-major. A chunk is
+ *   found by a binary search of the chunk
+ *   offsets in each dimension, so this is
+ *   fastest when the chunks tile a grid.
+ *   Otherwise it falls back to checking
+ *   every chunk.
+ *
+ * Building one costs a pass over the
+ *   chunks, so keep it around for many
+ *   lookups. locate is not thread safe
+*****************************************/
+#ifndef _BEO_ELEMENT_LOCATOR_HPP_
+#define _BEO_ELEMENT_LOCATOR_HPP_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <algorithm>
+#include <unordered_map>
+
+#include "../L0/l0.hpp"
+#include "data_tag.hpp"
+#include "global_data.hpp"
+
+namespace beo
+{
+
+class Element_Locator
+{
+    public:
+
+        using index_t   = size_t;
+
+        using offsets_t = Chunk_Tag::offsets_t;
+
+        using lengths_t = Chunk_Tag::lengths_t;
+
+    protected:
+
+        struct Chunk_Info
+        {
+            int       owner{0};
+
+            size_t    displacement{0};
+
+            lengths_t lengths;
+        };
+
+        using map_t = std::unordered_map<offsets_t, Chunk_Info, Chunk_Tag_Hash>;
+
+        Global_Data&                     global_data_;
+
+        size_t                           ndim_{0};
+
+        map_t                            chunks_;
+
+        //sorted chunk offsets along each dimension
+        std::vector<std::vector<size_t>> bounds_;
+
+        //scratch for lookups, so locate does not allocate
+        offsets_t                        key_;
+
+        //the (offsets, info) of the chunk holding an element
+        const map_t::value_type& find(const index_t* index);
+
+    public:
+
+        Element_Locator(Global_Data& global_data, Data_Tag& data_tag);
+
+       ~Element_Locator() {}
+
+        Element_Locator(const Element_Locator& other) = delete;
+
+        Element_Locator& operator=(const Element_Locator& other) = delete;
+
+        Global_Data& global_data() {return global_data_;}
+
+        size_t ndim() const {return ndim_;}
+
+        int num_tasks() const {return global_data_.distribution().num_tasks();}
+
+        size_t elm_bytes() const {return global_data_.distribution().elm_bytes();}
+
+        //index holds ndim global indices
+        void locate(const index_t* index, int& owner, size_t& displacement);
+};
+
+/*****************************************
+ * Constructor
+ *
+ * global_data must be allocated from
+ *   data_tag
+*****************************************/
+inline Element_Locator::Element_Locator(Global_Data& global_data, Data_Tag& data_tag)
+    : global_data_(global_data)
+{
+    if (!global_data_.is_allocated())
+    {
+        printf("beo::Element_Locator %s is not allocated\n", global_data_.name().c_str());
+        exit(1);
+    }
+
+    std::lock_guard<Data_Tag::mutex_t> g(data_tag.m);
+
+    //the Data_Tag may not know its full lengths, the chunks do
+    ndim_ = data_tag.chunk_tags().empty() ? data_tag.ndim()
+                                          : data_tag.chunk_tags().begin()->second.ndim();
+
+    bounds_.assign(ndim_, {});
+
+    chunks_.reserve(data_tag.num_chunk_tags());
+
+    for (const auto& [key, chunk_tag] : data_tag.chunk_tags())
+    {
+        const auto& loc = global_data_.distribution().location(key);
+
+        chunks_.insert({key, Chunk_Info{loc.owner, loc.displacement, chunk_tag.lengths()}});
+
+        for (size_t dim = 0; dim < ndim_; dim++) bounds_[dim].push_back(key[dim]);
+    }
+
+    for (auto& bounds : bounds_)
+    {
+        std::sort(bounds.begin(), bounds.end());
+        bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+    }
+
+    key_.resize(ndim_);
+}
+
+/*****************************************
+ * find
+ *
+ * Returns the chunk holding the element
+ *   at a global index
+*****************************************/
+inline const Element_Locator::map_t::value_type& Element_Locator::find(const index_t* index)
+{
+    auto contains = [&](const offsets_t& offsets, const Chunk_Info& info)
+    {
+        for (size_t dim = 0; dim < ndim_; dim++)
+        {
+            if (index[dim] < offsets[dim] || index[dim] >= offsets[dim] + info.lengths[dim]) return false;
+        }
+        return true;
+    };
+
+    bool is_found = true;
+
+    for (size_t dim = 0; dim < ndim_ && is_found; dim++)
+    {
+        const auto& bounds = bounds_[dim];
+
+        auto itr = std::upper_bound(bounds.begin(), bounds.end(), index[dim]);
+
+        if (itr == bounds.begin()) is_found = false;
+
+        else key_[dim] = *(itr - 1);
+    }
+
+    if (is_found)
+    {
+        auto itr = chunks_.find(key_);
+
+        if (itr != chunks_.end() && contains(itr->first, itr->second)) return *itr;
+    }
+
+    //the chunks do not tile a grid, so look at all of them
+    for (const auto& entry : chunks_)
+    {
+        if (contains(entry.first, entry.second)) return entry;
+    }
+
+    std::string idxstr = "[";
+    for (size_t dim = 0; dim < ndim_; dim++)
+    {
+        idxstr += std::to_string(index[dim]);
+        idxstr += ", ";
+    }
+    idxstr += "]";
+    printf("\nbeo::error - No chunk of %s holds element %s\n", global_data_.name().c_str(), idxstr.c_str());
+    exit(1);
+}
+
+/*****************************************
+ * locate
+ *
+ * Sets the owner of the element at a
+ *   global index, and its byte
+ *   displacement in the owner's memory
+*****************************************/
+inline void Element_Locator::locate(const index_t* index, int& owner, size_t& displacement)
+{
+    const auto& [offsets, info] = find(index);
+
+    //row-major position within the chunk
+    size_t pos = 0;
+    for (size_t dim = 0; dim < ndim_; dim++) pos = pos * info.lengths[dim] + (index[dim] - offsets[dim]);
+
+    owner        = info.owner;
+    displacement = info.displacement + pos * elm_bytes();
+}
+
+} //end namespace beo
+
+#endif
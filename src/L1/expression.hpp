@@ -0,0 +1,316 @@
+/*****************************************
+ * expression.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for the lazy, element-wise
+ *   expressions over beo::Global_Data and
+ *   beo::Chunk, e.g.,
+ *
+ *     auto X = beo::lazy<double>(x);
+ *     auto Y = beo::lazy<double>(y);
+ *     auto Z = beo::lazy<double>(z);
+ *
+ *     beo::evaluate(r, a * X + b * Y - c * Z);
+ *
+ * The operators (+, -, *, / and unary -,
+ *   between expressions or with scalars)
+ *   do no work, they only build up the
+ *   type of the expression. evaluate then
+ *   makes a single pass over each chunk,
+ *   a Simd register at a time, with no
+ *   temporaries, so an expression of n
+ *   terms costs about one memory pass
+ *   instead of n.
+ *
+ * With Global_Data, evaluate works on the
+ *   chunks this task owns, split over the
+ *   thread pool as in vector_ops.hpp, and
+ *   every term must be laid out like r.
+ *   With a Chunk, every term must be a
+ *   Chunk with at least as many elements
+ *   as r.
+ *
+ * The result may also be a term, e.g.,
+ *   evaluate(x, X + a * Y), since each
+ *   element is read before it is written
+*****************************************/
+#ifndef _BEO_EXPRESSION_HPP_
+#define _BEO_EXPRESSION_HPP_
+
+#include <stdio.h>
+#include <type_traits>
+
+#include "../L0/l0.hpp"
+#include "../L0/simd.hpp"
+#include "global_data.hpp"
+#include "vector_ops.hpp"
+
+namespace beo
+{
+
+//Base of every expression, E is the expression itself
+template<typename E>
+struct Expression
+{
+    const E& self() const {return static_cast<const E&>(*this);}
+};
+
+/*****************************************
+ * Lazy_Data
+ *
+ * A Global_Data or a Chunk in an
+ *   expression. bind points it at the
+ *   elements that are being evaluated
+*****************************************/
+template<typename T>
+class Lazy_Data : public Expression<Lazy_Data<T>>
+{
+    public:
+
+        using value_t = T;
+
+        using key_t   = Distribution::key_t;
+
+    protected:
+
+        Global_Data* data_{nullptr};
+
+        const T*     base_{nullptr};
+
+        size_t       size_{0};
+
+        const T*     ptr_{nullptr};
+
+    public:
+
+        Lazy_Data(Global_Data& data) : data_(&data) {}
+
+        Lazy_Data(Chunk& chunk) : base_((const T*) chunk.data()), size_(chunk.size()) {}
+
+        void bind(const key_t& key, const size_t first)
+        {
+            ptr_ = (nullptr != data_) ? (const T*) data_->local_data(key) + first : base_ + first;
+        }
+
+        T get(const size_t i) const {return ptr_[i];}
+
+        auto load(const size_t i) const {return Simd<T>::load(ptr_ + i);}
+
+        bool fits(Global_Data& r) const {return nullptr != data_ && laid_out_alike(r, *data_);}
+
+        bool fits(const size_t n) const {return nullptr == data_ && nullptr != base_ && size_ >= n;}
+};
+
+/*****************************************
+ * Lazy_Scalar
+*****************************************/
+template<typename T>
+class Lazy_Scalar : public Expression<Lazy_Scalar<T>>
+{
+    public:
+
+        using value_t = T;
+
+        using key_t   = Distribution::key_t;
+
+    protected:
+
+        T a_;
+
+    public:
+
+        Lazy_Scalar(const T a) : a_(a) {}
+
+        void bind(const key_t&, const size_t) {}
+
+        T get(const size_t) const {return a_;}
+
+        auto load(const size_t) const {return Simd<T>::set1(a_);}
+
+        bool fits(Global_Data&) const {return true;}
+
+        bool fits(const size_t) const {return true;}
+};
+
+/*****************************************
+ * Lazy_Binary
+ *
+ * l Op r, element by element
+*****************************************/
+struct Lazy_Add
+{
+    template<typename T> static T get(const T a, const T b) {return a + b;}
+
+    template<typename S, typename R> static R load(const R a, const R b) {return S::add(a, b);}
+};
+
+struct Lazy_Sub
+{
+    template<typename T> static T get(const T a, const T b) {return a - b;}
+
+    template<typename S, typename R> static R load(const R a, const R b) {return S::sub(a, b);}
+};
+
+struct Lazy_Mul
+{
+    template<typename T> static T get(const T a, const T b) {return a * b;}
+
+    template<typename S, typename R> static R load(const R a, const R b) {return S::mul(a, b);}
+};
+
+struct Lazy_Div
+{
+    template<typename T> static T get(const T a, const T b) {return a / b;}
+
+    template<typename S, typename R> static R load(const R a, const R b) {return S::div(a, b);}
+};
+
+template<typename Op, typename L, typename R>
+class Lazy_Binary : public Expression<Lazy_Binary<Op, L, R>>
+{
+    public:
+
+        using value_t = typename L::value_t;
+
+        using key_t   = Distribution::key_t;
+
+        static_assert(std::is_same<value_t, typename R::value_t>::value,
+                      "beo::Lazy_Binary terms must have the same element type");
+
+    protected:
+
+        L l_;
+
+        R r_;
+
+    public:
+
+        Lazy_Binary(const L& l, const R& r) : l_(l), r_(r) {}
+
+        void bind(const key_t& key, const size_t first) {l_.bind(key, first); r_.bind(key, first);}
+
+        value_t get(const size_t i) const {return Op::get(l_.get(i), r_.get(i));}
+
+        auto load(const size_t i) const {return Op::template load<Simd<value_t>>(l_.load(i), r_.load(i));}
+
+        bool fits(Global_Data& r) const {return l_.fits(r) && r_.fits(r);}
+
+        bool fits(const size_t n) const {return l_.fits(n) && r_.fits(n);}
+};
+
+/*****************************************
+ * lazy
+ *
+ * Makes a term of an expression
+*****************************************/
+template<typename T>
+inline Lazy_Data<T> lazy(Global_Data& data) {return Lazy_Data<T>(data);}
+
+template<typename T>
+inline Lazy_Data<T> lazy(Chunk& chunk) {return Lazy_Data<T>(chunk);}
+
+/*****************************************
+ * operators
+*****************************************/
+#define _BEO_LAZY_OPERATOR_(sym, op)                                                    \
+template<typename L, typename R>                                                        \
+inline Lazy_Binary<op, L, R> operator sym(const Expression<L>& l, const Expression<R>& r) \
+{                                                                                       \
+    return Lazy_Binary<op, L, R>(l.self(), r.self());                                   \
+}                                                                                       \
+                                                                                        \
+template<typename E>                                                                    \
+inline Lazy_Binary<op, Lazy_Scalar<typename E::value_t>, E>                             \
+operator sym(const typename E::value_t a, const Expression<E>& e)                       \
+{                                                                                       \
+    return Lazy_Binary<op, Lazy_Scalar<typename E::value_t>, E>(a, e.self());           \
+}                                                                                       \
+                                                                                        \
+template<typename E>                                                                    \
+inline Lazy_Binary<op, E, Lazy_Scalar<typename E::value_t>>                             \
+operator sym(const Expression<E>& e, const typename E::value_t a)                       \
+{                                                                                       \
+    return Lazy_Binary<op, E, Lazy_Scalar<typename E::value_t>>(e.self(), a);           \
+}
+
+_BEO_LAZY_OPERATOR_(+, Lazy_Add)
+_BEO_LAZY_OPERATOR_(-, Lazy_Sub)
+_BEO_LAZY_OPERATOR_(*, Lazy_Mul)
+_BEO_LAZY_OPERATOR_(/, Lazy_Div)
+
+#undef _BEO_LAZY_OPERATOR_
+
+template<typename E>
+inline Lazy_Binary<Lazy_Sub, Lazy_Scalar<typename E::value_t>, E> operator-(const Expression<E>& e)
+{
+    return Lazy_Binary<Lazy_Sub, Lazy_Scalar<typename E::value_t>, E>(typename E::value_t(0), e.self());
+}
+
+/*****************************************
+ * evaluate_kernel
+ *
+ * r[i] = e[i] for i < n, e already bound
+*****************************************/
+template<typename T, typename E>
+inline void evaluate_kernel(T* r, const E& e, const size_t n)
+{
+    size_t i = 0;
+
+    if constexpr (Simd<T>::width > 1)
+    {
+        using S = Simd<T>;
+        for (; i + S::width <= n; i += S::width) S::store(r + i, e.load(i));
+    }
+
+    for (; i < n; i++) r[i] = e.get(i);
+}
+
+/*****************************************
+ * evaluate
+ *
+ * r = expr, in one pass
+*****************************************/
+template<typename E>
+inline int evaluate(Global_Data& r, const Expression<E>& expr)
+{
+    using T = typename E::value_t;
+
+    if (!expr.self().fits(r))
+    {
+        printf("beo::evaluate the terms are not laid out like %s\n", r.name().c_str());
+        return BEO_FAIL;
+    }
+
+    return for_each_local_range<T>(r, num_local_parts(), [&r, &expr](size_t, const Distribution::key_t& key, size_t first, size_t n)
+    {
+        E e = expr.self();
+
+        e.bind(key, first);
+
+        evaluate_kernel((T*) r.local_data(key) + first, e, n);
+    });
+}
+
+template<typename E>
+inline int evaluate(Chunk& r, const Expression<E>& expr)
+{
+    using T = typename E::value_t;
+
+    const size_t n = r.size();
+
+    if (!r.is_allocated() || !expr.self().fits(n)) return BEO_FAIL;
+
+    E e = expr.self();
+
+    e.bind(Distribution::key_t(), 0);
+
+    evaluate_kernel((T*) r.data(), e, n);
+
+    return BEO_SUCCESS;
+}
+
+} //end namespace beo
+
+#endif
@@ -0,0 +1,175 @@
+/*****************************************
+ * gather.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::gather, which
+ *   reads arbitrary elements of a
+ *   beo::Global_Data by their global
+ *   indices, e.g., sparse look-ups into a
+ *   large distributed tensor,
+ *
+ *     std::vector<size_t> indices = {i0, j0, i1, j1, ...};
+ *     std::vector<double> values;
+ *
+ *     beo::gather(global_data, data_tag, indices, values);
+ *
+ * The indices (ndim per element) are
+ *   located with a beo::Element_Locator,
+ *   sorted by owner and then by where the
+ *   elements live, and repeats are read
+ *   once. Each owner is then read with
+ *   one Global_Data::get_at, rather than
+ *   one message per element, and the
+ *   values are returned in the order
+ *   they were asked for.
+ *
+ * To gather many times from the same
+ *   Global_Data, build the
+ *   Element_Locator once and use the
+ *   overload that takes it.
+ *
+ * Like Global_Data::get, this reads
+ *   whatever the owners hold, so sync
+ *   after any puts or accumulates first
+*****************************************/
+#ifndef _BEO_GATHER_HPP_
+#define _BEO_GATHER_HPP_
+
+#include <stdio.h>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+#include "../L0/l0.hpp"
+#include "data_tag.hpp"
+#include "global_data.hpp"
+#include "element_locator.hpp"
+
+namespace beo
+{
+
+/*****************************************
+ * gather
+ *
+ * Sets values[i] to the element at
+ *   global index indices[i * ndim ...],
+ *   resizing values to fit. Returns once
+ *   every value has arrived
+*****************************************/
+template<typename T>
+inline int gather(Element_Locator& locator,
+                  const std::vector<size_t>& indices,
+                  std::vector<T>& values)
+{
+    const size_t ndim = locator.ndim();
+
+    if (locator.elm_bytes() != sizeof(T))
+    {
+        printf("beo::gather element size does not match %s\n", locator.global_data().name().c_str());
+        return BEO_FAIL;
+    }
+
+    if (0 == ndim || 0 != indices.size() % ndim)
+    {
+        printf("beo::gather needs %zu indices per value\n", ndim);
+        return BEO_FAIL;
+    }
+
+    const size_t count = indices.size() / ndim;
+
+    values.resize(count);
+
+    if (0 == count) return BEO_SUCCESS;
+
+    std::vector<int>    owners(count);
+    std::vector<size_t> displacements(count);
+
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        locator.locate(indices.data() + idx * ndim, owners[idx], displacements[idx]);
+    }
+
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+
+    std::sort(order.begin(), order.end(), [&](const size_t a, const size_t b)
+    {
+        return (owners[a] != owners[b]) ? owners[a] < owners[b]
+                                        : displacements[a] < displacements[b];
+    });
+
+    //the distinct elements, in sorted order, and where each request finds its value
+    std::vector<size_t> unique;
+    std::vector<size_t> slots(count);
+
+    //the first distinct element of each owner
+    const int num_tasks = locator.num_tasks();
+    std::vector<size_t> firsts(num_tasks + 1, 0);
+
+    unique.reserve(count);
+
+    for (size_t pos = 0; pos < count; pos++)
+    {
+        const size_t idx = order[pos];
+
+        const bool is_repeat = (pos > 0)
+                            && owners[order[pos - 1]] == owners[idx]
+                            && displacements[order[pos - 1]] == displacements[idx];
+
+        if (!is_repeat)
+        {
+            unique.push_back(displacements[idx]);
+            firsts[owners[idx] + 1] = unique.size();
+        }
+
+        slots[idx] = unique.size() - 1;
+    }
+
+    //owners with nothing to read end where the one before them did
+    for (int task = 1; task <= num_tasks; task++) firsts[task] = std::max(firsts[task], firsts[task - 1]);
+
+    std::vector<T> fetched(unique.size());
+
+    //start after this task, so tasks do not all start on the same owner
+    const int task_id = locator.global_data().comm().task_id();
+
+    int stat = BEO_SUCCESS;
+
+    for (int idx = 1; idx <= num_tasks; idx++)
+    {
+        const int    owner = (task_id + idx) % num_tasks;
+        const size_t first = firsts[owner];
+        const size_t num   = firsts[owner + 1] - first;
+
+        if (0 == num) continue;
+
+        if (BEO_SUCCESS != locator.global_data().get_at(owner,
+                                                        unique.data() + first,
+                                                        fetched.data() + first,
+                                                        num))
+        {
+            stat = BEO_FAIL;
+        }
+    }
+
+    for (size_t idx = 0; idx < count; idx++) values[idx] = fetched[slots[idx]];
+
+    return stat;
+}
+
+template<typename T>
+inline int gather(Global_Data& global_data,
+                  Data_Tag& data_tag,
+                  const std::vector<size_t>& indices,
+                  std::vector<T>& values)
+{
+    Element_Locator locator(global_data, data_tag);
+
+    return gather(locator, indices, values);
+}
+
+} //end namespace beo
+
+#endif
@@ -0,0 +1,796 @@
+/*****************************************
+ * global_data.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Global_Data,
+ *   which spreads the chunks of a
+ *   beo::Data_Tag over the tasks of a
+ *   communicator, and provides
+ *   Global-Arrays-style one-sided get,
+ *   put, and accumulate of those chunks.
+ *
+ * The owner of a chunk does not need
+ *   to take part in any of these. In
+ *   the MPI case the chunks live in an
+ *   MPI_Win_allocate window which is held
+ *   in a passive-target lock_all epoch
+ *   between allocate and free.
+ *
+ * get, put, and accumulate are complete
+ *   (locally and at the owner) when they
+ *   return. The async_ versions return
+ *   a beo::Request which, once complete,
+ *   means the local buffer may be used
+ *   again. Call flush() to ensure async
+ *   puts have completed at the owner.
+ *
+ * Chunks are identified by their
+ *   offsets, which must match those of
+ *   a chunk_tag in the Data_Tag used
+ *   in allocate.
+ *
+ * get_at and accumulate_at read and
+ *   combine scattered elements of one
+ *   owner's memory in a single operation
+ *   (see gather.hpp and
+ *   scatter_accumulator.hpp, which build
+ *   these from global indices).
+ *   Outside of MPI each element is
+ *   updated with its own atomic, rather
+ *   than under the owner's lock, so do
+ *   not mix it with accumulate on the
+ *   same chunks between syncs.
+ *
+ * With _BEO_THREADS_ the tasks are
+ *   threads of one process, and with
+ *   _BEO_SHM_ the chunks live in a
+ *   beo::Shm_Window. Either way these
+ *   copy directly to and from the
+ *   owner's memory.
+ *
+ * allocate, free, and sync are
+ *   collective over the comm. free must
+ *   be called explicitly, as the
+ *   destructor does not free
+*****************************************/
+#ifndef _BEO_GLOBAL_DATA_HPP_
+#define _BEO_GLOBAL_DATA_HPP_
+
+#include <mutex>
+
+#if defined _BEO_MPI_
+#include <mpi.h>
+#endif
+
+#if defined _BEO_SHM_
+#include "../L0/shm_window.hpp"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "../L0/l0.hpp"
+#include "../L0/datatype.hpp"
+#include "data_tag.hpp"
+#include "distribution.hpp"
+
+namespace beo
+{
+
+class Global_Data
+{
+    public:
+
+        using name_t    = std::string;
+
+        using key_t     = name_t;
+
+        using offsets_t = Chunk_Tag::offsets_t;
+
+        using mutex_t   = std::recursive_mutex;
+
+        mutex_t m;
+
+    protected:
+
+        name_t       name_;
+
+        Comm         comm_;
+
+        Distribution distribution_;
+
+        char*        base_{nullptr};
+
+        bool         is_allocated_{false};
+
+        #if defined _BEO_MPI_
+
+        MPI_Win      win_{MPI_WIN_NULL};
+
+        #elif defined _BEO_SHM_
+
+        Shm_Window   window_;
+
+        #else
+
+        //the Global_Data of every task, which with _BEO_THREADS_
+        //  are all in this process
+        std::vector<Global_Data*> peers_;
+
+        #endif
+
+        int prepare(Chunk& chunk);
+
+        bool fits(Chunk& chunk);
+
+        #if defined _BEO_SHM_
+
+        char* base(const int task) {return window_.base(task);}
+
+        #elif !defined _BEO_MPI_
+
+        char* base(const int task) {return peers_[task]->base_;}
+
+        #endif
+
+    public:
+
+        Global_Data(const std::string& name) {name_ = name;}
+
+       ~Global_Data();
+
+        Global_Data(const Global_Data& other) = delete;
+
+        Global_Data& operator=(const Global_Data& other) = delete;
+
+        const name_t& name() const {return name_;}
+
+        const key_t& key() const {return name_;}
+
+        void lock() {m.lock();}
+
+        void unlock() {m.unlock();}
+
+        bool is_allocated() const {return is_allocated_;}
+
+        Comm& comm() {return comm_;}
+
+        const Distribution& distribution() const {return distribution_;}
+
+        int owner(const offsets_t& offsets) const {return distribution_.owner(offsets);}
+
+        bool is_local(const offsets_t& offsets) const {return owner(offsets) == comm_.task_id();}
+
+        //pointer to a chunk owned by this task, nullptr otherwise
+        void* local_data(const offsets_t& offsets);
+
+        int allocate(Comm& comm, Data_Tag& data_tag, const size_t elm_bytes);
+
+        int free();
+
+        int sync();
+
+        int flush();
+
+        int get(Chunk& chunk);
+
+        int put(Chunk& chunk);
+
+        template<typename T>
+        int accumulate(Chunk& chunk, const Op op = Op::sum);
+
+        int get_at(const int owner,
+                   const size_t* displacements,
+                   void* dest,
+                   const size_t count);
+
+        template<typename T>
+        int accumulate_at(const int owner,
+                          const size_t* displacements,
+                          const T* values,
+                          const size_t count,
+                          const Op op = Op::sum);
+
+        Request async_get(Chunk& chunk);
+
+        Request async_put(Chunk& chunk);
+
+};
+
+/*****************************************
+ * Destructor
+ *
+ * free() is collective, so it is never
+ *   called here, where the other tasks may
+ *   not be destroying theirs. If free()
+ *   was not called, this warns and leaks
+ *   the memory
+*****************************************/
+inline Global_Data::~Global_Data()
+{
+    if (is_allocated()) printf("beo::Global_Data::~Global_Data %s was not freed\n", name_.c_str());
+}
+
+/*****************************************
+ * allocate
+ *
+ * Collectively allocates the chunks of
+ *   data_tag, with elm_bytes per element,
+ *   across the tasks of comm
+*****************************************/
+inline int Global_Data::allocate(Comm& comm,
+                                 Data_Tag& data_tag,
+                                 const size_t elm_bytes)
+{
+    std::lock_guard<mutex_t> g(m);
+
+    if (is_allocated()) return BEO_FAIL;
+
+    comm_ = comm;
+
+    distribution_.init(data_tag, comm_.num_tasks(), elm_bytes);
+
+    const size_t bytes = distribution_.bytes(comm_.task_id());
+
+    #if defined _BEO_MPI_
+
+    int stat = MPI_Win_allocate((MPI_Aint) bytes,
+                                1,
+                                MPI_INFO_NULL,
+                                comm_.comm(),
+                                &base_,
+                                &win_);
+
+    if (MPI_SUCCESS != stat) return BEO_FAIL;
+
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+
+    #elif defined _BEO_SHM_
+
+    if (BEO_SUCCESS != window_.allocate(comm_, bytes)) return BEO_FAIL;
+
+    base_ = window_.base(comm_.task_id());
+
+    #else
+
+    base_ = (bytes > 0) ? (char*) aligned_alloc(BEO_CHUNK_ALIGNMENT, bytes) : nullptr;
+
+    if (bytes > 0 && nullptr == base_) return BEO_FAIL;
+
+    peers_.assign(comm_.num_tasks(), nullptr);
+
+    Global_Data* self = this;
+
+    if (BEO_SUCCESS != beo::allgather(comm_, peers_.data(), &self, sizeof(Global_Data*))) return BEO_FAIL;
+
+    #endif
+
+    is_allocated_ = true;
+
+    return BEO_SUCCESS;
+}
+
+/*****************************************
+ * free
+ *
+ * Collectively frees the window
+*****************************************/
+inline int Global_Data::free()
+{
+    std::lock_guard<mutex_t> g(m);
+
+    if (!is_allocated()) return BEO_SUCCESS;
+
+    #if defined _BEO_MPI_
+
+    MPI_Win_unlock_all(win_);
+
+    int stat = MPI_Win_free(&win_);
+
+    #elif defined _BEO_SHM_
+
+    int stat = window_.free(comm_);
+
+    #else
+
+    //no peer may still be using this task's memory
+    int stat = beo::barrier(comm_);
+
+    std::free(base_);
+
+    peers_.clear();
+
+    #endif
+
+    base_ = nullptr;
+
+    comm_.finalize();
+
+    is_allocated_ = false;
+
+    return (0 == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+/*****************************************
+ * sync
+ *
+ * Completes all outstanding operations,
+ *   and makes them and any local stores
+ *   visible to every task
+*****************************************/
+inline int Global_Data::sync()
+{
+    if (!is_allocated()) return BEO_FAIL;
+
+    #if defined _BEO_MPI_
+
+    MPI_Win_flush_all(win_);
+
+    MPI_Win_sync(win_);
+
+    int stat = beo::barrier(comm_);
+
+    MPI_Win_sync(win_);
+
+    return stat;
+
+    #else
+
+    return beo::barrier(comm_);
+
+    #endif
+}
+
+/*****************************************
+ * flush
+ *
+ * Completes all outstanding operations
+ *   from this task at their owners
+*****************************************/
+inline int Global_Data::flush()
+{
+    if (!is_allocated()) return BEO_FAIL;
+
+    #if defined _BEO_MPI_
+
+    return (MPI_SUCCESS == MPI_Win_flush_all(win_)) ? BEO_SUCCESS : BEO_FAIL;
+
+    #else
+
+    return BEO_SUCCESS;
+
+    #endif
+}
+
+/*****************************************
+ * local_data
+*****************************************/
+inline void* Global_Data::local_data(const offsets_t& offsets)
+{
+    const auto& loc = distribution_.location(offsets);
+
+    return (loc.owner == comm_.task_id()) ? (void*) (base_ + loc.displacement) : nullptr;
+}
+
+/*****************************************
+ * prepare
+ *
+ * Makes sure the chunk is known to the
+ *   Global_Data and has room for its data.
+ *   A chunk that is already allocated but
+ *   too small is an error
+*****************************************/
+inline int Global_Data::prepare(Chunk& chunk)
+{
+    if (!is_allocated()) return BEO_FAIL;
+
+    const auto& loc = distribution_.location(chunk.offsets());
+
+    if (chunk.is_allocated()) return (chunk.bytes() >= loc.bytes) ? BEO_SUCCESS : BEO_FAIL;
+
+    const size_t bytes = (loc.bytes + BEO_CHUNK_ALIGNMENT - 1)
+                       / BEO_CHUNK_ALIGNMENT * BEO_CHUNK_ALIGNMENT;
+
+    return chunk.aligned_allocate(BEO_CHUNK_ALIGNMENT, (bytes > 0) ? bytes : BEO_CHUNK_ALIGNMENT);
+}
+
+/*****************************************
+ * fits
+ *
+ * True if the chunk is allocated and has
+ *   room for all of its data
+*****************************************/
+inline bool Global_Data::fits(Chunk& chunk)
+{
+    if (!is_allocated() || !chunk.is_allocated()) return false;
+
+    return chunk.bytes() >= distribution_.location(chunk.offsets()).bytes;
+}
+
+/*****************************************
+ * get
+ *
+ * Copies the chunk from its owner into
+ *   chunk.data(), allocating it if needed
+*****************************************/
+inline int Global_Data::get(Chunk& chunk)
+{
+    std::lock_guard<Chunk::mutex_t> g(chunk.m);
+
+    if (BEO_SUCCESS != prepare(chunk)) return BEO_FAIL;
+
+    const auto& loc = distribution_.location(chunk.offsets());
+
+    #if defined _BEO_MPI_
+
+    int stat = MPI_Get(chunk.data(),
+                       (int) loc.bytes,
+                       MPI_BYTE,
+                       loc.owner,
+                       (MPI_Aint) loc.displacement,
+                       (int) loc.bytes,
+                       MPI_BYTE,
+                       win_);
+
+    if (MPI_SUCCESS != stat) return BEO_FAIL;
+
+    return (MPI_SUCCESS == MPI_Win_flush(loc.owner, win_)) ? BEO_SUCCESS : BEO_FAIL;
+
+    #else
+
+    return beo::memmove(chunk.data(), base(loc.owner) + loc.displacement, loc.bytes);
+
+    #endif
+}
+
+/*****************************************
+ * put
+ *
+ * Copies chunk.data() into the owner's
+ *   copy of the chunk
+*****************************************/
+inline int Global_Data::put(Chunk& chunk)
+{
+    std::lock_guard<Chunk::mutex_t> g(chunk.m);
+
+    if (!fits(chunk)) return BEO_FAIL;
+
+    const auto& loc = distribution_.location(chunk.offsets());
+
+    #if defined _BEO_MPI_
+
+    int stat = MPI_Put(chunk.data(),
+                       (int) loc.bytes,
+                       MPI_BYTE,
+                       loc.owner,
+                       (MPI_Aint) loc.displacement,
+                       (int) loc.bytes,
+                       MPI_BYTE,
+                       win_);
+
+    if (MPI_SUCCESS != stat) return BEO_FAIL;
+
+    return (MPI_SUCCESS == MPI_Win_flush(loc.owner, win_)) ? BEO_SUCCESS : BEO_FAIL;
+
+    #else
+
+    return beo::memmove(base(loc.owner) + loc.displacement, chunk.data(), loc.bytes);
+
+    #endif
+}
+
+/*****************************************
+ * accumulate
+ *
+ * Atomically combines the elements (of
+ *   type T) of chunk.data() into the
+ *   owner's copy of the chunk with op
+*****************************************/
+template<typename T>
+inline int Global_Data::accumulate(Chunk& chunk, const Op op)
+{
+    std::lock_guard<Chunk::mutex_t> g(chunk.m);
+
+    if (!fits(chunk)) return BEO_FAIL;
+
+    const auto& loc = distribution_.location(chunk.offsets());
+
+    const size_t count = loc.bytes / sizeof(T);
+
+    #if defined _BEO_MPI_
+
+    int stat = MPI_Accumulate(chunk.data(),
+                              (int) count,
+                              Datatype<T>::type(),
+                              loc.owner,
+                              (MPI_Aint) loc.displacement,
+                              (int) count,
+                              Datatype<T>::type(),
+                              mpi_op(op),
+                              win_);
+
+    if (MPI_SUCCESS != stat) return BEO_FAIL;
+
+    return (MPI_SUCCESS == MPI_Win_flush(loc.owner, win_)) ? BEO_SUCCESS : BEO_FAIL;
+
+    #elif defined _BEO_SHM_
+
+    //the owner's lock makes the update atomic
+    window_.lock(loc.owner);
+
+    apply_op<T>(op, (T*) (base(loc.owner) + loc.displacement), (const T*) chunk.data(), count);
+
+    window_.unlock(loc.owner);
+
+    return BEO_SUCCESS;
+
+    #else
+
+    //the owner's mutex makes the update atomic
+    std::lock_guard<mutex_t> g2(peers_[loc.owner]->m);
+
+    apply_op<T>(op, (T*) (base(loc.owner) + loc.displacement), (const T*) chunk.data(), count);
+
+    return BEO_SUCCESS;
+
+    #endif
+}
+
+/*****************************************
+ * get_at
+ *
+ * Copies the count elements at byte
+ *   displacements of owner's memory into
+ *   dest, one after the other.
+ *
+ * In the MPI case this is one MPI_Get,
+ *   whose target is an hindexed datatype
+ *   over the elements
+*****************************************/
+inline int Global_Data::get_at(const int owner,
+                               const size_t* displacements,
+                               void* dest,
+                               const size_t count)
+{
+    if (!is_allocated()) return BEO_FAIL;
+
+    if (0 == count) return BEO_SUCCESS;
+
+    const size_t elm_bytes = distribution_.elm_bytes();
+
+    #if defined _BEO_MPI_
+
+    std::vector<MPI_Aint> disps(displacements, displacements + count);
+
+    MPI_Datatype target;
+
+    int stat = MPI_Type_create_hindexed_block((int) count,
+                                              (int) elm_bytes,
+                                              disps.data(),
+                                              MPI_BYTE,
+                                              &target);
+
+    if (MPI_SUCCESS != stat) return BEO_FAIL;
+
+    MPI_Type_commit(&target);
+
+    stat = MPI_Get(dest,
+                   (int) (count * elm_bytes),
+                   MPI_BYTE,
+                   owner,
+                   0,
+                   1,
+                   target,
+                   win_);
+
+    //freeing is deferred by MPI until the get is done with it
+    MPI_Type_free(&target);
+
+    if (MPI_SUCCESS != stat) return BEO_FAIL;
+
+    return (MPI_SUCCESS == MPI_Win_flush(owner, win_)) ? BEO_SUCCESS : BEO_FAIL;
+
+    #else
+
+    const char* src = base(owner);
+
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        memcpy((char*) dest + idx * elm_bytes, src + displacements[idx], elm_bytes);
+    }
+
+    return BEO_SUCCESS;
+
+    #endif
+}
+
+/*****************************************
+ * accumulate_at
+ *
+ * Atomically combines values[i] into the
+ *   element of type T at byte
+ *   displacements[i] of owner's memory,
+ *   for i < count, with op. The
+ *   displacements should not repeat.
+ *
+ * In the MPI case this is one
+ *   MPI_Accumulate, whose target is an
+ *   hindexed datatype over the elements
+*****************************************/
+template<typename T>
+inline int Global_Data::accumulate_at(const int owner,
+                                      const size_t* displacements,
+                                      const T* values,
+                                      const size_t count,
+                                      const Op op)
+{
+    if (!is_allocated()) return BEO_FAIL;
+
+    if (0 == count) return BEO_SUCCESS;
+
+    #if defined _BEO_MPI_
+
+    std::vector<MPI_Aint> disps(displacements, displacements + count);
+
+    MPI_Datatype target;
+
+    int stat = MPI_Type_create_hindexed_block((int) count,
+                                              1,
+                                              disps.data(),
+                                              Datatype<T>::type(),
+                                              &target);
+
+    if (MPI_SUCCESS != stat) return BEO_FAIL;
+
+    MPI_Type_commit(&target);
+
+    stat = MPI_Accumulate(values,
+                          (int) count,
+                          Datatype<T>::type(),
+                          owner,
+                          0,
+                          1,
+                          target,
+                          mpi_op(op),
+                          win_);
+
+    //freeing is deferred by MPI until the accumulate is done with it
+    MPI_Type_free(&target);
+
+    if (MPI_SUCCESS != stat) return BEO_FAIL;
+
+    return (MPI_SUCCESS == MPI_Win_flush(owner, win_)) ? BEO_SUCCESS : BEO_FAIL;
+
+    #else
+
+    char* dest = base(owner);
+
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        atomic_apply_op<T>(op, (T*) (dest + displacements[idx]), values[idx]);
+    }
+
+    return BEO_SUCCESS;
+
+    #endif
+}
+
+/*****************************************
+ * async_get
+ *
+ * Returns a beo::Request that, when
+ *   complete, will have copied the chunk
+ *   into chunk.data(). The chunk is
+ *   allocated here if needed.
+*****************************************/
+inline Request Global_Data::async_get(Chunk& chunk)
+{
+    std::lock_guard<Chunk::mutex_t> g(chunk.m);
+
+    if (BEO_SUCCESS != prepare(chunk))
+    {
+        printf("beo::Global_Data::async_get could not prepare chunk on %s\n", name_.c_str());
+        exit(1);
+    }
+
+    const auto& loc = distribution_.location(chunk.offsets());
+
+    #if defined _BEO_MPI_
+
+    MPI_Request fake;
+
+    int stat = MPI_Rget(chunk.data(),
+                        (int) loc.bytes,
+                        MPI_BYTE,
+                        loc.owner,
+                        (MPI_Aint) loc.displacement,
+                        (int) loc.bytes,
+                        MPI_BYTE,
+                        win_,
+                        &fake);
+
+    if (stat != MPI_SUCCESS) exit(1);
+
+    Request request = std::move(fake);
+
+    return request;
+
+    #else
+
+    void*       dest  = chunk.data();
+    const void* src   = base(loc.owner) + loc.displacement;
+    size_t      bytes = loc.bytes;
+
+    Request request = beo::thread_pool().submit([=]()
+    {
+        return beo::memmove(dest, src, bytes);
+    });
+
+    return request;
+
+    #endif
+}
+
+/*****************************************
+ * async_put
+ *
+ * Returns a beo::Request that, when
+ *   complete, means chunk.data() may be
+ *   reused. Use flush() to ensure the put
+ *   has completed at the owner
+*****************************************/
+inline Request Global_Data::async_put(Chunk& chunk)
+{
+    std::lock_guard<Chunk::mutex_t> g(chunk.m);
+
+    if (!fits(chunk))
+    {
+        printf("beo::Global_Data::async_put chunk is not allocated, or too small, on %s\n", name_.c_str());
+        exit(1);
+    }
+
+    const auto& loc = distribution_.location(chunk.offsets());
+
+    #if defined _BEO_MPI_
+
+    MPI_Request fake;
+
+    int stat = MPI_Rput(chunk.data(),
+                        (int) loc.bytes,
+                        MPI_BYTE,
+                        loc.owner,
+                        (MPI_Aint) loc.displacement,
+                        (int) loc.bytes,
+                        MPI_BYTE,
+                        win_,
+                        &fake);
+
+    if (stat != MPI_SUCCESS) exit(1);
+
+    Request request = std::move(fake);
+
+    return request;
+
+    #else
+
+    void*       dest  = base(loc.owner) + loc.displacement;
+    const void* src   = chunk.data();
+    size_t      bytes = loc.bytes;
+
+    Request request = beo::thread_pool().submit([=]()
+    {
+        return beo::memmove(dest, src, bytes);
+    });
+
+    return request;
+
+    #endif
+}
+
+} //end namespace beo
+
+#endif
@@ -14,5 +14,19 @@
 #define _BEO_L1_HPP_
 
 #include "data_tag.hpp"
+#include "distribution.hpp"
+#include "shared_data.hpp"
+#include "global_data.hpp"
+#include "element_locator.hpp"
+#include "scatter_accumulator.hpp"
+#include "gather.hpp"
+#include "aggregator.hpp"
+#include "contraction.hpp"
+#include "permutation.hpp"
+#include "vector_ops.hpp"
+#include "expression.hpp"
+#include "task_counter.hpp"
+#include "parallel_for_each.hpp"
+#include "task_graph.hpp"
 
 #endif
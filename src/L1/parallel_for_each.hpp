@@ -0,0 +1,121 @@
+/*****************************************
+ * parallel_for_each.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::parallel_for_each,
+ *   which runs func(chunk_tag) for every
+ *   chunk of a Data_Tag on the threads of
+ *   this task's beo::thread_pool(), e.g.,
+ *
+ *     beo::parallel_for_each(data_tag, [&](beo::Chunk_Tag& chunk_tag)
+ *     {
+ *         return compute(chunk_tag);
+ *     });
+ *
+ * The chunks are dealt to the workers by
+ *   cost, the number of elements unless a
+ *   cost function is given: biggest first,
+ *   each to the worker with the least work
+ *   so far. Each worker runs its biggest
+ *   chunks first, and workers that run
+ *   out steal the smallest chunks left,
+ *   from their own NUMA domain first (see
+ *   thread_pool.hpp), which evens out the
+ *   tail. The calling thread helps too.
+ *
+ * This is local to the task. With MPI, use
+ *   it within the chunks a task owns, or
+ *   with for_each_chunk_dynamic
+*****************************************/
+#ifndef _BEO_PARALLEL_FOR_EACH_HPP_
+#define _BEO_PARALLEL_FOR_EACH_HPP_
+
+#include <vector>
+#include <future>
+#include <chrono>
+#include <utility>
+#include <algorithm>
+
+#include "../L0/l0.hpp"
+#include "data_tag.hpp"
+
+namespace beo
+{
+
+/*****************************************
+ * parallel_for_each
+ *
+ * func returns BEO_SUCCESS or BEO_FAIL,
+ *   and cost(chunk_tag) returns a double.
+ *   Returns BEO_FAIL if func failed on
+ *   any chunk
+*****************************************/
+template<typename F, typename C>
+inline int parallel_for_each(Data_Tag& data_tag, F&& func, C&& cost)
+{
+    auto& pool = beo::thread_pool();
+
+    if (!pool.is_running()) pool.init();
+
+    const size_t num_workers = pool.num_threads();
+
+    auto chunk_tags = sorted_chunk_tags(data_tag);
+
+    std::vector<std::pair<double, Chunk_Tag*>> costs;
+    costs.reserve(chunk_tags.size());
+    for (auto chunk_tag : chunk_tags) costs.emplace_back((double) cost(*chunk_tag), chunk_tag);
+
+    std::stable_sort(costs.begin(), costs.end(), [](const auto& a, const auto& b) {return a.first > b.first;});
+
+    //biggest first, to the least loaded worker
+    std::vector<double> load(num_workers, 0.0);
+    std::vector<std::vector<Chunk_Tag*>> dealt(num_workers);
+
+    for (const auto& [c, chunk_tag] : costs)
+    {
+        const size_t worker = std::min_element(load.begin(), load.end()) - load.begin();
+
+        load[worker] += c;
+        dealt[worker].push_back(chunk_tag);
+    }
+
+    //workers pop from the back, so the smallest go in first
+    std::vector<std::future<int>> futures;
+    futures.reserve(costs.size());
+
+    for (size_t worker = 0; worker < num_workers; worker++)
+    {
+        for (auto itr = dealt[worker].rbegin(); itr != dealt[worker].rend(); itr++)
+        {
+            Chunk_Tag* chunk_tag = *itr;
+
+            futures.push_back(pool.submit_to(worker, [&func, chunk_tag]() {return func(*chunk_tag);}));
+        }
+    }
+
+    int stat = BEO_SUCCESS;
+
+    for (auto& future : futures)
+    {
+        while (std::future_status::ready != future.wait_for(std::chrono::seconds(0)))
+        {
+            if (!pool.run_one()) future.wait();
+        }
+
+        if (BEO_SUCCESS != future.get()) stat = BEO_FAIL;
+    }
+
+    return stat;
+}
+
+template<typename F>
+inline int parallel_for_each(Data_Tag& data_tag, F&& func)
+{
+    return parallel_for_each(data_tag, std::forward<F>(func), [](const Chunk_Tag& chunk_tag) {return (double) chunk_tag.size();});
+}
+
+} //end namespace beo
+
+#endif
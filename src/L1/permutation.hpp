@@ -0,0 +1,518 @@
+/*****************************************
+ * permutation.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Permutation, which
+ *   reorders the indices of a block tensor
+ *   held in beo::Global_Data, e.g.,
+ *
+ *     D[i,a,j,b] = S[i,j,a,b]
+ *
+ *   with the indices named by one
+ *   character labels ("iajb", "ijab").
+ *   As in beo::Contraction, the elements
+ *   of a chunk are row-major in the order
+ *   of its labels.
+ *
+ * The tilings of D and S need not agree.
+ *   plan finds, for each chunk of D this
+ *   task owns, the chunks of S that
+ *   overlap it and the overlaps.
+ *
+ * execute is owner-computes on D: each
+ *   task pulls the S chunks it needs with
+ *   one-sided gets (the all-to-all
+ *   exchange, without the owners having
+ *   to take part) and copies the overlaps
+ *   into its chunks of D. The S chunks are
+ *   fetched in batches of at most
+ *   batch_bytes, so memory is bounded, and
+ *   each task starts at a different S
+ *   chunk, so they do not all ask the same
+ *   owner at once.
+ *
+ * The local kernel copies in tiles of
+ *   32x32 elements when the fastest index
+ *   of D is not that of S, so that both
+ *   sides are read and written a cache
+ *   line at a time.
+ *
+ * plan is local. execute is collective
+ *   over the comm of D, which must also
+ *   be that of S, and syncs D before
+ *   returning.
+*****************************************/
+#ifndef _BEO_PERMUTATION_HPP_
+#define _BEO_PERMUTATION_HPP_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <unordered_map>
+
+#include "../L0/l0.hpp"
+#include "data_tag.hpp"
+#include "global_data.hpp"
+
+namespace beo
+{
+
+class Permutation
+{
+    public:
+
+        using key_t     = Chunk_Tag::key_t;
+
+        using offsets_t = Chunk_Tag::offsets_t;
+
+        using lengths_t = Chunk_Tag::lengths_t;
+
+        //the part of chunk src of S that lands in chunk dest of D
+        struct Piece
+        {
+            key_t     dest;
+
+            key_t     src;
+
+            //in S's order
+            offsets_t offsets;
+
+            lengths_t lengths;
+        };
+
+        //bytes of S chunks fetched at once
+        static const size_t default_batch_bytes = 256 * 1024 * 1024;
+
+    protected:
+
+        using lengths_map_t = std::unordered_map<key_t, lengths_t, Chunk_Tag_Hash>;
+
+        std::string        dest_labels_;
+
+        std::string        src_labels_;
+
+        Global_Data*       dest_{nullptr};
+
+        Global_Data*       src_{nullptr};
+
+        lengths_map_t      dest_lengths_;
+
+        lengths_map_t      src_lengths_;
+
+        //grouped by S chunk
+        std::vector<Piece> pieces_;
+
+        size_t             batch_bytes_;
+
+        //position in S of each index of D
+        std::vector<size_t> perm_;
+
+        template<typename E>
+        void copy(char* dest, const char* src, const Piece& piece);
+
+        void copy(char* dest, const char* src, const Piece& piece, const size_t elm_bytes);
+
+    public:
+
+        Permutation(const std::string& dest_labels,
+                    const std::string& src_labels,
+                    const size_t batch_bytes = default_batch_bytes)
+        : dest_labels_(dest_labels), src_labels_(src_labels), batch_bytes_(batch_bytes) {}
+
+        int plan(Data_Tag& dest_tag, Global_Data& dest,
+                 Data_Tag& src_tag, Global_Data& src);
+
+        //the overlaps this task will copy, in order
+        const std::vector<Piece>& pieces() const {return pieces_;}
+
+        int execute();
+};
+
+//plans and executes D[dest_labels] = S[src_labels]
+int permute(const std::string& dest_labels, Data_Tag& dest_tag, Global_Data& dest,
+            const std::string& src_labels, Data_Tag& src_tag, Global_Data& src);
+
+/*****************************************
+ * plan
+ *
+ * Finds the overlaps of the chunks of S
+ *   with the chunks of D on this task
+*****************************************/
+inline int Permutation::plan(Data_Tag& dest_tag, Global_Data& dest,
+                             Data_Tag& src_tag, Global_Data& src)
+{
+    const size_t nd = dest_labels_.size();
+
+    perm_.assign(nd, 0);
+
+    bool valid = (src_labels_.size() == nd);
+
+    for (size_t d = 0; valid && d < nd; d++)
+    {
+        perm_[d] = src_labels_.find(dest_labels_[d]);
+
+        valid = (std::string::npos != perm_[d]) && (dest_labels_.find(dest_labels_[d], d + 1) == std::string::npos);
+    }
+
+    if (!valid)
+    {
+        printf("beo::Permutation %s is not a permutation of %s\n", dest_labels_.c_str(), src_labels_.c_str());
+        return BEO_FAIL;
+    }
+
+    if (!dest.is_allocated() || !src.is_allocated()) return BEO_FAIL;
+
+    dest_ = &dest;
+    src_  = &src;
+
+    pieces_.clear();
+    dest_lengths_.clear();
+    src_lengths_.clear();
+
+    for (auto [tag, lengths] : {std::make_pair(&dest_tag, &dest_lengths_), std::make_pair(&src_tag, &src_lengths_)})
+    {
+        std::lock_guard<Data_Tag::mutex_t> g(tag->m);
+
+        for (const auto& [key, chunk_tag] : tag->chunk_tags())
+        {
+            if (key.size() != nd)
+            {
+                printf("beo::Permutation chunk of %s has %zu dimensions, not %zu\n",
+                       tag->name().c_str(), key.size(), nd);
+                return BEO_FAIL;
+            }
+
+            lengths->insert({key, chunk_tag.lengths()});
+        }
+    }
+
+    //the offsets of the S chunks, and their longest length, along each index
+    std::vector<std::vector<size_t>> starts(nd);
+    std::vector<size_t> longest(nd, 0);
+
+    for (const auto& [key, lengths] : src_lengths_)
+    {
+        for (size_t s = 0; s < nd; s++)
+        {
+            starts[s].push_back(key[s]);
+            longest[s] = std::max(longest[s], lengths[s]);
+        }
+    }
+
+    for (auto& start : starts)
+    {
+        std::sort(start.begin(), start.end());
+        start.erase(std::unique(start.begin(), start.end()), start.end());
+    }
+
+    for (const auto& [dest_key, dest_len] : dest_lengths_)
+    {
+        if (!dest.is_local(dest_key)) continue;
+
+        //the region in S's order, and the S offsets that may overlap it
+        offsets_t lo(nd), hi(nd);
+        std::vector<std::vector<size_t>> candidates(nd);
+
+        for (size_t d = 0; d < nd; d++)
+        {
+            const size_t s = perm_[d];
+
+            lo[s] = dest_key[d];
+            hi[s] = dest_key[d] + dest_len[d];
+
+            for (const auto start : starts[s])
+            {
+                if (start < hi[s] && start + longest[s] > lo[s]) candidates[s].push_back(start);
+            }
+
+            if (candidates[s].empty()) break;
+        }
+
+        //every combination of candidate offsets
+        std::vector<size_t> idx(nd, 0);
+
+        bool done = std::any_of(candidates.begin(), candidates.end(), [](const auto& c) {return c.empty();});
+
+        while (!done)
+        {
+            key_t src_key(nd);
+            for (size_t s = 0; s < nd; s++) src_key[s] = candidates[s][idx[s]];
+
+            auto itr = src_lengths_.find(src_key);
+
+            if (itr != src_lengths_.end())
+            {
+                Piece piece{dest_key, src_key, offsets_t(nd), lengths_t(nd)};
+
+                bool overlaps = true;
+
+                for (size_t s = 0; s < nd; s++)
+                {
+                    const size_t first = std::max(lo[s], src_key[s]);
+                    const size_t last  = std::min(hi[s], src_key[s] + itr->second[s]);
+
+                    overlaps &= (first < last);
+
+                    piece.offsets[s] = first;
+                    piece.lengths[s] = overlaps ? last - first : 0;
+                }
+
+                if (overlaps) pieces_.push_back(std::move(piece));
+            }
+
+            size_t s = nd;
+            while (s-- > 0)
+            {
+                if (++idx[s] < candidates[s].size()) break;
+                idx[s] = 0;
+            }
+
+            done = (s == (size_t) -1);
+        }
+    }
+
+    //group by S chunk, starting from a different one on each task
+    std::sort(pieces_.begin(), pieces_.end(), [](const Piece& x, const Piece& y)
+    {
+        if (x.src != y.src) return x.src < y.src;
+        return x.dest < y.dest;
+    });
+
+    if (!pieces_.empty())
+    {
+        const size_t n = pieces_.size();
+        const size_t s = (size_t) dest.comm().task_id() * n / (size_t) dest.comm().num_tasks();
+
+        auto first = std::find_if(pieces_.begin() + s, pieces_.end(), [&](const Piece& p) {return p.src != pieces_[s].src;});
+        auto start = (s > 0 && pieces_[s - 1].src == pieces_[s].src) ? first : pieces_.begin() + s;
+
+        std::rotate(pieces_.begin(), start, pieces_.end());
+    }
+
+    return BEO_SUCCESS;
+}
+
+/*****************************************
+ * copy
+ *
+ * Copies a piece from its S chunk (src)
+ *   to its D chunk (dest), with elements
+ *   of type E.
+ *
+ * When the fastest index of D is not that
+ *   of S, the two are copied in 32x32
+ *   tiles
+*****************************************/
+template<typename E>
+inline void Permutation::copy(char* dest_bytes, const char* src_bytes, const Piece& piece)
+{
+    E*       dest = (E*) dest_bytes;
+    const E* src  = (const E*) src_bytes;
+
+    const size_t nd = perm_.size();
+
+    if (0 == nd) {*dest = *src; return;}
+
+    const auto& dest_len = dest_lengths_[piece.dest];
+    const auto& src_len  = src_lengths_[piece.src];
+
+    //strides of D and S, and the start of the piece in each, in D's order
+    std::vector<size_t> dest_stride(nd, 1), src_stride(nd, 1), lengths(nd);
+
+    for (size_t d = nd - 1; d-- > 0;) dest_stride[d] = dest_stride[d + 1] * dest_len[d + 1];
+
+    std::vector<size_t> s_stride(nd, 1);
+    for (size_t s = nd - 1; s-- > 0;) s_stride[s] = s_stride[s + 1] * src_len[s + 1];
+
+    size_t dest_off = 0, src_off = 0;
+
+    for (size_t d = 0; d < nd; d++)
+    {
+        const size_t s = perm_[d];
+
+        src_stride[d] = s_stride[s];
+        lengths[d]    = piece.lengths[s];
+
+        dest_off += (piece.offsets[s] - piece.dest[d]) * dest_stride[d];
+        src_off  += (piece.offsets[s] - piece.src[s]) * s_stride[s];
+    }
+
+    //the fastest index of D (di), and of S (si), in D's order
+    const size_t di = nd - 1;
+    const size_t si = std::find(perm_.begin(), perm_.end(), nd - 1) - perm_.begin();
+
+    //every other index
+    std::vector<size_t> outer;
+    for (size_t d = 0; d < nd; d++) if (d != di && d != si) outer.push_back(d);
+
+    size_t num_outer = 1;
+    for (const auto d : outer) num_outer *= lengths[d];
+
+    std::vector<size_t> idx(outer.size(), 0);
+
+    const size_t bs = 32;
+
+    for (size_t n = 0; n < num_outer; n++)
+    {
+        E*       dp = dest + dest_off;
+        const E* sp = src + src_off;
+
+        if (di == si)
+        {
+            for (size_t l = 0; l < lengths[di]; l++) dp[l] = sp[l];
+        }
+
+        else
+        {
+            const size_t nr = lengths[si], nc = lengths[di];
+
+            for (size_t r0 = 0; r0 < nr; r0 += bs)
+            {
+                for (size_t c0 = 0; c0 < nc; c0 += bs)
+                {
+                    const size_t r1 = std::min(nr, r0 + bs), c1 = std::min(nc, c0 + bs);
+
+                    for (size_t c = c0; c < c1; c++)
+                    {
+                        for (size_t r = r0; r < r1; r++) dp[r * dest_stride[si] + c] = sp[c * src_stride[di] + r];
+                    }
+                }
+            }
+        }
+
+        for (size_t o = outer.size(); o-- > 0;)
+        {
+            const size_t d = outer[o];
+
+            dest_off += dest_stride[d];
+            src_off  += src_stride[d];
+
+            if (++idx[o] < lengths[d]) break;
+
+            dest_off -= idx[o] * dest_stride[d];
+            src_off  -= idx[o] * src_stride[d];
+            idx[o] = 0;
+        }
+    }
+}
+
+inline void Permutation::copy(char* dest, const char* src, const Piece& piece, const size_t elm_bytes)
+{
+    struct Pair {uint64_t x[2];};
+
+    switch (elm_bytes)
+    {
+        case 1  : copy<uint8_t>(dest, src, piece);  break;
+        case 2  : copy<uint16_t>(dest, src, piece); break;
+        case 4  : copy<uint32_t>(dest, src, piece); break;
+        case 8  : copy<uint64_t>(dest, src, piece); break;
+        case 16 : copy<Pair>(dest, src, piece);     break;
+        default :
+            printf("beo::Permutation elements of %zu bytes are not supported\n", elm_bytes);
+            exit(1);
+    }
+}
+
+/*****************************************
+ * execute
+ *
+ * Fetches the S chunks a batch at a time,
+ *   and copies their pieces into D
+*****************************************/
+inline int Permutation::execute()
+{
+    if (nullptr == dest_) return BEO_FAIL;
+
+    const size_t elm_bytes = dest_->distribution().elm_bytes();
+
+    if (src_->distribution().elm_bytes() != elm_bytes)
+    {
+        printf("beo::Permutation::execute the element sizes of D and S differ\n");
+        return BEO_FAIL;
+    }
+
+    int stat = BEO_SUCCESS;
+
+    size_t first = 0;
+
+    while (first < pieces_.size())
+    {
+        //the S chunks of this batch, and the pieces they cover
+        std::vector<std::unique_ptr<Chunk>> chunks;
+        std::vector<Request>                requests;
+        std::vector<const char*>            data;
+        std::vector<size_t>                 ends;
+
+        size_t bytes = 0, last = first;
+
+        while (last < pieces_.size())
+        {
+            const key_t& key = pieces_[last].src;
+
+            const size_t chunk_bytes = src_->distribution().location(key).bytes;
+
+            if (!chunks.empty() && !src_->is_local(key) && bytes + chunk_bytes > batch_bytes_) break;
+
+            if (src_->is_local(key))
+            {
+                chunks.emplace_back(nullptr);
+                data.push_back((const char*) src_->local_data(key));
+            }
+
+            else
+            {
+                chunks.emplace_back(new Chunk(Chunk_Tag(key, src_lengths_[key])));
+                requests.push_back(src_->async_get(*chunks.back()));
+                data.push_back(nullptr);
+                bytes += chunk_bytes;
+            }
+
+            while (last < pieces_.size() && pieces_[last].src == key) last++;
+
+            ends.push_back(last);
+        }
+
+        for (auto& request : requests) stat |= request.wait();
+
+        for (size_t n = 0; n < chunks.size(); n++)
+        {
+            const char* src = (nullptr != chunks[n]) ? (const char*) chunks[n]->data() : data[n];
+
+            for (; first < ends[n]; first++)
+            {
+                const Piece& piece = pieces_[first];
+
+                copy((char*) dest_->local_data(piece.dest), src, piece, elm_bytes);
+            }
+        }
+    }
+
+    stat |= dest_->sync();
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+/*****************************************
+ * permute
+*****************************************/
+inline int permute(const std::string& dest_labels, Data_Tag& dest_tag, Global_Data& dest,
+                   const std::string& src_labels, Data_Tag& src_tag, Global_Data& src)
+{
+    Permutation permutation(dest_labels, src_labels);
+
+    int stat = permutation.plan(dest_tag, dest, src_tag, src);
+
+    //execute is collective, so a task that failed to plan still takes part
+    stat |= permutation.execute();
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+} //end namespace beo
+
+#endif
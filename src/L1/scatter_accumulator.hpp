@@ -0,0 +1,297 @@
+/*****************************************
+ * scatter_accumulator.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Scatter_Accumulator,
+ *   which combines a stream of single
+ *   (global index, value) contributions
+ *   into a beo::Global_Data, e.g., the
+ *   integrals of a shell quartet that land
+ *   in chunks all over the tensor,
+ *
+ *     beo::Scatter_Accumulator<double> acc(global_data, data_tag);
+ *
+ *     for (...) acc.add({i, j, k, l}, value);
+ *
+ *     acc.flush();
+ *     global_data.sync();
+ *
+ * add() finds the chunk, and so the owner,
+ *   of the element, and buckets it by
+ *   owner. flush() (or add(), once
+ *   max_buffered contributions are held)
+ *   sorts each owner's bucket by where the
+ *   elements live, combines repeats of the
+ *   same element locally, and hands the
+ *   bucket to Global_Data::accumulate_at
+ *   as one operation. Contributions are
+ *   complete at their owners once flush
+ *   returns, and visible to every task
+ *   after a sync.
+ *
+ * Indices are global, ndim per element,
+ *   and are found with a beo::Element_Locator
+ *   (see element_locator.hpp).
+ *
+ * accumulate(global_data, data_tag,
+ *   indices, values) does the same for
+ *   one batch.
+ *
+ * A Scatter_Accumulator is not thread
+ *   safe, use one per thread
+*****************************************/
+#ifndef _BEO_SCATTER_ACCUMULATOR_HPP_
+#define _BEO_SCATTER_ACCUMULATOR_HPP_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <initializer_list>
+
+#include "../L0/l0.hpp"
+#include "data_tag.hpp"
+#include "global_data.hpp"
+#include "element_locator.hpp"
+
+namespace beo
+{
+
+template<typename T>
+class Scatter_Accumulator
+{
+    public:
+
+        using index_t = Element_Locator::index_t;
+
+    protected:
+
+        struct Bucket
+        {
+            std::vector<size_t> displacements;
+
+            std::vector<T>      values;
+        };
+
+        Global_Data&        global_data_;
+
+        Element_Locator     locator_;
+
+        Op                  op_;
+
+        size_t              max_buffered_;
+
+        size_t              num_buffered_{0};
+
+        std::vector<Bucket> buckets_;
+
+        int flush(const int owner);
+
+    public:
+
+        Scatter_Accumulator(Global_Data& global_data,
+                            Data_Tag& data_tag,
+                            const Op op = Op::sum,
+                            const size_t max_buffered = 65536);
+
+       ~Scatter_Accumulator() {}
+
+        Scatter_Accumulator(const Scatter_Accumulator& other) = delete;
+
+        Scatter_Accumulator& operator=(const Scatter_Accumulator& other) = delete;
+
+        size_t ndim() const {return locator_.ndim();}
+
+        size_t num_buffered() const {return num_buffered_;}
+
+        //index holds ndim global indices
+        int add(const index_t* index, const T value);
+
+        int add(std::initializer_list<index_t> index, const T value) {return add(index.begin(), value);}
+
+        //indices holds ndim global indices per value
+        int add(const std::vector<index_t>& indices, const std::vector<T>& values);
+
+        int flush();
+};
+
+/*****************************************
+ * Constructor
+ *
+ * global_data must be allocated from
+ *   data_tag
+*****************************************/
+template<typename T>
+inline Scatter_Accumulator<T>::Scatter_Accumulator(Global_Data& global_data,
+                                                   Data_Tag& data_tag,
+                                                   const Op op,
+                                                   const size_t max_buffered)
+    : global_data_(global_data),
+      locator_(global_data, data_tag),
+      op_(op),
+      max_buffered_(std::max<size_t>(1, max_buffered))
+{
+    if (locator_.elm_bytes() != sizeof(T))
+    {
+        printf("beo::Scatter_Accumulator element size does not match %s\n", global_data_.name().c_str());
+        exit(1);
+    }
+
+    buckets_.resize(locator_.num_tasks());
+}
+
+/*****************************************
+ * add
+ *
+ * Buffers one contribution, flushing
+ *   everything once max_buffered are held
+*****************************************/
+template<typename T>
+inline int Scatter_Accumulator<T>::add(const index_t* index, const T value)
+{
+    int    owner;
+    size_t displacement;
+
+    locator_.locate(index, owner, displacement);
+
+    auto& bucket = buckets_[owner];
+
+    bucket.displacements.push_back(displacement);
+    bucket.values.push_back(value);
+
+    if (++num_buffered_ >= max_buffered_) return flush();
+
+    return BEO_SUCCESS;
+}
+
+template<typename T>
+inline int Scatter_Accumulator<T>::add(const std::vector<index_t>& indices,
+                                       const std::vector<T>& values)
+{
+    const size_t ndim = locator_.ndim();
+
+    if (indices.size() != values.size() * ndim)
+    {
+        printf("beo::Scatter_Accumulator::add needs %zu indices per value\n", ndim);
+        return BEO_FAIL;
+    }
+
+    int stat = BEO_SUCCESS;
+
+    for (size_t idx = 0; idx < values.size(); idx++)
+    {
+        if (BEO_SUCCESS != add(indices.data() + idx * ndim, values[idx])) stat = BEO_FAIL;
+    }
+
+    return stat;
+}
+
+/*****************************************
+ * flush
+ *
+ * Sends every bucket to its owner, which
+ *   is complete when this returns. The
+ *   owners are visited starting after
+ *   this task, so tasks do not all start
+ *   on the same one
+*****************************************/
+template<typename T>
+inline int Scatter_Accumulator<T>::flush()
+{
+    const int num_tasks = (int) buckets_.size();
+    const int task_id   = global_data_.comm().task_id();
+
+    int stat = BEO_SUCCESS;
+
+    for (int idx = 1; idx <= num_tasks; idx++)
+    {
+        if (BEO_SUCCESS != flush((task_id + idx) % num_tasks)) stat = BEO_FAIL;
+    }
+
+    num_buffered_ = 0;
+
+    return stat;
+}
+
+/*****************************************
+ * flush (owner)
+ *
+ * Sorts the owner's bucket by
+ *   displacement, combines repeats of an
+ *   element with op, and accumulates the
+ *   rest in one go
+*****************************************/
+template<typename T>
+inline int Scatter_Accumulator<T>::flush(const int owner)
+{
+    auto& bucket = buckets_[owner];
+
+    const size_t count = bucket.values.size();
+
+    if (0 == count) return BEO_SUCCESS;
+
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+
+    //stable, so replace keeps the last value added
+    std::stable_sort(order.begin(), order.end(), [&](const size_t a, const size_t b)
+    {
+        return bucket.displacements[a] < bucket.displacements[b];
+    });
+
+    std::vector<size_t> displacements;
+    std::vector<T>      values;
+
+    displacements.reserve(count);
+    values.reserve(count);
+
+    for (const auto idx : order)
+    {
+        const size_t disp = bucket.displacements[idx];
+
+        if (!displacements.empty() && displacements.back() == disp)
+        {
+            apply_op<T>(op_, &values.back(), &bucket.values[idx], 1);
+        }
+
+        else
+        {
+            displacements.push_back(disp);
+            values.push_back(bucket.values[idx]);
+        }
+    }
+
+    bucket.displacements.clear();
+    bucket.values.clear();
+
+    return global_data_.accumulate_at<T>(owner, displacements.data(), values.data(), values.size(), op_);
+}
+
+/*****************************************
+ * accumulate
+ *
+ * Combines values into global_data at
+ *   the global indices, ndim per value,
+ *   and returns once they are complete
+ *   at their owners
+*****************************************/
+template<typename T>
+inline int accumulate(Global_Data& global_data,
+                      Data_Tag& data_tag,
+                      const std::vector<size_t>& indices,
+                      const std::vector<T>& values,
+                      const Op op = Op::sum)
+{
+    Scatter_Accumulator<T> acc(global_data, data_tag, op, values.size());
+
+    if (BEO_SUCCESS != acc.add(indices, values)) return BEO_FAIL;
+
+    return acc.flush();
+}
+
+} //end namespace beo
+
+#endif
@@ -4,10 +4,38 @@
  * JHT, May 31, 2023, Dallas, TX
  *	- created
  *
- * Header file for beo::shared_data, 
- *   which manages and allocates 
- *   shared data on a particular 
- *   communicator. 
+ * Header file for beo::shared_data,
+ *   which manages and allocates
+ *   shared data on a particular
+ *   communicator.
+ *
+ * The chunks of a beo::Data_Tag are
+ *   spread over the tasks of the comm
+ *   with a beo::Distribution. In the MPI
+ *   case each task allocates its chunks
+ *   in an MPI_Win_allocate_shared window,
+ *   so the comm must be a shared-memory
+ *   comm (e.g., comms().shared()). Every
+ *   task can then load and store directly
+ *   into the chunks of its peers through
+ *   data(offsets), with no copies.
+ *
+ * The window is held in a passive
+ *   lock_all epoch between allocate and
+ *   free. Use sync() to make stores from
+ *   one task visible to the others.
+ *
+ * With _BEO_THREADS_ the tasks are
+ *   threads of one process, and each
+ *   allocates its own chunks and shares
+ *   their address with the others. With
+ *   _BEO_SHM_ the chunks live in a
+ *   beo::Shm_Window.
+ *
+ * allocate, free and sync are collective
+ *   over the comm. free must be called
+ *   explicitly, as the destructor does
+ *   not free
  *
 *****************************************/
 #ifndef _BEO_SHARED_DATA_HPP_
@@ -19,8 +47,17 @@
 #include <mpi.h>
 #endif
 
+#if defined _BEO_SHM_
+#include "../L0/shm_window.hpp"
+#endif
+
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
 #include "../L0/l0.hpp"
 #include "data_tag.hpp"
+#include "distribution.hpp"
 
 namespace beo
 {
@@ -29,14 +66,246 @@ class Shared_Data
 {
     public:
 
+    using name_t  = std::string;
+
+    using key_t   = name_t;
+
     using mutex_t = std::recursive_mutex;
 
+    mutex_t m;
+
     protected:
 
+    name_t             name_;
+
+    Comm               comm_;
+
+    Distribution       distribution_;
+
+    //base address of each task's memory
+    std::vector<char*> bases_;
+
+    bool               is_allocated_{false};
+
+    #if defined _BEO_MPI_
+
+    MPI_Win            win_{MPI_WIN_NULL};
+
+    #elif defined _BEO_SHM_
+
+    Shm_Window         window_;
+
+    #else
+
+    void*              data_{nullptr};
+
+    #endif
+
     public:
 
+    Shared_Data(const std::string& name) {name_ = name;}
+
+   ~Shared_Data();
+
+    Shared_Data(const Shared_Data& other) = delete;
+
+    Shared_Data& operator=(const Shared_Data& other) = delete;
+
+    const name_t& name() const {return name_;}
+
+    const key_t& key() const {return name_;}
+
+    void lock() {m.lock();}
+
+    void unlock() {m.unlock();}
+
+    bool is_allocated() const {return is_allocated_;}
+
+    const Distribution& distribution() const {return distribution_;}
+
+    int allocate(Comm& comm, Data_Tag& data_tag, const size_t elm_bytes);
+
+    int free();
+
+    int sync();
+
+    int owner(const Chunk_Tag::offsets_t& offsets) const {return distribution_.owner(offsets);}
+
+    bool is_local(const Chunk_Tag::offsets_t& offsets) const {return owner(offsets) == comm_.task_id();}
+
+    void* data(const Chunk_Tag::offsets_t& offsets);
+
 };
 
+/*****************************************
+ * Destructor
+ *
+ * free() is collective, so it is never
+ *   called here, where the other tasks may
+ *   not be destroying theirs. If free()
+ *   was not called, this warns and leaks
+ *   the memory
+*****************************************/
+inline Shared_Data::~Shared_Data()
+{
+    if (is_allocated()) printf("beo::Shared_Data::~Shared_Data %s was not freed\n", name_.c_str());
+}
+
+/*****************************************
+ * allocate
+ *
+ * Collectively allocates the chunks of
+ *   data_tag, with elm_bytes per element,
+ *   across the tasks of comm
+*****************************************/
+inline int Shared_Data::allocate(Comm& comm,
+                                 Data_Tag& data_tag,
+                                 const size_t elm_bytes)
+{
+    std::lock_guard<mutex_t> g(m);
+
+    if (is_allocated()) return BEO_FAIL;
+
+    comm_ = comm;
+
+    distribution_.init(data_tag, comm_.num_tasks(), elm_bytes);
+
+    bases_.assign(comm_.num_tasks(), nullptr);
+
+    #if defined _BEO_MPI_
+
+    char* base = nullptr;
+
+    int stat = MPI_Win_allocate_shared((MPI_Aint) distribution_.bytes(comm_.task_id()),
+                                       1,
+                                       MPI_INFO_NULL,
+                                       comm_.comm(),
+                                       &base,
+                                       &win_);
+
+    if (MPI_SUCCESS != stat) return BEO_FAIL;
+
+    for (int task = 0; task < comm_.num_tasks(); task++)
+    {
+        MPI_Aint size;
+        int      disp_unit;
+        char*    ptr = nullptr;
+
+        MPI_Win_shared_query(win_, task, &size, &disp_unit, &ptr);
+
+        bases_[task] = ptr;
+    }
+
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+
+    #elif defined _BEO_SHM_
+
+    if (BEO_SUCCESS != window_.allocate(comm_, distribution_.bytes(comm_.task_id()))) return BEO_FAIL;
+
+    for (int task = 0; task < comm_.num_tasks(); task++) bases_[task] = window_.base(task);
+
+    #else
+
+    //with _BEO_THREADS_ every task is in this process, so sharing
+    //  the base addresses is enough to share the memory
+    const size_t bytes = distribution_.bytes(comm_.task_id());
+
+    data_ = (bytes > 0) ? aligned_alloc(BEO_CHUNK_ALIGNMENT, bytes) : nullptr;
+
+    if (bytes > 0 && nullptr == data_) return BEO_FAIL;
+
+    char* base = (char*) data_;
+
+    if (BEO_SUCCESS != beo::allgather(comm_, bases_.data(), &base, sizeof(char*))) return BEO_FAIL;
+
+    #endif
+
+    is_allocated_ = true;
+
+    return BEO_SUCCESS;
+}
+
+/*****************************************
+ * free
+ *
+ * Collectively frees the shared memory
+*****************************************/
+inline int Shared_Data::free()
+{
+    std::lock_guard<mutex_t> g(m);
+
+    if (!is_allocated()) return BEO_SUCCESS;
+
+    #if defined _BEO_MPI_
+
+    MPI_Win_unlock_all(win_);
+
+    int stat = MPI_Win_free(&win_);
+
+    #elif defined _BEO_SHM_
+
+    int stat = window_.free(comm_);
+
+    #else
+
+    //no peer may still be using this task's memory
+    int stat = beo::barrier(comm_);
+
+    std::free(data_);
+    data_ = nullptr;
+
+    #endif
+
+    bases_.clear();
+
+    comm_.finalize();
+
+    is_allocated_ = false;
+
+    return (0 == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+/*****************************************
+ * sync
+ *
+ * Makes the stores of every task visible
+ *   to every other task
+*****************************************/
+inline int Shared_Data::sync()
+{
+    if (!is_allocated()) return BEO_FAIL;
+
+    #if defined _BEO_MPI_
+
+    MPI_Win_sync(win_);
+
+    int stat = beo::barrier(comm_);
+
+    MPI_Win_sync(win_);
+
+    return stat;
+
+    #else
+
+    return beo::barrier(comm_);
+
+    #endif
+}
+
+/*****************************************
+ * data
+ *
+ * returns a pointer to the chunk with the
+ *   given offsets, wherever on the node
+ *   it lives
+*****************************************/
+inline void* Shared_Data::data(const Chunk_Tag::offsets_t& offsets)
+{
+    const auto& loc = distribution_.location(offsets);
+
+    return (void*) (bases_[loc.owner] + loc.displacement);
+}
+
 } //end namespace beo
 
 #endif
@@ -0,0 +1,332 @@
+/*****************************************
+ * task_counter.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Task_Counter, a
+ *   counter shared by the tasks of a comm
+ *   (in the style of the Global Arrays
+ *   nxtval), and for_each_chunk_dynamic,
+ *   which uses one to hand out the chunks
+ *   of a Data_Tag to whichever task is
+ *   free, e.g.,
+ *
+ *     beo::for_each_chunk_dynamic(comm, data_tag, [&](beo::Chunk_Tag& chunk_tag)
+ *     {
+ *         return compute(chunk_tag);
+ *     });
+ *
+ * next(n) atomically adds n to the counter
+ *   and returns what it was, so n task
+ *   indices can be claimed at once. The
+ *   counter lives on task 0. In the MPI
+ *   case it is updated with
+ *   MPI_Fetch_and_op in a passive-target
+ *   lock_all epoch, so task 0 need not
+ *   take part. Otherwise it is a
+ *   std::atomic, in a beo::Shm_Window with
+ *   _BEO_SHM_.
+ *
+ * allocate, reset, and free are
+ *   collective over the comm
+*****************************************/
+#ifndef _BEO_TASK_COUNTER_HPP_
+#define _BEO_TASK_COUNTER_HPP_
+
+#if defined _BEO_MPI_
+#include <mpi.h>
+#endif
+
+#if defined _BEO_SHM_
+#include "../L0/shm_window.hpp"
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+#include <new>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+#include "../L0/l0.hpp"
+#include "data_tag.hpp"
+
+namespace beo
+{
+
+class Task_Counter
+{
+    public:
+
+        using value_t = int64_t;
+
+    protected:
+
+        Comm                 comm_;
+
+        bool                 is_allocated_{false};
+
+        #if defined _BEO_MPI_
+
+        MPI_Win              win_{MPI_WIN_NULL};
+
+        #elif defined _BEO_SHM_
+
+        Shm_Window           window_;
+
+        std::atomic<value_t>& value() {return *(std::atomic<value_t>*) window_.base(0);}
+
+        #else
+
+        std::atomic<value_t> value_{0};
+
+        //the Task_Counter of every task, which with _BEO_THREADS_
+        //  are all in this process
+        std::vector<Task_Counter*> peers_;
+
+        std::atomic<value_t>& value() {return peers_[0]->value_;}
+
+        #endif
+
+    public:
+
+        Task_Counter() {}
+
+       ~Task_Counter() {}
+
+        Task_Counter(const Task_Counter& other) = delete;
+
+        Task_Counter& operator=(const Task_Counter& other) = delete;
+
+        bool is_allocated() const {return is_allocated_;}
+
+        Comm& comm() {return comm_;}
+
+        int allocate(Comm& comm);
+
+        int free();
+
+        value_t next(const value_t n = 1);
+
+        int reset();
+};
+
+/*****************************************
+ * allocate
+ *
+ * Collectively creates the counter, set
+ *   to zero
+*****************************************/
+inline int Task_Counter::allocate(Comm& comm)
+{
+    if (is_allocated()) return BEO_FAIL;
+
+    comm_ = comm;
+
+    #if defined _BEO_MPI_
+
+    const MPI_Aint bytes = comm_.is_master() ? sizeof(value_t) : 0;
+
+    value_t* base = nullptr;
+
+    int stat = MPI_Win_allocate(bytes,
+                                sizeof(value_t),
+                                MPI_INFO_NULL,
+                                comm_.comm(),
+                                &base,
+                                &win_);
+
+    if (MPI_SUCCESS != stat) return BEO_FAIL;
+
+    if (comm_.is_master()) *base = 0;
+
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+
+    #elif defined _BEO_SHM_
+
+    if (BEO_SUCCESS != window_.allocate(comm_, comm_.is_master() ? sizeof(value_t) : 0)) return BEO_FAIL;
+
+    if (comm_.is_master()) new (window_.base(0)) std::atomic<value_t>(0);
+
+    #else
+
+    value_ = 0;
+
+    peers_.assign(comm_.num_tasks(), nullptr);
+
+    Task_Counter* self = this;
+
+    if (BEO_SUCCESS != beo::allgather(comm_, peers_.data(), &self, sizeof(Task_Counter*))) return BEO_FAIL;
+
+    #endif
+
+    is_allocated_ = true;
+
+    //nobody may count before task 0 has zeroed it
+    return beo::barrier(comm_);
+}
+
+/*****************************************
+ * free
+*****************************************/
+inline int Task_Counter::free()
+{
+    if (!is_allocated()) return BEO_SUCCESS;
+
+    #if defined _BEO_MPI_
+
+    MPI_Win_unlock_all(win_);
+
+    int stat = MPI_Win_free(&win_);
+
+    #elif defined _BEO_SHM_
+
+    int stat = window_.free(comm_);
+
+    #else
+
+    //no peer may still be using task 0's counter
+    int stat = beo::barrier(comm_);
+
+    peers_.clear();
+
+    #endif
+
+    comm_.finalize();
+
+    is_allocated_ = false;
+
+    return (0 == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+/*****************************************
+ * next
+ *
+ * Adds n to the counter, and returns the
+ *   value before, so this task has
+ *   claimed [value, value + n)
+*****************************************/
+inline Task_Counter::value_t Task_Counter::next(const value_t n)
+{
+    if (!is_allocated())
+    {
+        printf("beo::Task_Counter::next the counter is not allocated\n");
+        exit(1);
+    }
+
+    beo::counters().message(comm_.task_id(), 0, comm_.task_id(), sizeof(value_t));
+
+    #if defined _BEO_MPI_
+
+    value_t old = 0;
+
+    MPI_Fetch_and_op(&n, &old, MPI_INT64_T, 0, 0, MPI_SUM, win_);
+
+    MPI_Win_flush(0, win_);
+
+    return old;
+
+    #else
+
+    return value().fetch_add(n);
+
+    #endif
+}
+
+/*****************************************
+ * reset
+ *
+ * Collectively sets the counter back to
+ *   zero
+*****************************************/
+inline int Task_Counter::reset()
+{
+    if (!is_allocated()) return BEO_FAIL;
+
+    //everyone is done counting
+    if (BEO_SUCCESS != beo::barrier(comm_)) return BEO_FAIL;
+
+    if (comm_.is_master())
+    {
+        #if defined _BEO_MPI_
+
+        const value_t zero = 0;
+        value_t old;
+
+        MPI_Fetch_and_op(&zero, &old, MPI_INT64_T, 0, 0, MPI_REPLACE, win_);
+
+        MPI_Win_flush(0, win_);
+
+        #else
+
+        value() = 0;
+
+        #endif
+    }
+
+    return beo::barrier(comm_);
+}
+
+/*****************************************
+ * for_each_chunk_dynamic
+ *
+ * Collectively calls func(chunk_tag) once
+ *   for every chunk of data_tag, on
+ *   whichever task claims it first.
+ *   func returns BEO_SUCCESS or BEO_FAIL.
+ *
+ * Tasks claim batch chunks at a time.
+ *   With batch = 0, they claim a share
+ *   of what is left (guided scheduling),
+ *   from big batches at the start down
+ *   to single chunks at the end.
+ *
+ * Returns BEO_FAIL if func failed on
+ *   this task
+*****************************************/
+template<typename F>
+inline int for_each_chunk_dynamic(Comm& comm, Data_Tag& data_tag, F&& func, const size_t batch = 1)
+{
+    using value_t = Task_Counter::value_t;
+
+    //the chunks in the same order on every task
+    const auto chunk_tags = sorted_chunk_tags(data_tag);
+
+    const value_t num_chunks = (value_t) chunk_tags.size();
+    const value_t num_tasks  = comm.num_tasks();
+
+    Task_Counter counter;
+
+    if (BEO_SUCCESS != counter.allocate(comm)) return BEO_FAIL;
+
+    int stat = BEO_SUCCESS;
+
+    //what the counter was last seen at, for guided batches
+    value_t seen = 0;
+
+    while (seen < num_chunks)
+    {
+        const value_t n = (batch > 0) ? (value_t) batch
+                                      : std::max<value_t>(1, (num_chunks - seen) / (2 * num_tasks));
+
+        const value_t first = counter.next(n);
+        const value_t last  = std::min(first + n, num_chunks);
+
+        for (value_t idx = first; idx < last; idx++)
+        {
+            if (BEO_SUCCESS != func(*chunk_tags[idx])) stat = BEO_FAIL;
+        }
+
+        seen = first + n;
+    }
+
+    //the free is collective, so every chunk is done once it returns
+    if (BEO_SUCCESS != counter.free()) stat = BEO_FAIL;
+
+    return stat;
+}
+
+} //end namespace beo
+
+#endif
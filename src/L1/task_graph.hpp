@@ -0,0 +1,565 @@
+/*****************************************
+ * task_graph.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for beo::Task_Graph, which
+ *   runs tasks that read and write the
+ *   chunks of beo::Global_Data as soon as
+ *   their inputs are ready, e.g.,
+ *
+ *     beo::Task_Graph graph;
+ *
+ *     for (...i, j, k...)
+ *     {
+ *         graph.add({beo::read_access(A, a_ik),
+ *                    beo::read_access(B, b_kj),
+ *                    beo::update_access(C, c_ij)},
+ *                   [](std::vector<beo::Chunk*>& chunks)
+ *         {
+ *             return gemm(*chunks[0], *chunks[1], *chunks[2]);
+ *         });
+ *     }
+ *
+ *     graph.run();
+ *
+ * Dependencies are inferred from the order
+ *   tasks are added, as if they ran one
+ *   after the other: a task that reads a
+ *   chunk waits for the last task that
+ *   wrote it, and one that writes a chunk
+ *   waits for the last writer and every
+ *   reader since.
+ *
+ * run() keeps one local copy of each chunk
+ *   for the whole graph. The calling
+ *   thread gets (async_get) the inputs of
+ *   the next few tasks in order ahead of
+ *   need (lookahead, by default twice the
+ *   threads in the pool), runs ready tasks
+ *   on beo::thread_pool(), and once a
+ *   chunk has seen its last use, puts it
+ *   back to its owner if any task wrote it
+ *   and frees it. Chunks that are only
+ *   written (write_access) are not
+ *   fetched.
+ *
+ * Only the calling thread makes Global_Data
+ *   calls, so MPI need not be thread safe.
+ *
+ * The graph is local to the task: nothing
+ *   orders it against other tasks' graphs,
+ *   so they must write different chunks,
+ *   and Global_Data::sync is still needed
+ *   before other tasks read the results.
+ *   run() ends with a flush of everything
+ *   it wrote, and empties the graph
+*****************************************/
+#ifndef _BEO_TASK_GRAPH_HPP_
+#define _BEO_TASK_GRAPH_HPP_
+
+#include <stdio.h>
+#include <map>
+#include <set>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <functional>
+
+#include "../L0/l0.hpp"
+#include "global_data.hpp"
+
+namespace beo
+{
+
+/*****************************************
+ * Chunk_Access
+ *
+ * A chunk of a Global_Data that a task
+ *   reads (read_access), writes
+ *   (write_access), or both
+ *   (update_access)
+*****************************************/
+enum class Access {in, out, inout};
+
+struct Chunk_Access
+{
+    Global_Data* data{nullptr};
+
+    Chunk_Tag    chunk_tag;
+
+    Access       mode{Access::in};
+};
+
+inline Chunk_Access read_access(Global_Data& data, const Chunk_Tag& chunk_tag)   {return {&data, chunk_tag, Access::in};}
+
+inline Chunk_Access write_access(Global_Data& data, const Chunk_Tag& chunk_tag)  {return {&data, chunk_tag, Access::out};}
+
+inline Chunk_Access update_access(Global_Data& data, const Chunk_Tag& chunk_tag) {return {&data, chunk_tag, Access::inout};}
+
+/*****************************************
+ * Task_Graph
+*****************************************/
+class Task_Graph
+{
+    public:
+
+        using func_t = std::function<int(std::vector<Chunk*>&)>;
+
+    protected:
+
+        //the local copy of one chunk
+        struct Entry
+        {
+            enum class State {empty, fetching, ready, writing, done};
+
+            Global_Data* data{nullptr};
+
+            Chunk        chunk;
+
+            State        state{State::empty};
+
+            Request      request;
+
+            Access       first_mode{Access::in};
+
+            size_t       uses_left{0};
+
+            bool         is_dirty{false};
+
+            //for dependencies, while adding
+            long         last_writer{-1};
+
+            std::vector<size_t> readers;
+        };
+
+        struct Node
+        {
+            func_t              func;
+
+            std::vector<size_t> entries;
+
+            std::vector<Access> modes;
+
+            std::vector<Chunk*> chunks;
+
+            std::vector<size_t> successors;
+
+            size_t              num_deps{0};
+
+            int                 stat{BEO_SUCCESS};
+        };
+
+        std::vector<std::unique_ptr<Entry>> entries_;
+
+        std::map<std::pair<Global_Data*, Chunk_Tag::offsets_t>, size_t> entry_ids_;
+
+        std::vector<Node>   nodes_;
+
+        size_t              num_edges_{0};
+
+        size_t              lookahead_{0};
+
+        std::mutex          mutex_;
+
+        std::vector<size_t> finished_;
+
+        size_t entry_id(const Chunk_Access& access);
+
+        void add_edge(const size_t from, const size_t to);
+
+        void fetch(const size_t node);
+
+        bool is_ready(const size_t node);
+
+        void launch(const size_t node);
+
+        void release(const size_t entry);
+
+    public:
+
+        //lookahead is how many tasks ahead inputs are fetched, 0 for the default
+        Task_Graph(const size_t lookahead = 0) : lookahead_(lookahead) {}
+
+        Task_Graph(const Task_Graph& other) = delete;
+
+        Task_Graph& operator=(const Task_Graph& other) = delete;
+
+        size_t add(std::vector<Chunk_Access>&& accesses, func_t&& func);
+
+        size_t num_tasks() const {return nodes_.size();}
+
+        size_t num_edges() const {return num_edges_;}
+
+        size_t num_chunks() const {return entries_.size();}
+
+        int run();
+
+        void clear();
+};
+
+/*****************************************
+ * entry_id
+ *
+ * The local copy of the chunk, made on
+ *   its first access
+*****************************************/
+inline size_t Task_Graph::entry_id(const Chunk_Access& access)
+{
+    auto key = std::make_pair(access.data, access.chunk_tag.offsets());
+
+    auto itr = entry_ids_.find(key);
+
+    if (itr != entry_ids_.end()) return itr->second;
+
+    if (nullptr == access.data || !access.data->is_allocated() || !access.data->distribution().contains(key.second))
+    {
+        printf("beo::Task_Graph::add the chunk is not part of an allocated Global_Data\n");
+        exit(1);
+    }
+
+    auto entry = std::make_unique<Entry>();
+
+    entry->data       = access.data;
+    entry->chunk      = Chunk(access.chunk_tag);
+    entry->first_mode = access.mode;
+
+    entries_.push_back(std::move(entry));
+
+    entry_ids_.emplace(std::move(key), entries_.size() - 1);
+
+    return entries_.size() - 1;
+}
+
+/*****************************************
+ * add_edge
+*****************************************/
+inline void Task_Graph::add_edge(const size_t from, const size_t to)
+{
+    if (from == to) return;
+
+    auto& successors = nodes_[from].successors;
+
+    //to is the newest node, so a repeat would be the last one
+    if (!successors.empty() && to == successors.back()) return;
+
+    successors.push_back(to);
+
+    nodes_[to].num_deps++;
+
+    num_edges_++;
+}
+
+/*****************************************
+ * add
+ *
+ * Adds a task that runs func on the local
+ *   copies of the chunks, in the order of
+ *   accesses. func returns BEO_SUCCESS or
+ *   BEO_FAIL. Returns the id of the task
+*****************************************/
+inline size_t Task_Graph::add(std::vector<Chunk_Access>&& accesses, func_t&& func)
+{
+    const size_t id = nodes_.size();
+
+    nodes_.emplace_back();
+
+    nodes_[id].func = std::move(func);
+
+    for (const auto& access : accesses)
+    {
+        const size_t entry_idx = entry_id(access);
+
+        auto& entry = *entries_[entry_idx];
+
+        entry.uses_left++;
+
+        if (entry.last_writer >= 0) add_edge((size_t) entry.last_writer, id);
+
+        if (Access::in == access.mode)
+        {
+            entry.readers.push_back(id);
+        }
+
+        else
+        {
+            for (const size_t reader : entry.readers) add_edge(reader, id);
+
+            entry.readers.clear();
+
+            entry.last_writer = (long) id;
+        }
+
+        nodes_[id].entries.push_back(entry_idx);
+        nodes_[id].modes.push_back(access.mode);
+        nodes_[id].chunks.push_back(&entry.chunk);
+    }
+
+    return id;
+}
+
+/*****************************************
+ * fetch
+ *
+ * Starts getting the chunks of node that
+ *   are not here yet
+*****************************************/
+inline void Task_Graph::fetch(const size_t node)
+{
+    for (const size_t entry_idx : nodes_[node].entries)
+    {
+        auto& entry = *entries_[entry_idx];
+
+        if (Entry::State::empty != entry.state) continue;
+
+        if (Access::out == entry.first_mode)
+        {
+            const size_t bytes = entry.data->distribution().location(entry.chunk.offsets()).bytes;
+
+            const size_t padded = (bytes + BEO_CHUNK_ALIGNMENT - 1) / BEO_CHUNK_ALIGNMENT * BEO_CHUNK_ALIGNMENT;
+
+            if (BEO_SUCCESS != entry.chunk.aligned_allocate(BEO_CHUNK_ALIGNMENT, (padded > 0) ? padded : BEO_CHUNK_ALIGNMENT))
+            {
+                printf("beo::Task_Graph::run could not allocate a chunk of %s\n", entry.data->name().c_str());
+                exit(1);
+            }
+
+            entry.state = Entry::State::ready;
+        }
+
+        else
+        {
+            entry.request = entry.data->async_get(entry.chunk);
+
+            entry.state = Entry::State::fetching;
+        }
+    }
+}
+
+/*****************************************
+ * is_ready
+ *
+ * True once every chunk of node is here
+*****************************************/
+inline bool Task_Graph::is_ready(const size_t node)
+{
+    for (const size_t entry_idx : nodes_[node].entries)
+    {
+        auto& entry = *entries_[entry_idx];
+
+        if (Entry::State::fetching == entry.state && entry.request.is_complete())
+        {
+            entry.request.wait();
+            entry.state = Entry::State::ready;
+        }
+
+        if (Entry::State::ready != entry.state) return false;
+    }
+
+    return true;
+}
+
+/*****************************************
+ * launch
+ *
+ * Runs node on the thread pool
+*****************************************/
+inline void Task_Graph::launch(const size_t node)
+{
+    beo::thread_pool().submit([this, node]()
+    {
+        auto& n = nodes_[node];
+
+        n.stat = n.func(n.chunks);
+
+        std::lock_guard<std::mutex> g(mutex_);
+        finished_.push_back(node);
+
+        return n.stat;
+    });
+}
+
+/*****************************************
+ * release
+ *
+ * One use of the chunk is done. After the
+ *   last, it goes back to its owner if it
+ *   was written, and is freed
+*****************************************/
+inline void Task_Graph::release(const size_t entry_idx)
+{
+    auto& entry = *entries_[entry_idx];
+
+    if (--entry.uses_left > 0) return;
+
+    if (entry.is_dirty)
+    {
+        entry.request = entry.data->async_put(entry.chunk);
+
+        entry.state = Entry::State::writing;
+    }
+
+    else
+    {
+        entry.chunk.free();
+
+        entry.state = Entry::State::done;
+    }
+}
+
+/*****************************************
+ * run
+ *
+ * Runs every task. Returns BEO_FAIL if
+ *   any of them failed
+*****************************************/
+inline int Task_Graph::run()
+{
+    auto& pool = beo::thread_pool();
+
+    if (!pool.is_running()) pool.init();
+
+    const size_t lookahead = (lookahead_ > 0) ? lookahead_ : 2 * pool.num_threads();
+
+    const size_t num_nodes = nodes_.size();
+
+    std::vector<size_t> waiting;
+    for (size_t node = 0; node < num_nodes; node++)
+    {
+        if (0 == nodes_[node].num_deps) waiting.push_back(node);
+    }
+
+    std::vector<size_t> writing;
+    std::vector<size_t> done;
+
+    size_t num_done = 0, next_fetch = 0;
+
+    int stat = BEO_SUCCESS;
+
+    while (num_done < num_nodes)
+    {
+        bool is_busy = false;
+
+        {
+            std::lock_guard<std::mutex> g(mutex_);
+            done.swap(finished_);
+        }
+
+        for (const size_t node : done)
+        {
+            auto& n = nodes_[node];
+
+            if (BEO_SUCCESS != n.stat) stat = BEO_FAIL;
+
+            for (size_t idx = 0; idx < n.entries.size(); idx++)
+            {
+                if (Access::in != n.modes[idx]) entries_[n.entries[idx]]->is_dirty = true;
+
+                release(n.entries[idx]);
+
+                if (Entry::State::writing == entries_[n.entries[idx]]->state) writing.push_back(n.entries[idx]);
+            }
+
+            for (const size_t succ : n.successors)
+            {
+                if (0 == --nodes_[succ].num_deps) waiting.push_back(succ);
+            }
+
+            num_done++;
+            is_busy = true;
+        }
+
+        done.clear();
+
+        //prefetch, in the order the tasks were added
+        for (; next_fetch < num_nodes && next_fetch < num_done + lookahead; next_fetch++) fetch(next_fetch);
+
+        for (size_t idx = 0; idx < waiting.size();)
+        {
+            const size_t node = waiting[idx];
+
+            fetch(node);
+
+            if (is_ready(node))
+            {
+                launch(node);
+
+                waiting[idx] = waiting.back();
+                waiting.pop_back();
+
+                is_busy = true;
+            }
+
+            else
+            {
+                idx++;
+            }
+        }
+
+        for (size_t idx = 0; idx < writing.size();)
+        {
+            auto& entry = *entries_[writing[idx]];
+
+            if (entry.request.is_complete())
+            {
+                entry.request.wait();
+                entry.chunk.free();
+                entry.state = Entry::State::done;
+
+                writing[idx] = writing.back();
+                writing.pop_back();
+            }
+
+            else
+            {
+                idx++;
+            }
+        }
+
+        if (!is_busy && !pool.run_one()) std::this_thread::yield();
+    }
+
+    std::set<Global_Data*> written;
+
+    for (const size_t entry_idx : writing)
+    {
+        auto& entry = *entries_[entry_idx];
+
+        entry.request.wait();
+        entry.chunk.free();
+        entry.state = Entry::State::done;
+    }
+
+    for (const auto& entry : entries_)
+    {
+        if (entry->is_dirty) written.insert(entry->data);
+    }
+
+    for (auto data : written)
+    {
+        if (BEO_SUCCESS != data->flush()) stat = BEO_FAIL;
+    }
+
+    clear();
+
+    return stat;
+}
+
+/*****************************************
+ * clear
+*****************************************/
+inline void Task_Graph::clear()
+{
+    nodes_.clear();
+    entries_.clear();
+    entry_ids_.clear();
+    num_edges_ = 0;
+}
+
+} //end namespace beo
+
+#endif
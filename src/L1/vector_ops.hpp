@@ -0,0 +1,450 @@
+/*****************************************
+ * vector_ops.hpp
+ *
+ * agent, October 18, 2026
+ *	- created
+ *
+ * Header file for the level-1 vector
+ *   operations over the chunks of a
+ *   beo::Global_Data, treating all of its
+ *   elements (of type T) as one vector.
+ *
+ * Included here:
+ *	fill       x = a
+ *	scale      x = a * x
+ *	copy       y = x
+ *	axpy       y = a * x + y
+ *	multiply   y = y * x (element-wise)
+ *	divide     y = y / x (element-wise)
+ *	dot        x . y
+ *	norm2      |x|
+ *	max_abs    max |x_i|
+ *
+ * Each task only touches the chunks it
+ *   owns, so x and y must have been
+ *   allocated from the same Data_Tag and
+ *   element size, over the same comm. The
+ *   local work is split over the thread
+ *   pool, and the kernels use beo::Simd
+ *   (AVX-512 or AVX2) when it is there.
+ *
+ * The reductions (dot, norm2, max_abs)
+ *   are collective over the comm of x,
+ *   and give every task the result. The
+ *   rest are local, so call sync() on the
+ *   Global_Data before other tasks read
+ *   it.
+*****************************************/
+#ifndef _BEO_VECTOR_OPS_HPP_
+#define _BEO_VECTOR_OPS_HPP_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include <future>
+#include <chrono>
+#include <algorithm>
+
+#include "../L0/l0.hpp"
+#include "../L0/simd.hpp"
+#include "global_data.hpp"
+
+namespace beo
+{
+
+template<typename T>
+int fill(Global_Data& x, const T a);
+
+template<typename T>
+int scale(Global_Data& x, const T a);
+
+template<typename T>
+int copy(Global_Data& y, Global_Data& x);
+
+template<typename T>
+int axpy(Global_Data& y, const T a, Global_Data& x);
+
+template<typename T>
+int multiply(Global_Data& y, Global_Data& x);
+
+template<typename T>
+int divide(Global_Data& y, Global_Data& x);
+
+template<typename T>
+int dot(Global_Data& x, Global_Data& y, T& result);
+
+template<typename T>
+int norm2(Global_Data& x, T& result);
+
+template<typename T>
+int max_abs(Global_Data& x, T& result);
+
+/*****************************************
+ * kernels
+ *
+ * One call per piece of a chunk. The
+ *   vector loop runs while a whole
+ *   register fits, the scalar loop does
+ *   the rest
+*****************************************/
+template<typename T>
+inline void fill_kernel(T* x, const T a, const size_t n)
+{
+    size_t i = 0;
+
+    if constexpr (Simd<T>::width > 1)
+    {
+        using S = Simd<T>;
+        const auto va = S::set1(a);
+        for (; i + S::width <= n; i += S::width) S::store(x + i, va);
+    }
+
+    for (; i < n; i++) x[i] = a;
+}
+
+template<typename T>
+inline void scale_kernel(T* x, const T a, const size_t n)
+{
+    size_t i = 0;
+
+    if constexpr (Simd<T>::width > 1)
+    {
+        using S = Simd<T>;
+        const auto va = S::set1(a);
+        for (; i + S::width <= n; i += S::width) S::store(x + i, S::mul(va, S::load(x + i)));
+    }
+
+    for (; i < n; i++) x[i] *= a;
+}
+
+template<typename T>
+inline void axpy_kernel(T* y, const T a, const T* x, const size_t n)
+{
+    size_t i = 0;
+
+    if constexpr (Simd<T>::width > 1)
+    {
+        using S = Simd<T>;
+        const auto va = S::set1(a);
+        for (; i + S::width <= n; i += S::width) S::store(y + i, S::fma(va, S::load(x + i), S::load(y + i)));
+    }
+
+    for (; i < n; i++) y[i] += a * x[i];
+}
+
+template<typename T>
+inline void multiply_kernel(T* y, const T* x, const size_t n)
+{
+    size_t i = 0;
+
+    if constexpr (Simd<T>::width > 1)
+    {
+        using S = Simd<T>;
+        for (; i + S::width <= n; i += S::width) S::store(y + i, S::mul(S::load(y + i), S::load(x + i)));
+    }
+
+    for (; i < n; i++) y[i] *= x[i];
+}
+
+template<typename T>
+inline void divide_kernel(T* y, const T* x, const size_t n)
+{
+    size_t i = 0;
+
+    if constexpr (Simd<T>::width > 1)
+    {
+        using S = Simd<T>;
+        for (; i + S::width <= n; i += S::width) S::store(y + i, S::div(S::load(y + i), S::load(x + i)));
+    }
+
+    for (; i < n; i++) y[i] /= x[i];
+}
+
+template<typename T>
+inline T dot_kernel(const T* x, const T* y, const size_t n)
+{
+    size_t i = 0;
+    T result = T(0);
+
+    if constexpr (Simd<T>::width > 1)
+    {
+        using S = Simd<T>;
+
+        //two accumulators, to hide the latency of the fma
+        auto s0 = S::set1(T(0));
+        auto s1 = S::set1(T(0));
+
+        for (; i + 2 * S::width <= n; i += 2 * S::width)
+        {
+            s0 = S::fma(S::load(x + i), S::load(y + i), s0);
+            s1 = S::fma(S::load(x + i + S::width), S::load(y + i + S::width), s1);
+        }
+
+        for (; i + S::width <= n; i += S::width) s0 = S::fma(S::load(x + i), S::load(y + i), s0);
+
+        result = S::sum(S::add(s0, s1));
+    }
+
+    for (; i < n; i++) result += x[i] * y[i];
+
+    return result;
+}
+
+template<typename T>
+inline T max_abs_kernel(const T* x, const size_t n)
+{
+    size_t i = 0;
+    T result = T(0);
+
+    if constexpr (Simd<T>::width > 1)
+    {
+        using S = Simd<T>;
+        auto m = S::set1(T(0));
+        for (; i + S::width <= n; i += S::width) m = S::max(m, S::abs(S::load(x + i)));
+        result = S::max(m);
+    }
+
+    for (; i < n; i++) result = std::max(result, (T) fabs(x[i]));
+
+    return result;
+}
+
+/*****************************************
+ * laid_out_alike
+ *
+ * True if y has the chunks, element size,
+ *   and tasks of x, so a task owns the
+ *   same chunks of each
+*****************************************/
+inline bool laid_out_alike(Global_Data& x, Global_Data& y)
+{
+    return y.is_allocated()
+        && y.distribution().elm_bytes() == x.distribution().elm_bytes()
+        && y.distribution().keys() == x.distribution().keys()
+        && y.comm().num_tasks() == x.comm().num_tasks();
+}
+
+/*****************************************
+ * for_each_local_range
+ *
+ * Calls func(part, key, first, n) on
+ *   ranges of elements [first, first + n)
+ *   of the chunks of x that this task
+ *   owns, split into at most num_parts
+ *   parts of about equal size. Part 0 is
+ *   run on the calling thread and the rest
+ *   on the thread pool.
+*****************************************/
+template<typename T, typename F>
+inline int for_each_local_range(Global_Data& x, const size_t num_parts, F&& func)
+{
+    const auto& dist = x.distribution();
+
+    if (!x.is_allocated() || dist.elm_bytes() != sizeof(T)) return BEO_FAIL;
+
+    struct Piece
+    {
+        const Distribution::key_t* key;
+
+        size_t n;
+    };
+
+    std::vector<Piece> pieces;
+    size_t total = 0;
+
+    for (const auto& key : dist.keys())
+    {
+        if (!x.is_local(key)) continue;
+
+        const size_t n = dist.location(key).bytes / sizeof(T);
+
+        pieces.push_back({&key, n});
+
+        total += n;
+    }
+
+    //too little work to be worth the pool
+    const size_t grain = 16384;
+
+    const size_t parts = std::max((size_t) 1, std::min(num_parts, total / grain));
+
+    //part p does elements [p * total / parts, (p + 1) * total / parts)
+    auto run = [&pieces, total, parts, &func](const size_t part)
+    {
+        const size_t first = part * total / parts;
+        const size_t last  = (part + 1) * total / parts;
+
+        size_t start = 0;
+
+        for (const auto& piece : pieces)
+        {
+            const size_t lo = std::max(first, start);
+            const size_t hi = std::min(last, start + piece.n);
+
+            if (lo < hi) func(part, *piece.key, lo - start, hi - lo);
+
+            start += piece.n;
+
+            if (start >= last) break;
+        }
+
+        return BEO_SUCCESS;
+    };
+
+    std::vector<std::future<int>> futures;
+
+    for (size_t part = 1; part < parts; part++)
+    {
+        futures.push_back(beo::thread_pool().submit([run, part]() {return run(part);}));
+    }
+
+    int stat = run(0);
+
+    //help drain the pool while waiting, as Request::wait does
+    for (auto& future : futures)
+    {
+        while (std::future_status::ready != future.wait_for(std::chrono::seconds(0)))
+        {
+            if (!beo::thread_pool().run_one()) future.wait();
+        }
+
+        stat |= future.get();
+    }
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+/*****************************************
+ * for_each_local
+ *
+ * As for_each_local_range, but calls
+ *   func(part, x, y, n) with pointers to
+ *   the ranges of x and (if given) y
+*****************************************/
+template<typename T, typename F>
+inline int for_each_local(Global_Data& x, Global_Data* y, const size_t num_parts, F&& func)
+{
+    if (nullptr != y && !laid_out_alike(x, *y))
+    {
+        printf("beo::vector_ops %s and %s are not laid out alike\n", x.name().c_str(), y->name().c_str());
+        return BEO_FAIL;
+    }
+
+    return for_each_local_range<T>(x, num_parts, [&x, y, &func](size_t part, const Distribution::key_t& key, size_t first, size_t n)
+    {
+        T* xp = (T*) x.local_data(key) + first;
+        T* yp = (nullptr != y) ? (T*) y->local_data(key) + first : nullptr;
+
+        func(part, xp, yp, n);
+    });
+}
+
+//the number of parts to split local work into
+inline size_t num_local_parts()
+{
+    auto& pool = beo::thread_pool();
+
+    return pool.is_running() ? std::max((size_t) 1, pool.num_threads()) : Thread_Pool::default_num_threads();
+}
+
+/*****************************************
+ * local operations
+*****************************************/
+template<typename T>
+inline int fill(Global_Data& x, const T a)
+{
+    return for_each_local<T>(x, nullptr, num_local_parts(), [a](size_t, T* xp, T*, size_t n) {fill_kernel(xp, a, n);});
+}
+
+template<typename T>
+inline int scale(Global_Data& x, const T a)
+{
+    return for_each_local<T>(x, nullptr, num_local_parts(), [a](size_t, T* xp, T*, size_t n) {scale_kernel(xp, a, n);});
+}
+
+template<typename T>
+inline int copy(Global_Data& y, Global_Data& x)
+{
+    return for_each_local<T>(y, &x, num_local_parts(), [](size_t, T* yp, T* xp, size_t n) {beo::memmove(yp, xp, n * sizeof(T));});
+}
+
+template<typename T>
+inline int axpy(Global_Data& y, const T a, Global_Data& x)
+{
+    return for_each_local<T>(y, &x, num_local_parts(), [a](size_t, T* yp, T* xp, size_t n) {axpy_kernel(yp, a, xp, n);});
+}
+
+template<typename T>
+inline int multiply(Global_Data& y, Global_Data& x)
+{
+    return for_each_local<T>(y, &x, num_local_parts(), [](size_t, T* yp, T* xp, size_t n) {multiply_kernel(yp, xp, n);});
+}
+
+template<typename T>
+inline int divide(Global_Data& y, Global_Data& x)
+{
+    return for_each_local<T>(y, &x, num_local_parts(), [](size_t, T* yp, T* xp, size_t n) {divide_kernel(yp, xp, n);});
+}
+
+/*****************************************
+ * reductions
+ *
+ * Each part reduces into its own slot,
+ *   the slots are combined in order, and
+ *   then the tasks are combined over the
+ *   comm
+*****************************************/
+template<typename T>
+inline int dot(Global_Data& x, Global_Data& y, T& result)
+{
+    const size_t parts = num_local_parts();
+
+    std::vector<T> partial(parts, T(0));
+
+    int stat = for_each_local<T>(x, &y, parts, [&partial](size_t part, T* xp, T* yp, size_t n)
+    {
+        partial[part] += dot_kernel<T>(xp, yp, n);
+    });
+
+    result = T(0);
+    for (const auto p : partial) result += p;
+
+    stat |= beo::allreduce(x.comm(), &result, 1, Op::sum);
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+template<typename T>
+inline int norm2(Global_Data& x, T& result)
+{
+    int stat = dot<T>(x, x, result);
+
+    result = (T) sqrt(result);
+
+    return stat;
+}
+
+template<typename T>
+inline int max_abs(Global_Data& x, T& result)
+{
+    const size_t parts = num_local_parts();
+
+    std::vector<T> partial(parts, T(0));
+
+    int stat = for_each_local<T>(x, nullptr, parts, [&partial](size_t part, T* xp, T*, size_t n)
+    {
+        partial[part] = std::max(partial[part], max_abs_kernel<T>(xp, n));
+    });
+
+    result = T(0);
+    for (const auto p : partial) result = std::max(result, p);
+
+    stat |= beo::allreduce(x.comm(), &result, 1, Op::max);
+
+    return (BEO_SUCCESS == stat) ? BEO_SUCCESS : BEO_FAIL;
+}
+
+} //end namespace beo
+
+#endif